@@ -85,8 +85,51 @@ static void API_queryRenderedFeaturesLayerFromHighDensity(::benchmark::State& st
         bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, {{{"road-street" }}, {}});
     }
 }
+
+// Click and hover handlers query a single point or a small box around the pointer, often every
+// frame. Each iteration is one query, so the items rate is the number of queries per second.
+static void API_queryRenderedFeaturesPoint(::benchmark::State& state) {
+    QueryBenchmark bench;
+    const ScreenCoordinate point{500, 500};
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(point, {});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void API_queryRenderedFeaturesPointHighDensity(::benchmark::State& state) {
+    QueryBenchmark bench;
+    const ScreenCoordinate point{500, 500};
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(point, {{{"road-street"}}, {}});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void API_queryRenderedFeaturesHoverBox(::benchmark::State& state) {
+    QueryBenchmark bench;
+    // Moves the box around, so that consecutive queries hit different features.
+    std::vector<ScreenBox> boxes;
+    for (double x = 100; x < 900; x += 100) {
+        for (double y = 100; y < 900; y += 100) {
+            boxes.push_back({{x - 10, y - 10}, {x + 10, y + 10}});
+        }
+    }
+
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(boxes[i++ % boxes.size()], {});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 BENCHMARK(API_queryPixelsForLatLngs);
 BENCHMARK(API_queryLatLngsForPixels);
 BENCHMARK(API_queryRenderedFeaturesAll)->Iterations(50);
 BENCHMARK(API_queryRenderedFeaturesLayerFromLowDensity);
 BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensity);
+BENCHMARK(API_queryRenderedFeaturesPoint);
+BENCHMARK(API_queryRenderedFeaturesPointHighDensity);
+BENCHMARK(API_queryRenderedFeaturesHoverBox);
@@ -22,6 +22,7 @@ using namespace mbgl;
 namespace {
 
 static std::string cachePath { "benchmark/fixtures/api/cache.db" };
+static std::string programCacheDir { "benchmark/fixtures/api" };
 constexpr double pixelRatio { 1.0 };
 constexpr Size size { 1000, 1000 };
 
@@ -106,6 +107,28 @@ static void API_renderStill_recreate_map(::benchmark::State& state) {
     }
 }
 
+// Same as above, but shader programs are loaded from the program binary cache, which is
+// populated before measuring. Drivers without program binary support compile from source.
+static void API_renderStill_recreate_map_program_cache(::benchmark::State& state) {
+    RenderBenchmark bench;
+
+    const auto renderOnce = [] {
+        HeadlessFrontend frontend{size, pixelRatio, gfx::HeadlessBackend::SwapBehaviour::NoFlush,
+                                  gfx::ContextMode::Unique, nullopt, programCacheDir};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withAccessToken("foobar")};
+        prepare(map);
+        frontend.render(map);
+    };
+
+    renderOnce();
+    for (auto _ : state) {
+        renderOnce();
+    }
+}
+
 static void API_renderStill_recreate_map_2(::benchmark::State& state) {
     RenderBenchmark bench;
 
@@ -155,5 +178,6 @@ BENCHMARK(API_renderStill_reuse_map)->Unit(benchmark::kMillisecond)->Iterations(
 BENCHMARK(API_renderStill_reuse_map_formatted_labels)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_switch_styles)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderStill_recreate_map_program_cache)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map_2)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_multiple_sources)->Unit(benchmark::kMillisecond)->Iterations(50);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/token.hpp>
+
+#include <cmath>
+#include <string>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// Features on a grid that covers San Francisco. Every other feature is a short line, unless only
+// points are requested, e.g. for clustering.
+GeoJSON makeFeatures(const std::size_t count, const bool pointsOnly = false) {
+    const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(count)));
+    GeoJSONData::Features features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double lng = -122.5 + 0.2 * double(i % side) / side;
+        const double lat = 37.7 + 0.1 * double(i / side) / side;
+        if (pointsOnly || i % 2) {
+            features.emplace_back(mapbox::geometry::point<double>(lng, lat));
+        } else {
+            features.emplace_back(mapbox::geometry::line_string<double>{{lng, lat}, {lng + 0.001, lat + 0.001}});
+        }
+        features.back().id = uint64_t(i);
+        features.back().properties["index"] = uint64_t(i);
+    }
+    return GeoJSON{features};
+}
+
+// Measures the time from indexing the features to receiving the first tile at zoom 10.
+void timeToFirstTile(benchmark::State& state, Immutable<GeoJSONOptions> options) {
+    util::RunLoop loop;
+    const GeoJSON geoJSON = makeFeatures(state.range(0), options->cluster);
+    const CanonicalTileID tileID{10, 163, 395};
+
+    while (state.KeepRunning()) {
+        auto data = GeoJSONData::create(geoJSON, options);
+        bool done = false;
+        data->getTile(tileID, [&](GeoJSONData::TileFeatures features) {
+            benchmark::DoNotOptimize(features);
+            done = true;
+        });
+        while (!done) {
+            loop.runOnce();
+        }
+    }
+}
+
+// Measures clustering points with ten aggregated properties.
+void clusterAggregation(benchmark::State& state, const char* reduce, const char* map) {
+    auto options = makeMutable<GeoJSONOptions>();
+    options->cluster = true;
+    for (std::size_t i = 0; i < 10; ++i) {
+        const std::string key = "property" + util::toString(i);
+        const std::string reduceExpression = util::replaceTokens(reduce, [&](const std::string&) { return key; });
+        options->clusterProperties[key] = {expression::dsl::createExpression(map),
+                                           expression::dsl::createExpression(reduceExpression.c_str())};
+    }
+    const Immutable<GeoJSONOptions> clusterOptions = std::move(options);
+    const GeoJSON geoJSON = makeFeatures(state.range(0), true);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(GeoJSONData::create(geoJSON, clusterOptions));
+    }
+}
+
+} // namespace
+
+static void GeoJSON_TimeToFirstTile(benchmark::State& state) {
+    timeToFirstTile(state, GeoJSONOptions::defaultOptions());
+}
+
+static void GeoJSON_TimeToFirstClusterTile(benchmark::State& state) {
+    auto options = makeMutable<GeoJSONOptions>();
+    options->cluster = true;
+    timeToFirstTile(state, std::move(options));
+}
+
+// Reduce expressions as created from an operator name are computed on the property values.
+static void GeoJSON_ClusterAggregation(benchmark::State& state) {
+    clusterAggregation(state, R"(["+", ["accumulated"], ["get", "{key}"]])", R"(["get", "index"])");
+}
+
+// Expressions of any other form are evaluated for every point and every merge.
+static void GeoJSON_ClusterAggregationExpressions(benchmark::State& state) {
+    clusterAggregation(state, R"(["+", ["accumulated"], ["get", "{key}"], 0])", R"(["+", ["get", "index"], 0])");
+}
+
+BENCHMARK(GeoJSON_TimeToFirstTile)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSON_TimeToFirstClusterTile)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSON_ClusterAggregation)->Arg(10000)->Arg(100000)->Arg(500000)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSON_ClusterAggregationExpressions)->Arg(10000)->Arg(100000)->Arg(500000)->Unit(benchmark::kMillisecond);
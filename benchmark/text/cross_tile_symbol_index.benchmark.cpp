@@ -0,0 +1,177 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/text/cross_tile_symbol_index.hpp>
+#include <mbgl/util/utf.hpp>
+
+#include <memory>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+SymbolInstance makeSymbolInstance(float x, float y, std::u16string key) {
+    GeometryCoordinates line;
+    ImageMap imageMap;
+    const ShapedTextOrientations shaping{};
+    style::SymbolLayoutProperties::Evaluated layout_;
+    IndexedSubfeature subfeature(0, "", "", 0);
+    Anchor anchor(x, y, 0, 0);
+    std::array<float, 2> textOffset{{0.0f, 0.0f}};
+    std::array<float, 2> iconOffset{{0.0f, 0.0f}};
+    std::array<float, 2> variableTextOffset{{0.0f, 0.0f}};
+    style::SymbolPlacementType placementType = style::SymbolPlacementType::Point;
+
+    auto sharedData = std::make_shared<SymbolInstanceSharedData>(std::move(line),
+                                                                 shaping,
+                                                                 nullopt,
+                                                                 nullopt,
+                                                                 layout_,
+                                                                 placementType,
+                                                                 textOffset,
+                                                                 imageMap,
+                                                                 0,
+                                                                 SymbolContent::IconSDF,
+                                                                 false,
+                                                                 false);
+    return SymbolInstance(anchor, std::move(sharedData), shaping, nullopt, nullopt, 0, 0, placementType, textOffset, 0, 0, iconOffset, subfeature, 0, 0, std::move(key), 0.0f, 0.0f, 0.0f, variableTextOffset, false);
+}
+
+class SyntheticSymbol {
+public:
+    // World coordinates in the units of the parent zoom level tiles.
+    double x;
+    double y;
+    std::u16string key;
+};
+
+class SyntheticTile {
+public:
+    OverscaledTileID id;
+    std::unique_ptr<SymbolBucket> bucket;
+};
+
+std::unique_ptr<SymbolBucket> makeBucket(std::vector<SymbolInstance> symbolInstances, uint32_t bucketInstanceId) {
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    auto bucket = std::make_unique<SymbolBucket>(layout,
+                                                 std::map<std::string, Immutable<style::LayerProperties>>{},
+                                                 16.0f,
+                                                 1.0f,
+                                                 0,
+                                                 false /*iconsNeedLinear*/,
+                                                 false /*sortFeaturesByY*/,
+                                                 "bucket",
+                                                 std::move(symbolInstances),
+                                                 std::vector<SortKeyRange>{},
+                                                 1.0f,
+                                                 false,
+                                                 std::vector<style::TextWritingModeType>{},
+                                                 false /*iconsInText*/);
+    bucket->bucketInstanceId = bucketInstanceId;
+    return bucket;
+}
+
+// Makes the tiles covering a 4x4 tile area at zoom 10 (or an 8x8 area at zoom 11, if `child` is set),
+// which contain the given symbols.
+std::vector<SyntheticTile> makeTiles(const std::vector<SyntheticSymbol>& symbols, bool child, uint32_t& bucketInstanceId) {
+    const uint8_t z = child ? 11 : 10;
+    const uint32_t size = child ? 8 : 4;
+    const double scale = child ? 2.0 : 1.0;
+    const uint32_t offset = 512 * (child ? 2 : 1);
+    std::vector<std::vector<SymbolInstance>> tileSymbols(size * size);
+    for (const auto& symbol : symbols) {
+        const double x = symbol.x * scale;
+        const double y = symbol.y * scale;
+        const auto tileX = static_cast<uint32_t>(x);
+        const auto tileY = static_cast<uint32_t>(y);
+        tileSymbols[tileY * size + tileX].push_back(makeSymbolInstance(
+            static_cast<float>((x - tileX) * util::EXTENT), static_cast<float>((y - tileY) * util::EXTENT), symbol.key));
+    }
+
+    std::vector<SyntheticTile> tiles;
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            tiles.push_back(
+                {OverscaledTileID(z, 0, z, offset + x, offset + y),
+                 makeBucket(std::move(tileSymbols[y * size + x]), ++bucketInstanceId)});
+        }
+    }
+    return tiles;
+}
+
+// Symbols with repeating keys, as e.g. the road labels and the house numbers.
+std::vector<SyntheticSymbol> makeSymbols(std::size_t count) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(0.0, 4.0);
+    std::uniform_int_distribution<std::size_t> keys(0, count / 8);
+    std::vector<SyntheticSymbol> symbols;
+    symbols.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        symbols.push_back(
+            {coordinate(generator), coordinate(generator), util::convertUTF8ToUTF16("label " + std::to_string(keys(generator)))});
+    }
+    return symbols;
+}
+
+void addTiles(CrossTileSymbolLayerIndex& index, std::vector<SyntheticTile>& tiles) {
+    for (auto& tile : tiles) {
+        index.addBucket(tile.id, mat4{}, *tile.bucket);
+    }
+}
+
+std::unordered_set<uint32_t> getBucketIDs(const std::vector<SyntheticTile>& tiles) {
+    std::unordered_set<uint32_t> result;
+    for (const auto& tile : tiles) {
+        result.insert(tile.bucket->bucketInstanceId);
+    }
+    return result;
+}
+
+} // namespace
+
+// Zooming in: the zoom 11 tiles get loaded, while the zoom 10 tiles are still indexed.
+static void CrossTileSymbolIndex_ZoomIn(benchmark::State& state) {
+    const auto symbols = makeSymbols(state.range(0));
+    uint32_t bucketInstanceId = 0;
+    auto parentTiles = makeTiles(symbols, false, bucketInstanceId);
+    auto childTiles = makeTiles(symbols, true, bucketInstanceId);
+    const auto childIDs = getBucketIDs(childTiles);
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        uint32_t maxCrossTileID = 0;
+        CrossTileSymbolLayerIndex index(maxCrossTileID);
+        addTiles(index, parentTiles);
+        state.ResumeTiming();
+
+        addTiles(index, childTiles);
+        index.removeStaleBuckets(childIDs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Zooming in and out: the tiles of the previous zoom level get removed, once the new ones are indexed.
+static void CrossTileSymbolIndex_ZoomTransitions(benchmark::State& state) {
+    const auto symbols = makeSymbols(state.range(0));
+    uint32_t bucketInstanceId = 0;
+    auto parentTiles = makeTiles(symbols, false, bucketInstanceId);
+    auto childTiles = makeTiles(symbols, true, bucketInstanceId);
+    const auto parentIDs = getBucketIDs(parentTiles);
+    const auto childIDs = getBucketIDs(childTiles);
+
+    uint32_t maxCrossTileID = 0;
+    CrossTileSymbolLayerIndex index(maxCrossTileID);
+    addTiles(index, parentTiles);
+    while (state.KeepRunning()) {
+        addTiles(index, childTiles);
+        index.removeStaleBuckets(childIDs);
+        addTiles(index, parentTiles);
+        index.removeStaleBuckets(parentIDs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+BENCHMARK(CrossTileSymbolIndex_ZoomIn)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK(CrossTileSymbolIndex_ZoomTransitions)->Arg(1000)->Arg(10000)->Arg(50000);
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/conversion/property_value.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
+#include <mbgl/style/layers/symbol_layer_impl.hpp>
+#include <mbgl/tile/geojson_tile_data.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cassert>
+#include <memory>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+const std::vector<std::string> names{"Boulevard Saint-Germain",
+                                     "شارع الملك فهد",
+                                     "King Fahd Road طريق الملك فهد",
+                                     "北京市朝阳区建国门外大街",
+                                     "Rue de la Procession"};
+
+const OverscaledTileID tileID{14, 8192, 8192};
+
+// Lays out a tile of labelled points or lines with a single symbol layer. Glyphs are synthesized
+// with uniform metrics for every code point the layout depends on, so the benchmark does not need
+// glyph PBFs.
+class SymbolLayoutFixture {
+public:
+    explicit SymbolLayoutFixture(SymbolPlacementType placement) : layer("symbol", "source") {
+        conversion::Error error;
+        auto textField =
+            conversion::convertJSON<PropertyValue<expression::Formatted>>(R"(["get", "name"])", error, true, false);
+        assert(textField);
+        layer.setTextField(*textField);
+        layer.setSymbolPlacement(placement);
+        layer.setTextMaxWidth(8.0f);
+        layers.push_back(makeMutable<SymbolLayerProperties>(staticImmutableCast<SymbolLayer::Impl>(layer.baseImpl)));
+
+        mapbox::feature::feature_collection<int16_t> collection;
+        for (int16_t i = 0; i < 256; ++i) {
+            const auto x = static_cast<int16_t>((i % 16) * 512);
+            const auto y = static_cast<int16_t>((i / 16) * 512);
+            mapbox::feature::feature<int16_t> feature;
+            if (placement == SymbolPlacementType::Point) {
+                feature.geometry = mapbox::geometry::point<int16_t>(x, y);
+            } else {
+                feature.geometry = mapbox::geometry::line_string<int16_t>{
+                    {x, y}, {static_cast<int16_t>(x + 2048), static_cast<int16_t>(y + 256)}};
+            }
+            feature.properties["name"] = names[i % names.size()];
+            collection.push_back(std::move(feature));
+        }
+        features = std::make_shared<const mapbox::feature::feature_collection<int16_t>>(std::move(collection));
+
+        GlyphDependencies glyphDependencies;
+        makeLayout(glyphDependencies);
+        for (const auto& dependency : glyphDependencies) {
+            const FontStackHash hash = FontStackHasher()(dependency.first);
+            for (GlyphID codePoint : dependency.second) {
+                addGlyph(hash, codePoint);
+            }
+        }
+    }
+
+    std::unique_ptr<SymbolLayout> makeLayout(GlyphDependencies& glyphDependencies) const {
+        ImageDependencies imageDependencies;
+        std::set<std::string> availableImages;
+        const LayoutParameters layoutParameters{bucketParameters, glyphDependencies, imageDependencies, availableImages};
+        const GeoJSONTileData data(features);
+        return std::make_unique<SymbolLayout>(bucketParameters, layers, data.getLayer("source"), layoutParameters);
+    }
+
+    // Runs the full layout of the tile and returns the number of symbol instances.
+    std::size_t layout() const {
+        GlyphDependencies glyphDependencies;
+        auto symbolLayout = makeLayout(glyphDependencies);
+        symbolLayout->prepareSymbols(glyphs, glyphPositions, imageMap, imagePositions);
+
+        auto featureIndex = std::make_unique<FeatureIndex>(std::make_unique<GeoJSONTileData>(features));
+        std::unordered_map<std::string, LayerRenderData> renderData;
+        const std::size_t count = symbolLayout->symbolInstances.size();
+        symbolLayout->createBucket(imagePositions, featureIndex, renderData, true, false, tileID.canonical);
+        return count;
+    }
+
+private:
+    void addGlyph(FontStackHash hash, GlyphID codePoint) {
+        GlyphPosition position;
+        position.metrics.width = 18;
+        position.metrics.height = 18;
+        position.metrics.left = 2;
+        position.metrics.top = -8;
+        position.metrics.advance = 21;
+        position.rect = {0, 0, 24, 24};
+
+        Glyph glyph;
+        glyph.id = codePoint;
+        glyph.metrics = position.metrics;
+
+        glyphs[hash].emplace(codePoint, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+        glyphPositions[hash].emplace(codePoint, position);
+    }
+
+    const BucketParameters bucketParameters{tileID, MapMode::Continuous, 1.0f, nullptr};
+    SymbolLayer layer;
+    std::vector<Immutable<LayerProperties>> layers;
+    std::shared_ptr<const mapbox::feature::feature_collection<int16_t>> features;
+    GlyphMap glyphs;
+    GlyphPositions glyphPositions;
+    ImageMap imageMap;
+    ImagePositions imagePositions;
+};
+
+} // namespace
+
+// Measures the whole SymbolLayout pipeline of a tile: feature evaluation, shaping, anchor and
+// quad generation and bucket creation.
+static void SymbolLayout_Tile(benchmark::State& state) {
+    const SymbolLayoutFixture fixture(static_cast<SymbolPlacementType>(state.range(0)));
+
+    std::size_t symbols = 0;
+    while (state.KeepRunning()) {
+        symbols += fixture.layout();
+    }
+    benchmark::DoNotOptimize(symbols);
+    state.SetItemsProcessed(static_cast<int64_t>(symbols));
+}
+
+BENCHMARK(SymbolLayout_Tile)
+    ->Arg(static_cast<int>(SymbolPlacementType::Point))
+    ->Arg(static_cast<int>(SymbolPlacementType::Line));
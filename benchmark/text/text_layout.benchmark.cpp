@@ -0,0 +1,220 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/layers/symbol_layer_properties.hpp>
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/quads.hpp>
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/text/tagged_string.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+const FontStack regularFont{{"Open Sans Regular"}};
+const FontStack boldFont{{"Open Sans Bold"}};
+
+const std::u16string latinText = u"Boulevard Saint-Germain-des-Prés et Rue de la Procession Sainte-Geneviève";
+const std::u16string arabicText = u"شارع الملك فهد بن عبد العزيز - طريق الأمير محمد بن سلمان";
+const std::u16string mixedText = u"King Fahd Road طريق الملك فهد 1234";
+const std::u16string cjkText = u"北京市朝阳区建国门外大街一号（国贸中心）・東京都千代田区丸の内一丁目";
+
+enum class Fixture { Latin, Arabic, Mixed, CJK, Vertical, Formatted };
+
+// Synthesizes glyphs with uniform metrics for every code point in the fixtures so that
+// shaping does not depend on glyph PBFs.
+class TextLayoutFixture {
+public:
+    TextLayoutFixture() {
+        for (const auto& fontStack : {regularFont, boldFont}) {
+            const FontStackHash hash = FontStackHasher()(fontStack);
+            for (const auto& string :
+                 {latinText, applyArabicShaping(arabicText), applyArabicShaping(mixedText), cjkText}) {
+                for (char16_t codePoint : string) {
+                    addGlyph(hash, codePoint);
+                }
+            }
+            TaggedString vertical(cjkText, SectionOptions(1.0, fontStack));
+            vertical.verticalizePunctuation();
+            for (char16_t codePoint : vertical.rawText()) {
+                addGlyph(hash, codePoint);
+            }
+        }
+    }
+
+    TaggedString text(Fixture type) const {
+        switch (type) {
+        case Fixture::Latin:
+            return {latinText, SectionOptions(1.0, regularFont)};
+        case Fixture::Arabic:
+            return {applyArabicShaping(arabicText), SectionOptions(1.0, regularFont)};
+        case Fixture::Mixed:
+            return {applyArabicShaping(mixedText), SectionOptions(1.0, regularFont)};
+        case Fixture::CJK:
+            return {cjkText, SectionOptions(1.0, regularFont)};
+        case Fixture::Vertical: {
+            TaggedString result(cjkText, SectionOptions(1.0, regularFont));
+            result.verticalizePunctuation();
+            return result;
+        }
+        case Fixture::Formatted: {
+            // Mirrors a `format` expression with a bold, scaled name and a regular subtitle.
+            TaggedString result;
+            result.addTextSection(u"Boulevard Saint-Germain\n", 1.2, boldFont);
+            result.addTextSection(applyArabicShaping(arabicText), 1.0, regularFont);
+            result.addTextSection(u" ", 1.0, regularFont);
+            result.addTextSection(cjkText, 0.8, regularFont);
+            return result;
+        }
+        }
+        return {};
+    }
+
+    Shaping shape(const TaggedString& string, float maxWidthInEms, BiDi& bidi, bool vertical = false) const {
+        return getShaping(string,
+                          maxWidthInEms * util::ONE_EM,
+                          1.2f * util::ONE_EM, // lineHeight
+                          style::SymbolAnchorType::Center,
+                          vertical ? style::TextJustifyType::Left : style::TextJustifyType::Center,
+                          0.0f,           // spacing
+                          {{0.0f, 0.0f}}, // translate
+                          vertical ? WritingModeType::Vertical : WritingModeType::Horizontal,
+                          bidi,
+                          glyphs,
+                          glyphPositions,
+                          imagePositions,
+                          16.0f, // layoutTextSize
+                          16.0f, // layoutTextSizeAtBucketZoomLevel
+                          vertical);
+    }
+
+    const ImageMap imageMap;
+
+private:
+    void addGlyph(FontStackHash hash, char16_t codePoint) {
+        GlyphPosition position;
+        position.metrics.width = 18;
+        position.metrics.height = 18;
+        position.metrics.left = 2;
+        position.metrics.top = -8;
+        position.metrics.advance = 21;
+        position.rect = {0, 0, 24, 24};
+
+        Glyph glyph;
+        glyph.id = codePoint;
+        glyph.metrics = position.metrics;
+
+        glyphs[hash].emplace(codePoint, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+        glyphPositions[hash].emplace(codePoint, position);
+    }
+
+    GlyphMap glyphs;
+    GlyphPositions glyphPositions;
+    ImagePositions imagePositions;
+};
+
+const TextLayoutFixture& fixture() {
+    static const TextLayoutFixture instance;
+    return instance;
+}
+
+} // namespace
+
+static void TextLayout_ArabicShaping(benchmark::State& state) {
+    std::size_t length = 0;
+    while (state.KeepRunning()) {
+        length += applyArabicShaping(arabicText).size();
+    }
+    benchmark::DoNotOptimize(length);
+}
+
+static void TextLayout_BiDi(benchmark::State& state) {
+    BiDi bidi;
+    const std::u16string text = applyArabicShaping(mixedText);
+    const std::set<std::size_t> lineBreaks{{8, 20}};
+
+    std::size_t lines = 0;
+    while (state.KeepRunning()) {
+        lines += bidi.processText(text, lineBreaks).size();
+    }
+    benchmark::DoNotOptimize(lines);
+}
+
+static void TextLayout_BiDiStyled(benchmark::State& state) {
+    BiDi bidi;
+    const TaggedString text = fixture().text(Fixture::Formatted);
+    const std::set<std::size_t> lineBreaks{{24, 60}};
+
+    std::size_t lines = 0;
+    while (state.KeepRunning()) {
+        lines += bidi.processStyledText(text.getStyledText(), lineBreaks).size();
+    }
+    benchmark::DoNotOptimize(lines);
+}
+
+// Shapes the fixture selected by the argument, breaking lines at 10 ems.
+static void TextLayout_Shaping(benchmark::State& state) {
+    BiDi bidi;
+    const auto fixtureType = static_cast<Fixture>(state.range(0));
+    const TaggedString text = fixture().text(fixtureType);
+    const bool vertical = fixtureType == Fixture::Vertical;
+
+    std::size_t lines = 0;
+    while (state.KeepRunning()) {
+        lines += fixture().shape(text, 10.0f, bidi, vertical).positionedLines.size();
+    }
+    benchmark::DoNotOptimize(lines);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(text.length()));
+}
+
+// Measures line-break selection for a range of maximum widths; 0 disables line breaking.
+static void TextLayout_LineBreaking(benchmark::State& state) {
+    BiDi bidi;
+    const TaggedString text = fixture().text(Fixture::Latin);
+    const auto maxWidth = static_cast<float>(state.range(0));
+
+    std::size_t lines = 0;
+    while (state.KeepRunning()) {
+        lines += fixture().shape(text, maxWidth, bidi).positionedLines.size();
+    }
+    benchmark::DoNotOptimize(lines);
+}
+
+static void TextLayout_GlyphQuads(benchmark::State& state) {
+    BiDi bidi;
+    const auto fixtureType = static_cast<Fixture>(state.range(0));
+    const bool vertical = fixtureType == Fixture::Vertical;
+    const Shaping shaping = fixture().shape(fixture().text(fixtureType), 10.0f, bidi, vertical);
+    style::SymbolLayoutProperties::Evaluated layout;
+
+    std::size_t quads = 0;
+    while (state.KeepRunning()) {
+        quads += getGlyphQuads(shaping,
+                               {{0.0f, 0.0f}},
+                               layout,
+                               style::SymbolPlacementType::Point,
+                               fixture().imageMap,
+                               vertical)
+                     .size();
+    }
+    benchmark::DoNotOptimize(quads);
+    state.SetItemsProcessed(static_cast<int64_t>(quads));
+}
+
+BENCHMARK(TextLayout_ArabicShaping);
+BENCHMARK(TextLayout_BiDi);
+BENCHMARK(TextLayout_BiDiStyled);
+BENCHMARK(TextLayout_Shaping)
+    ->Arg(static_cast<int>(Fixture::Latin))
+    ->Arg(static_cast<int>(Fixture::Arabic))
+    ->Arg(static_cast<int>(Fixture::Mixed))
+    ->Arg(static_cast<int>(Fixture::CJK))
+    ->Arg(static_cast<int>(Fixture::Vertical))
+    ->Arg(static_cast<int>(Fixture::Formatted));
+BENCHMARK(TextLayout_LineBreaking)->Arg(0)->Arg(5)->Arg(10)->Arg(20);
+BENCHMARK(TextLayout_GlyphQuads)
+    ->Arg(static_cast<int>(Fixture::Latin))
+    ->Arg(static_cast<int>(Fixture::Arabic))
+    ->Arg(static_cast<int>(Fixture::CJK))
+    ->Arg(static_cast<int>(Fixture::Vertical))
+    ->Arg(static_cast<int>(Fixture::Formatted));
@@ -4,6 +4,7 @@
 
 #include <mapbox/std/weak.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 
@@ -41,6 +42,8 @@ public:
     virtual void schedule(std::function<void()>) = 0;
     // Makes a weak pointer to this Scheduler.
     virtual mapbox::base::WeakPtr<Scheduler> makeWeakPtr() = 0;
+    // Returns the maximum number of tasks this scheduler runs at the same time.
+    virtual std::size_t getConcurrency() const { return 1u; }
 
     // Returns a closure wrapping the given one.
     //
@@ -17,6 +17,12 @@ struct RenderingStats {
     int memIndexBuffers;
     int memVertexBuffers;
 
+    // Capacity of the pooled buffer objects that static buffers are suballocated from, and the part
+    // of it that is currently allocated. The counts and sizes above report each pooled allocation
+    // as a buffer of its own and don't include the pool capacity.
+    int memPooledBuffers;
+    int memPooledBuffersUsed;
+
     RenderingStats& operator+=(const RenderingStats& right);
 };
 
@@ -30,6 +36,8 @@ inline RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     memTextures += r.memTextures;
     memIndexBuffers += r.memIndexBuffers;
     memVertexBuffers += r.memVertexBuffers;
+    memPooledBuffers += r.memPooledBuffers;
+    memPooledBuffersUsed += r.memPooledBuffersUsed;
     return *this;
 }
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Timings of a single frame, recorded while profiling is enabled on the renderer. Every render
+// pass and every layer drawn in it is recorded as a group.
+struct FrameProfile {
+    struct Group {
+        std::string name;
+        // Nesting level of the group; passes have depth 0 and the layers drawn in them depth 1.
+        std::size_t depth = 0;
+
+        // Relative to the start of the frame.
+        Duration cpuStart = Duration::zero();
+        Duration cpuDuration = Duration::zero();
+
+        // Only set when the GPU supports timer queries. The GPU start is relative to the time the
+        // GPU started processing the frame.
+        optional<Duration> gpuStart;
+        optional<Duration> gpuDuration;
+    };
+
+    // Counts the frames rendered by the renderer since profiling was enabled.
+    uint64_t frame = 0;
+
+    TimePoint start;
+    Duration cpuDuration = Duration::zero();
+    optional<Duration> gpuDuration;
+
+    // Groups in the order they started.
+    std::vector<Group> groups;
+};
+
+// Describes how the renderer built the render tree of a frame. Layers and sources are only prepared
+// again when they or the tiles they draw changed since the previous frame; otherwise the render data
+// of the previous frame is reused.
+struct RenderTreeStats {
+    // CPU time spent evaluating, preparing and placing the layers.
+    Duration buildDuration = Duration::zero();
+
+    std::size_t preparedLayers = 0;
+    std::size_t reusedLayers = 0;
+    std::size_t preparedSources = 0;
+    std::size_t reusedSources = 0;
+};
+
+// Serializes the profiles into the Chrome trace event format, which can be loaded into
+// chrome://tracing or Perfetto. CPU and GPU timings are shown as separate threads.
+std::string toChromeTrace(const std::vector<FrameProfile>&);
+
+} // namespace mbgl
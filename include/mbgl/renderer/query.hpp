@@ -30,14 +30,27 @@ public:
 class SourceQueryOptions {
 public:
     SourceQueryOptions(optional<std::vector<std::string>> sourceLayers_ = {},
-                       optional<style::Filter> filter_ = {})
+                       optional<style::Filter> filter_ = {},
+                       optional<std::vector<std::string>> properties_ = {},
+                       bool deduplicate_ = false)
         : sourceLayers(std::move(sourceLayers_)),
-          filter(std::move(filter_)) {}
+          filter(std::move(filter_)),
+          properties(std::move(properties_)),
+          deduplicate(deduplicate_) {}
 
     // Required for VectorSource, ignored for GeoJSONSource
     optional<std::vector<std::string>> sourceLayers;
 
     optional<style::Filter> filter;
+
+    // The properties to include in the resulting features. Features contain all their properties
+    // if not set; leaving out the properties that aren't needed avoids decoding them.
+    optional<std::vector<std::string>> properties;
+
+    // Features that span several tiles are returned once per tile that contains them, unless this
+    // is set, in which case only the first feature with a given ID in a source layer is returned.
+    // Features without an ID are always returned.
+    bool deduplicate;
 };
 
 } // namespace mbgl
@@ -40,9 +40,22 @@ struct PlacedSymbolData {
     std::string layer;
 };
 
+// Symbol placement work done for a frame.
+struct PlacementStats {
+    // Symbols, which were tested against the collision index.
+    std::size_t placedSymbols = 0;
+    // Symbols, whose placement was carried over from the previous placement.
+    std::size_t reusedSymbols = 0;
+};
+
 class Renderer {
 public:
-    Renderer(gfx::RendererBackend&, float pixelRatio_, const optional<std::string>& localFontFamily = {});
+    // When `programCacheDir` is set, linked shader programs are cached there as driver
+    // binaries and reused by later renderers, which avoids recompiling every shader.
+    Renderer(gfx::RendererBackend&,
+             float pixelRatio_,
+             const optional<std::string>& localFontFamily = {},
+             const optional<std::string>& programCacheDir = {});
     ~Renderer();
 
     void markContextLost();
@@ -55,7 +68,21 @@ public:
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
+
+    // Asynchronous variants of the rendered feature queries above. The render state that the query
+    // needs is captured when they are called, and the query itself runs on the background scheduler,
+    // so that long running queries, e.g. of large boxes, don't block rendering. `callback` is called
+    // on the current scheduler with the same results the synchronous query would have returned.
+    using QueryCallback = std::function<void(std::vector<Feature>)>;
+    void queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&, QueryCallback callback) const;
+    void queryRenderedFeatures(const ScreenCoordinate&, const RenderedQueryOptions&, QueryCallback callback) const;
+    void queryRenderedFeatures(const ScreenBox&, const RenderedQueryOptions&, QueryCallback callback) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options = {}) const;
+    // Passes the features of the source to `callback` one by one as they are read from the tiles,
+    // instead of collecting them, e.g. to export large numbers of features.
+    void querySourceFeatures(const std::string& sourceID,
+                             const SourceQueryOptions&,
+                             const std::function<void(Feature)>& callback) const;
     AnnotationIDs queryPointAnnotations(const ScreenBox& box) const;
     AnnotationIDs queryShapeAnnotations(const ScreenBox& box) const;
     AnnotationIDs getAnnotationIDs(const std::vector<Feature>&) const;
@@ -70,6 +97,13 @@ public:
     void setFeatureState(const std::string& sourceID, const optional<std::string>& sourceLayerID,
                          const std::string& featureID, const FeatureState& state);
 
+    // Sets the states of many features of a source layer at once, keyed by feature ID. This is
+    // considerably faster than setting them one by one, e.g. when hovering over or selecting
+    // large numbers of features.
+    void setFeatureStates(const std::string& sourceID,
+                          const optional<std::string>& sourceLayerID,
+                          const FeatureStates& states);
+
     void getFeatureState(FeatureState& state,
                          const std::string& sourceID,
                          const optional<std::string>& sourceLayerID,
@@ -101,6 +135,40 @@ public:
      */
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
 
+    /**
+     * @brief Returns the symbol placement work done for the last rendered frame.
+     *
+     * Both counters are zero if no new placement was made for that frame.
+     */
+    PlacementStats getPlacementStats() const;
+
+    /**
+     * @brief In Continuous map mode, enables or disables asynchronous symbol placement.
+     *
+     * If enabled, the symbol placement is calculated on a background thread, while the frames
+     * keep being rendered with the previous placement until the new one is ready. It reduces
+     * the frame time spikes caused by placing many labels, for the cost of the labels
+     * placement lagging behind the camera by a few frames.
+     *
+     * Requires `render()` to be called on a thread with a current `Scheduler`; otherwise,
+     * the placement is calculated synchronously.
+     *
+     * The asynchronous symbol placement is disabled by default.
+     */
+    void enableAsyncPlacement(bool enable);
+
+    /**
+     * @brief Enables or disables recording the CPU and GPU time spent in every render pass and
+     * in every layer drawn in it.
+     *
+     * Each rendered frame is reported through `RendererObserver::onDidProfileFrame()`; use
+     * `toChromeTrace()` to inspect the profiles in chrome://tracing. GPU timings are only
+     * recorded when the GPU supports timer queries.
+     *
+     * Profiling is disabled by default.
+     */
+    void enableProfiling(bool enable);
+
     // Memory
     void reduceMemoryUse();
     void clearData();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mbgl/renderer/frame_profile.hpp>
+
 #include <cstdint>
 #include <exception>
 
@@ -32,6 +34,13 @@ public:
     // Final frame
     virtual void onDidFinishRenderingMap() {}
 
+    // Timings of a frame rendered while profiling was enabled. Since GPU timings take a few frames
+    // to become available, this is called for earlier frames, in the order they were rendered.
+    virtual void onDidProfileFrame(const FrameProfile&) {}
+
+    // Called for every render tree built for a frame, before the frame is rendered.
+    virtual void onDidBuildRenderTree(const RenderTreeStats&) {}
+
     // Style is missing an image
     using StyleImageMissingCallback = std::function<void()>;
     virtual void onStyleImageMissing(const std::string&, const StyleImageMissingCallback& done) { done(); }
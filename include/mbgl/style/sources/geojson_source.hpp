@@ -4,12 +4,15 @@
 #include <mbgl/style/source.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/geojson.hpp>
 #include <mbgl/util/optional.hpp>
 
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -41,7 +44,7 @@ class GeoJSONData {
 public:
     using TileFeatures = mapbox::feature::feature_collection<int16_t>;
     using Features = mapbox::feature::feature_collection<double>;
-    static std::shared_ptr<GeoJSONData> create(const GeoJSON&,
+    static std::shared_ptr<GeoJSONData> create(GeoJSON,
                                                const Immutable<GeoJSONOptions>& = GeoJSONOptions::defaultOptions(),
                                                std::shared_ptr<Scheduler> scheduler = nullptr);
 
@@ -54,6 +57,14 @@ public:
     virtual std::uint8_t getClusterExpansionZoom(std::uint32_t) = 0;
 
     virtual std::shared_ptr<Scheduler> getScheduler() { return nullptr; }
+
+    // Returns new data in which the features with the `removed` ids are dropped and the given
+    // features replace the features with the same ids, or are appended if there is none. The
+    // bounds of all removed, replaced and added features are appended to `changedBounds`.
+    // Returns nullptr if the data can't be updated.
+    virtual std::shared_ptr<GeoJSONData> update(const Features&,
+                                                const std::vector<FeatureIdentifier>& removed,
+                                                std::vector<LatLngBounds>& changedBounds);
 };
 
 class GeoJSONSource final : public Source {
@@ -65,6 +76,11 @@ public:
     void setGeoJSON(const GeoJSON&);
     void setGeoJSONData(std::shared_ptr<GeoJSONData>);
 
+    // Adds the given features, replacing the features with the same ids. Unlike setGeoJSON(),
+    // only the tiles that contain the changed features are re-tiled and reloaded.
+    void updateFeatures(const GeoJSONData::Features&);
+    void removeFeatures(const std::vector<FeatureIdentifier>&);
+
     optional<std::string> getURL() const;
     const GeoJSONOptions& getOptions() const;
 
@@ -83,6 +99,8 @@ protected:
     Mutable<Source::Impl> createMutable() const noexcept final;
 
 private:
+    void updateData(const GeoJSONData::Features&, const std::vector<FeatureIdentifier>& removed);
+
     optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
     std::shared_ptr<Scheduler> threadPool;
@@ -14,14 +14,16 @@ namespace mbgl {
 HeadlessFrontend::HeadlessFrontend(float pixelRatio_,
                                    gfx::HeadlessBackend::SwapBehaviour swapBehavior,
                                    const gfx::ContextMode contextMode,
-                                   const optional<std::string>& localFontFamily)
-    : HeadlessFrontend({256, 256}, pixelRatio_, swapBehavior, contextMode, localFontFamily) {}
+                                   const optional<std::string>& localFontFamily,
+                                   const optional<std::string>& programCacheDir)
+    : HeadlessFrontend({256, 256}, pixelRatio_, swapBehavior, contextMode, localFontFamily, programCacheDir) {}
 
 HeadlessFrontend::HeadlessFrontend(Size size_,
                                    float pixelRatio_,
                                    gfx::HeadlessBackend::SwapBehaviour swapBehavior,
                                    const gfx::ContextMode contextMode,
-                                   const optional<std::string>& localFontFamily)
+                                   const optional<std::string>& localFontFamily,
+                                   const optional<std::string>& programCacheDir)
     : size(size_),
       pixelRatio(pixelRatio_),
       frameTime(0),
@@ -45,7 +47,7 @@ HeadlessFrontend::HeadlessFrontend(Size size_,
               frameTime = (endTime - startTime).count();
           }
       }),
-      renderer(std::make_unique<Renderer>(*getBackend(), pixelRatio, localFontFamily)) {}
+      renderer(std::make_unique<Renderer>(*getBackend(), pixelRatio, localFontFamily, programCacheDir)) {}
 
 HeadlessFrontend::~HeadlessFrontend() = default;
 
@@ -11,9 +11,15 @@
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_impl.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
 
 #include <boost/function_output_iterator.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 // Note: LayerManager::annotationsEnabled is defined
 // at compile time, so that linker (with LTO on) is able
 // to optimize out the unreachable code.
@@ -31,6 +37,25 @@ const std::string AnnotationManager::SourceID = "com.mapbox.annotations";
 const std::string AnnotationManager::PointLayerID = "com.mapbox.annotations.points";
 const std::string AnnotationManager::ShapeLayerID = "com.mapbox.annotations.shape.";
 
+namespace {
+
+// Returns the areas in which annotations show up in the tile, which include the buffer of the shape
+// tiles. Shapes close to the antimeridian also show up in the tiles at the other side of the world.
+std::array<LatLngBounds, 3> shapeTileBounds(const CanonicalTileID& tileID) {
+    const double scale = std::pow(2.0, tileID.z);
+    const double buffer = double(ShapeAnnotationImpl::tileBuffer) / util::EXTENT;
+    const LatLng nw = Projection::unproject(
+        {(tileID.x - buffer) * util::tileSize, (tileID.y - buffer) * util::tileSize}, scale);
+    const LatLng se = Projection::unproject(
+        {(tileID.x + 1 + buffer) * util::tileSize, (tileID.y + 1 + buffer) * util::tileSize}, scale);
+    const auto shifted = [&](const double offset) {
+        return LatLngBounds::hull({se.latitude(), nw.longitude() + offset}, {nw.latitude(), se.longitude() + offset});
+    };
+    return {{shifted(-util::DEGREES_MAX), shifted(0), shifted(util::DEGREES_MAX)}};
+}
+
+} // namespace
+
 AnnotationManager::AnnotationManager(Style& style_)
         : style(style_) {
 };
@@ -78,18 +103,15 @@ void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& anno
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
     symbolAnnotations.emplace(id, impl);
+    dirtyBounds.push_back(impl->bounds());
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<LineAnnotationImpl>(id, annotation)).first->second;
-    impl.updateStyle(*style.get().impl);
+    setShape(std::make_unique<LineAnnotationImpl>(id, annotation));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation) {
-    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
-        std::make_unique<FillAnnotationImpl>(id, annotation)).first->second;
-    impl.updateStyle(*style.get().impl);
+    setShape(std::make_unique<FillAnnotationImpl>(id, annotation));
 }
 
 void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation) {
@@ -116,8 +138,7 @@ void AnnotationManager::update(const AnnotationID& id, const LineAnnotation& ann
         return;
     }
 
-    shapeAnnotations.erase(it);
-    add(id, annotation);
+    setShape(std::make_unique<LineAnnotationImpl>(id, annotation));
     dirty = true;
 }
 
@@ -128,25 +149,118 @@ void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& ann
         return;
     }
 
-    shapeAnnotations.erase(it);
-    add(id, annotation);
+    setShape(std::make_unique<FillAnnotationImpl>(id, annotation));
     dirty = true;
 }
 
 void AnnotationManager::remove(const AnnotationID& id) {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN();
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
-        symbolTree.remove(symbolAnnotations.at(id));
+        const auto& impl = symbolAnnotations.at(id);
+        dirtyBounds.push_back(impl->bounds());
+        symbolTree.remove(impl);
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
         auto it = shapeAnnotations.find(id);
-        *style.get().impl->removeLayer(it->second->layerID);
-        shapeAnnotations.erase(it);
+        const ShapeAnnotationImpl& shape = *it->second;
+        const LatLngBounds bounds = shape.bounds();
+        if (!bounds.isEmpty()) {
+            shapeTree.remove(std::make_pair(bounds, id));
+            dirtyBounds.push_back(bounds);
+        }
+        // The annotations that shared the layer keep it, so only the removed annotation's tiles change.
+        if (!isShapeLayerShared(it)) {
+            style.get().impl->removeLayer(shape.layerID);
+        }
+        updateShapeLayers(shapeAnnotations.erase(it), false);
     } else {
         assert(false); // Should never happen
     }
 }
 
+void AnnotationManager::setShape(std::unique_ptr<ShapeAnnotationImpl> shape) {
+    const AnnotationID id = shape->id;
+    auto it = shapeAnnotations.find(id);
+    if (it != shapeAnnotations.end()) {
+        const LatLngBounds bounds = it->second->bounds();
+        if (!bounds.isEmpty()) {
+            shapeTree.remove(std::make_pair(bounds, id));
+            dirtyBounds.push_back(bounds);
+        }
+        shape->layerID = it->second->layerID;
+        it->second = std::move(shape);
+    } else {
+        it = shapeAnnotations.emplace(id, std::move(shape)).first;
+    }
+
+    const LatLngBounds bounds = it->second->bounds();
+    if (!bounds.isEmpty()) {
+        shapeTree.insert(std::make_pair(bounds, id));
+        dirtyBounds.push_back(bounds);
+    }
+    updateShapeLayers(it, true);
+}
+
+bool AnnotationManager::headsShapeLayer(ShapeAnnotationMap::const_iterator it) const {
+    return it == shapeAnnotations.begin() || std::prev(it)->second->layerID != it->second->layerID;
+}
+
+bool AnnotationManager::isShapeLayerShared(ShapeAnnotationMap::const_iterator it) const {
+    const auto next = std::next(it);
+    return !headsShapeLayer(it) ||
+           (next != shapeAnnotations.end() && next->second->layerID == it->second->layerID);
+}
+
+void AnnotationManager::updateShapeLayers(ShapeAnnotationMap::iterator first, const bool changed) {
+    // An annotation shares the layer of the annotation before it if both can share the same kind of
+    // layer, so the layers only change up to the first annotation that keeps its layer. The
+    // annotation that followed a removed one keeps its layer if it can, so that removing the first
+    // annotation of a shared layer leaves the others in place.
+    std::vector<ShapeAnnotationMap::iterator> heads;
+    for (auto it = first; it != shapeAnnotations.end(); ++it) {
+        ShapeAnnotationImpl& shape = *it->second;
+        const auto kind = shape.sharedLayerKind();
+        std::string layerID = it == first && !changed ? shape.layerID : shape.ownLayerID;
+        if (it != shapeAnnotations.begin()) {
+            const ShapeAnnotationImpl& previous = *std::prev(it)->second;
+            if (kind != ShapeAnnotationImpl::SharedLayerKind::None && previous.sharedLayerKind() == kind) {
+                layerID = previous.layerID;
+            } else if (layerID == previous.layerID) {
+                layerID = shape.ownLayerID;
+            }
+        }
+
+        const bool isChanged = changed && it == first;
+        if (layerID == shape.layerID && !isChanged) {
+            break;
+        }
+        if (layerID != shape.layerID) {
+            if (!shape.layerID.empty() && !isShapeLayerShared(it)) {
+                style.get().impl->removeLayer(shape.layerID);
+            }
+            const LatLngBounds bounds = shape.bounds();
+            if (!isChanged && !bounds.isEmpty()) {
+                dirtyBounds.push_back(bounds);
+            }
+            shape.layerID = std::move(layerID);
+        }
+        if (headsShapeLayer(it)) {
+            heads.push_back(it);
+        }
+    }
+
+    // Layers are added below the layer of the next annotation that doesn't share them, which
+    // exists already when going backwards.
+    for (auto head = heads.rbegin(); head != heads.rend(); ++head) {
+        auto next = *head;
+        while (next != shapeAnnotations.end() && next->second->layerID == (*head)->second->layerID) {
+            ++next;
+        }
+        (*head)->second->updateStyle(*style.get().impl,
+                                     next != shapeAnnotations.end() ? next->second->layerID : PointLayerID);
+    }
+}
+
 std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const CanonicalTileID& tileID) {
     if (symbolAnnotations.empty() && shapeAnnotations.empty())
         return nullptr;
@@ -168,8 +282,19 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
             val->updateLayer(tileID, *pointLayer);
         }));
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateTileData(tileID, *tileData);
+    std::vector<AnnotationID> shapeIDs;
+    for (const LatLngBounds& bounds : shapeTileBounds(tileID)) {
+        shapeTree.query(boost::geometry::index::intersects(bounds),
+            boost::make_function_output_iterator([&](const auto& val) {
+                shapeIDs.push_back(val.second);
+            }));
+    }
+
+    // Shared layers draw their annotations in the order of the features.
+    std::sort(shapeIDs.begin(), shapeIDs.end());
+    shapeIDs.erase(std::unique(shapeIDs.begin(), shapeIDs.end()), shapeIDs.end());
+    for (const AnnotationID id : shapeIDs) {
+        shapeAnnotations.at(id)->updateTileData(tileID, *tileData);
     }
 
     return tileData;
@@ -195,8 +320,10 @@ void AnnotationManager::updateStyle() {
 
     std::lock_guard<std::mutex> lock(mutex);
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateStyle(*style.get().impl);
+    for (auto it = shapeAnnotations.begin(); it != shapeAnnotations.end(); ++it) {
+        if (headsShapeLayer(it)) {
+            it->second->updateStyle(*style.get().impl, PointLayerID);
+        }
     }
 
     for (const auto& image : images) {
@@ -214,9 +341,19 @@ void AnnotationManager::updateData() {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN();
     std::lock_guard<std::mutex> lock(mutex);
     if (dirty) {
+        // Only the tiles that show changed annotations are updated. The changes are indexed, as
+        // many of them may have been made at once.
+        const boost::geometry::index::rtree<LatLngBounds, boost::geometry::index::rstar<16, 4>> changes(dirtyBounds);
         for (auto& tile : tiles) {
-            tile->setData(getTileData(tile->id.canonical));
+            const auto tileBounds = shapeTileBounds(tile->id.canonical);
+            const bool changed = std::any_of(tileBounds.begin(), tileBounds.end(), [&](const LatLngBounds& bounds) {
+                return changes.qbegin(boost::geometry::index::intersects(bounds)) != changes.qend();
+            });
+            if (changed) {
+                tile->setData(getTileData(tile->id.canonical));
+            }
         }
+        dirtyBounds.clear();
         dirty = false;
     }
 }
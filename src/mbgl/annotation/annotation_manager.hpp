@@ -63,6 +63,9 @@ private:
 
     void remove(const AnnotationID&);
 
+    // Adds the shape annotation or replaces the one with the same ID.
+    void setShape(std::unique_ptr<ShapeAnnotationImpl>);
+
     void updateStyle();
 
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
@@ -80,13 +83,27 @@ private:
     // <https://github.com/mapbox/mapbox-gl-native/issues/5691>
     using SymbolAnnotationMap = std::map<AnnotationID, std::shared_ptr<SymbolAnnotationImpl>>;
     using ShapeAnnotationMap = std::map<AnnotationID, std::unique_ptr<ShapeAnnotationImpl>>;
+    using ShapeAnnotationTree = boost::geometry::index::rtree<std::pair<LatLngBounds, AnnotationID>, boost::geometry::index::rstar<16, 4>>;
     using ImageMap = std::unordered_map<std::string, style::Image>;
 
+    // Assigns layers to the shape annotations from the given one on, and adds the layers that are
+    // missing from the style. The given annotation was added or updated, or follows a removed one.
+    void updateShapeLayers(ShapeAnnotationMap::iterator, bool changed);
+    // Returns true if the shape annotation is the first one drawn by its layer.
+    bool headsShapeLayer(ShapeAnnotationMap::const_iterator) const;
+    // Returns true if an annotation next to the shape annotation draws the same layer.
+    bool isShapeLayerShared(ShapeAnnotationMap::const_iterator) const;
+
     SymbolAnnotationTree symbolTree;
     SymbolAnnotationMap symbolAnnotations;
+    ShapeAnnotationTree shapeTree;
     ShapeAnnotationMap shapeAnnotations;
     ImageMap images;
 
+    // Bounds of the annotations that were added, updated or removed since the tiles were updated,
+    // both before and after the change. Only the tiles that intersect them are updated.
+    std::vector<LatLngBounds> dirtyBounds;
+
     std::unordered_set<AnnotationTile*> tiles;
     mapbox::base::WeakPtrFactory<AnnotationManager> weakFactory{this};
 };
@@ -47,7 +47,7 @@ public:
     void addFeature(AnnotationID,
                     FeatureType,
                     GeometryCollection,
-                    std::unordered_map<std::string, std::string> properties = {{}});
+                    PropertyMap properties = {});
 
 private:
     std::shared_ptr<AnnotationTileLayerData> layer;
@@ -1,7 +1,9 @@
 #include <mbgl/annotation/fill_annotation_impl.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/style/expression/dsl.hpp>
 #include <mbgl/style/style_impl.hpp>
 #include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
 
 namespace mbgl {
 
@@ -12,23 +14,61 @@ FillAnnotationImpl::FillAnnotationImpl(AnnotationID id_, FillAnnotation annotati
       annotation(ShapeAnnotationGeometry::visit(annotation_.geometry, CloseShapeAnnotation{}), annotation_.opacity, annotation_.color, annotation_.outlineColor) {
 }
 
-void FillAnnotationImpl::updateStyle(Style::Impl& style) const {
+ShapeAnnotationImpl::SharedLayerKind FillAnnotationImpl::sharedLayerKind() const {
+    if (!annotation.opacity.isConstant() || !annotation.color.isConstant()) {
+        return SharedLayerKind::None;
+    }
+    // Fills without an outline color are outlined in their fill color, which a shared layer can
+    // only do if none of its fills has an outline color.
+    if (annotation.outlineColor.isUndefined()) {
+        return SharedLayerKind::Fill;
+    }
+    return annotation.outlineColor.isConstant() ? SharedLayerKind::FillOutline : SharedLayerKind::None;
+}
+
+void FillAnnotationImpl::updateStyle(Style::Impl& style, const std::string& before) const {
     Layer* layer = style.getLayer(layerID);
 
+    if (layer && layer->getTypeInfo() != FillLayer::Impl::staticTypeInfo()) {
+        style.removeLayer(layerID);
+        layer = nullptr;
+    }
+
     if (!layer) {
         auto newLayer = std::make_unique<FillLayer>(layerID, AnnotationManager::SourceID);
         newLayer->setSourceLayer(layerID);
-        layer = style.addLayer(std::move(newLayer), AnnotationManager::PointLayerID);
+        layer = style.addLayer(std::move(newLayer), before);
     }
 
     auto* fillLayer = static_cast<FillLayer*>(layer);
-    fillLayer->setFillOpacity(annotation.opacity);
-    fillLayer->setFillColor(annotation.color);
-    fillLayer->setFillOutlineColor(annotation.outlineColor);
+    const SharedLayerKind kind = sharedLayerKind();
+    if (kind == SharedLayerKind::None) {
+        fillLayer->setFillOpacity(annotation.opacity);
+        fillLayer->setFillColor(annotation.color);
+        fillLayer->setFillOutlineColor(annotation.outlineColor);
+    } else {
+        using namespace expression::dsl;
+        fillLayer->setFillOpacity(PropertyExpression<float>(number(get("opacity"))));
+        fillLayer->setFillColor(PropertyExpression<Color>(toColor(get("color"))));
+        if (kind == SharedLayerKind::FillOutline) {
+            fillLayer->setFillOutlineColor(PropertyExpression<Color>(toColor(get("outline-color"))));
+        } else {
+            fillLayer->setFillOutlineColor({});
+        }
+    }
 }
 
 const ShapeAnnotationGeometry& FillAnnotationImpl::geometry() const {
     return annotation.geometry;
 }
 
+PropertyMap FillAnnotationImpl::featureProperties() const {
+    PropertyMap properties{{"opacity", double(annotation.opacity.asConstant())},
+                           {"color", annotation.color.asConstant().stringify()}};
+    if (annotation.outlineColor.isConstant()) {
+        properties.emplace("outline-color", annotation.outlineColor.asConstant().stringify());
+    }
+    return properties;
+}
+
 } // namespace mbgl
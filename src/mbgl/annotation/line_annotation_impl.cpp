@@ -1,7 +1,9 @@
 #include <mbgl/annotation/line_annotation_impl.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/style/expression/dsl.hpp>
 #include <mbgl/style/style_impl.hpp>
 #include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
 
 namespace mbgl {
 
@@ -12,24 +14,49 @@ LineAnnotationImpl::LineAnnotationImpl(AnnotationID id_, LineAnnotation annotati
       annotation(ShapeAnnotationGeometry::visit(annotation_.geometry, CloseShapeAnnotation{}), annotation_.opacity, annotation_.width, annotation_.color) {
 }
 
-void LineAnnotationImpl::updateStyle(Style::Impl& style) const {
+ShapeAnnotationImpl::SharedLayerKind LineAnnotationImpl::sharedLayerKind() const {
+    if (annotation.opacity.isConstant() && annotation.width.isConstant() && annotation.color.isConstant()) {
+        return SharedLayerKind::Line;
+    }
+    return SharedLayerKind::None;
+}
+
+void LineAnnotationImpl::updateStyle(Style::Impl& style, const std::string& before) const {
     Layer* layer = style.getLayer(layerID);
 
+    if (layer && layer->getTypeInfo() != LineLayer::Impl::staticTypeInfo()) {
+        style.removeLayer(layerID);
+        layer = nullptr;
+    }
+
     if (!layer) {
         auto newLayer = std::make_unique<LineLayer>(layerID, AnnotationManager::SourceID);
         newLayer->setSourceLayer(layerID);
         newLayer->setLineJoin(LineJoinType::Round);
-        layer = style.addLayer(std::move(newLayer), AnnotationManager::PointLayerID);
+        layer = style.addLayer(std::move(newLayer), before);
     }
 
     auto* lineLayer = static_cast<LineLayer*>(layer);
-    lineLayer->setLineOpacity(annotation.opacity);
-    lineLayer->setLineWidth(annotation.width);
-    lineLayer->setLineColor(annotation.color);
+    if (sharedLayerKind() == SharedLayerKind::None) {
+        lineLayer->setLineOpacity(annotation.opacity);
+        lineLayer->setLineWidth(annotation.width);
+        lineLayer->setLineColor(annotation.color);
+    } else {
+        using namespace expression::dsl;
+        lineLayer->setLineOpacity(PropertyExpression<float>(number(get("opacity"))));
+        lineLayer->setLineWidth(PropertyExpression<float>(number(get("width"))));
+        lineLayer->setLineColor(PropertyExpression<Color>(toColor(get("color"))));
+    }
 }
 
 const ShapeAnnotationGeometry& LineAnnotationImpl::geometry() const {
     return annotation.geometry;
 }
 
+PropertyMap LineAnnotationImpl::featureProperties() const {
+    return {{"opacity", double(annotation.opacity.asConstant())},
+            {"width", double(annotation.width.asConstant())},
+            {"color", annotation.color.asConstant().stringify()}};
+}
+
 } // namespace mbgl
@@ -9,10 +9,13 @@ class LineAnnotationImpl : public ShapeAnnotationImpl {
 public:
     LineAnnotationImpl(AnnotationID, LineAnnotation);
 
-    void updateStyle(style::Style::Impl&) const final;
+    SharedLayerKind sharedLayerKind() const final;
+    void updateStyle(style::Style::Impl&, const std::string& before) const final;
     const ShapeAnnotationGeometry& geometry() const final;
 
 private:
+    PropertyMap featureProperties() const final;
+
     const LineAnnotation annotation;
 };
 
@@ -51,9 +51,16 @@ RenderAnnotationSource::queryRenderedFeatures(const ScreenLineString& geometry,
     return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, {});
 }
 
-std::vector<Feature> RenderAnnotationSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+RenderedSourceQuery
+RenderAnnotationSource::prepareRenderedQuery(const ScreenLineString& geometry,
+                                             const TransformState& transformState,
+                                             const std::unordered_map<std::string, const RenderLayer*>& layers,
+                                             const mat4& projMatrix) const {
+    return {tilePyramid.prepareRenderedQuery(geometry, transformState, layers, projMatrix)};
 }
 
+void RenderAnnotationSource::querySourceFeatures(const SourceQueryOptions&,
+                                                 const SourceFeatureQuery::Callback&) const {}
+
 
 } // namespace mbgl
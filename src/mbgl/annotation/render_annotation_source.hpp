@@ -22,8 +22,12 @@ public:
                           const RenderedQueryOptions& options,
                           const mat4& projMatrix) const final;
 
-    std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const final;
+    RenderedSourceQuery prepareRenderedQuery(const ScreenLineString& geometry,
+                                             const TransformState& transformState,
+                                             const std::unordered_map<std::string, const RenderLayer*>& layers,
+                                             const mat4& projMatrix) const final;
+
+    void querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const final;
 
 private:
     const AnnotationSource::Impl& impl() const;
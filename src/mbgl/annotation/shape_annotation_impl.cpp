@@ -8,13 +8,27 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <mapbox/geometry/for_each_point.hpp>
+
 namespace mbgl {
 
 using namespace style;
 
+constexpr uint16_t ShapeAnnotationImpl::tileBuffer;
+
 ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_)
     : id(id_),
-      layerID(AnnotationManager::ShapeLayerID + util::toString(id)) {
+      ownLayerID(AnnotationManager::ShapeLayerID + util::toString(id)) {
+}
+
+LatLngBounds ShapeAnnotationImpl::bounds() const {
+    LatLngBounds result = LatLngBounds::empty();
+    ShapeAnnotationGeometry::visit(geometry(), [&](const auto& geom) {
+        mapbox::geometry::for_each_point(geom, [&](const Point<double>& point) {
+            result.extend(LatLng(util::clamp(point.y, -util::LATITUDE_MAX, util::LATITUDE_MAX), point.x));
+        });
+    });
+    return result;
 }
 
 void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
@@ -28,7 +42,7 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         // The annotation source is currently hard coded to maxzoom 16, so we're topping out at z16
         // here as well.
         options.maxZoom = 16;
-        options.buffer = 255u;
+        options.buffer = tileBuffer;
         options.extent = util::EXTENT;
         options.tolerance = baseTolerance;
         shapeTiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
@@ -39,6 +53,7 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         return;
 
     auto layer = data.addLayer(layerID);
+    const PropertyMap properties = sharedLayerKind() == SharedLayerKind::None ? PropertyMap() : featureProperties();
 
     ToGeometryCollection toGeometryCollection;
     ToFeatureType toFeatureType;
@@ -53,7 +68,7 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
             renderGeometry = fixupPolygons(renderGeometry);
         }
 
-        layer->addFeature(id, featureType, renderGeometry);
+        layer->addFeature(id, featureType, renderGeometry, properties);
     }
 }
 
@@ -4,9 +4,12 @@
 #include <mapbox/geojsonvt.hpp>
 
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/style/style.hpp>
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -20,14 +23,43 @@ public:
     ShapeAnnotationImpl(AnnotationID);
     virtual ~ShapeAnnotationImpl() = default;
 
-    virtual void updateStyle(style::Style::Impl&) const = 0;
+    // The kinds of layers that annotations can share.
+    enum class SharedLayerKind : uint8_t {
+        None,
+        Fill,
+        FillOutline,
+        Line,
+    };
+
+    // Annotations whose paint properties are constant share their layer with the annotations
+    // added right before and after them, as long as those can share the same kind of layer. Shared
+    // layers take the paint properties from the features. Returns the kind of layer the annotation
+    // can share, or None if the annotation needs a layer of its own.
+    virtual SharedLayerKind sharedLayerKind() const = 0;
+
+    // Adds the layer of the annotation below the given layer, or updates its paint properties.
+    virtual void updateStyle(style::Style::Impl&, const std::string& before) const = 0;
     virtual const ShapeAnnotationGeometry& geometry() const = 0;
 
     void updateTileData(const CanonicalTileID&, AnnotationTileData&);
 
+    // Returns the bounds of the geometry, or empty bounds if it has no points.
+    LatLngBounds bounds() const;
+
+    // Shapes are tiled with a buffer of this many units of the tile extent.
+    static constexpr uint16_t tileBuffer = 255;
+
     const AnnotationID id;
-    const std::string layerID;
+    // The layer that is named after this annotation, which it gets when it starts a new layer. A
+    // shared layer keeps its ID when its first annotation is removed.
+    const std::string ownLayerID;
+    // The layer that draws the annotation; empty until the annotation manager assigns it.
+    std::string layerID;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
+
+protected:
+    // The paint properties, for layers that take them from the features.
+    virtual PropertyMap featureProperties() const = 0;
 };
 
 struct CloseShapeAnnotation {
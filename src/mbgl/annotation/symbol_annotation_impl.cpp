@@ -12,7 +12,7 @@ SymbolAnnotationImpl::SymbolAnnotationImpl(AnnotationID id_, SymbolAnnotation an
 }
 
 void SymbolAnnotationImpl::updateLayer(const CanonicalTileID& tileID, AnnotationTileLayer& layer) const {
-    std::unordered_map<std::string, std::string> featureProperties;
+    PropertyMap featureProperties;
     featureProperties.emplace("sprite", annotation.icon.empty() ? std::string("default_marker") : annotation.icon);
 
     LatLng latLng { annotation.geometry.y, annotation.geometry.x };
@@ -21,4 +21,8 @@ void SymbolAnnotationImpl::updateLayer(const CanonicalTileID& tileID, Annotation
     layer.addFeature(id, FeatureType::Point, GeometryCollection {{ {{ tilePoint }} }}, featureProperties);
 }
 
+LatLngBounds SymbolAnnotationImpl::bounds() const {
+    return LatLngBounds::singleton({annotation.geometry.y, annotation.geometry.x});
+}
+
 } // namespace mbgl
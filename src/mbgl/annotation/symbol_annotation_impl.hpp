@@ -23,6 +23,8 @@ public:
 
     void updateLayer(const CanonicalTileID&, AnnotationTileLayer&) const;
 
+    LatLngBounds bounds() const;
+
     const AnnotationID id;
     const SymbolAnnotation annotation;
 };
@@ -14,7 +14,14 @@
 
 #include <mapbox/geometry/envelope.hpp>
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <string>
 
 namespace {
@@ -33,26 +40,62 @@ mbgl::Point<double> project(const mbgl::LatLng& coordinate, const mbgl::Transfor
 
 namespace mbgl {
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace {
+
+using IndexPoint = bg::model::point<float, 2, bg::cs::cartesian>;
+using IndexBox = bg::model::box<IndexPoint>;
+
+} // namespace
+
+constexpr std::size_t FeatureIndex::maxCachedFeatures;
+
+// Bounding boxes of the rings of the indexed features, each referring to its feature by position.
+// The tree is bulk loaded once the tile was laid out, which packs its nodes more tightly than
+// inserting the boxes one by one and makes queries touch fewer nodes.
+class FeatureIndex::SpatialIndex {
+public:
+    using Entry = std::pair<IndexBox, uint32_t>;
+
+    std::vector<Entry> entries;
+    bgi::rtree<Entry, bgi::rstar<16, 4>> tree;
+};
+
 FeatureIndex::FeatureIndex(std::unique_ptr<const GeometryTileData> tileData_)
-    : grid(util::EXTENT, util::EXTENT, util::EXTENT / 16) // 16x16 grid -> 32px cell
+    : spatialIndex(std::make_unique<SpatialIndex>())
     , tileData(std::move(tileData_)) {
 }
 
+FeatureIndex::~FeatureIndex() = default;
+
 void FeatureIndex::insert(const GeometryCollection& geometries,
                           std::size_t index,
                           const std::string& sourceLayerName,
                           const std::string& bucketLeaderID) {
     auto featureSortIndex = sortIndex++;
+    bool indexed = false;
     for (const auto& ring : geometries) {
         auto envelope = mapbox::geometry::envelope(ring);
         if (envelope.min.x < util::EXTENT &&
             envelope.min.y < util::EXTENT &&
             envelope.max.x >= 0 &&
             envelope.max.y >= 0) {
-            grid.insert(IndexedSubfeature(index, sourceLayerName, bucketLeaderID, featureSortIndex),
-                        {convertPoint<float>(envelope.min), convertPoint<float>(envelope.max)});
+            spatialIndex->entries.emplace_back(IndexBox{{float(envelope.min.x), float(envelope.min.y)},
+                                                        {float(envelope.max.x), float(envelope.max.y)}},
+                                               uint32_t(subfeatures.size()));
+            indexed = true;
         }
     }
+    if (indexed) {
+        subfeatures.emplace_back(index, sourceLayerName, bucketLeaderID, featureSortIndex);
+    }
+}
+
+void FeatureIndex::finish() {
+    spatialIndex->tree = bgi::rtree<SpatialIndex::Entry, bgi::rstar<16, 4>>(spatialIndex->entries);
+    spatialIndex->entries = {};
 }
 
 void FeatureIndex::query(std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -69,24 +112,23 @@ void FeatureIndex::query(std::unordered_map<std::string, std::vector<Feature>>&
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
     const int16_t additionalPadding = std::min<int16_t>(util::EXTENT, additionalQueryPadding * pixelsToTileUnits);
 
-    // Query the grid index
+    // Query the spatial index
+    assert(spatialIndex->entries.empty());
     mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
-    std::vector<IndexedSubfeature> features = grid.query({ convertPoint<float>(box.min - additionalPadding),
-                                                           convertPoint<float>(box.max + additionalPadding) });
-
-
-    std::sort(features.begin(), features.end(), [](const IndexedSubfeature& a, const IndexedSubfeature& b) {
-        return a.sortIndex > b.sortIndex;
-    });
-    size_t previousSortIndex = std::numeric_limits<size_t>::max();
-    for (const auto& indexedFeature : features) {
-
-        // If this feature is the same as the previous feature, skip it.
-        if (indexedFeature.sortIndex == previousSortIndex) continue;
-        previousSortIndex = indexedFeature.sortIndex;
+    const IndexBox queryBox{{float(box.min.x) - additionalPadding, float(box.min.y) - additionalPadding},
+                            {float(box.max.x) + additionalPadding, float(box.max.y) + additionalPadding}};
+    std::vector<uint32_t> features;
+    for (auto it = spatialIndex->tree.qbegin(bgi::intersects(queryBox)); it != spatialIndex->tree.qend(); ++it) {
+        features.push_back(it->second);
+    }
 
-        addFeature(result, indexedFeature, queryOptions, tileID.canonical, layers, queryGeometry, transformState,
-                   pixelsToTileUnits, posMatrix, &sourceFeatureState);
+    // Features are returned in reverse order of insertion. Features with several rings that
+    // intersect the query are only added once.
+    std::sort(features.begin(), features.end(), std::greater<uint32_t>());
+    features.erase(std::unique(features.begin(), features.end()), features.end());
+    for (const uint32_t feature : features) {
+        addFeature(result, subfeatures[feature], queryOptions, tileID.canonical, layers, queryGeometry,
+                   transformState, pixelsToTileUnits, posMatrix, &sourceFeatureState);
     }
 }
 
@@ -139,8 +181,9 @@ void FeatureIndex::addFeature(std::unordered_map<std::string, std::vector<Featur
                               const float pixelsToTileUnits, const mat4& posMatrix,
                               const SourceFeatureState* sourceFeatureState) const {
     // Lazily calculated.
-    std::unique_ptr<GeometryTileLayer> sourceLayer;
-    std::unique_ptr<GeometryTileFeature> geometryTileFeature;
+    const GeometryTileLayer* sourceLayer = nullptr;
+    std::shared_ptr<const GeometryTileFeature> geometryTileFeature;
+    FeatureState state;
 
     for (const std::string& layerID : bucketLayerIDs.at(indexedFeature.bucketLeaderID)) {
         const auto it = layers.find(layerID);
@@ -151,17 +194,15 @@ void FeatureIndex::addFeature(std::unordered_map<std::string, std::vector<Featur
         const RenderLayer* renderLayer = it->second;
 
         if (!geometryTileFeature) {
-            sourceLayer = tileData->getLayer(indexedFeature.sourceLayerName);
-            assert(sourceLayer);
-
-            geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
-            assert(geometryTileFeature);
-        }
-        FeatureState state;
-        if (sourceFeatureState != nullptr) {
-            optional<std::string> idStr = featureIDtoString(geometryTileFeature->getID());
-            if (idStr) {
-                sourceFeatureState->getState(state, sourceLayer->getName(), *idStr);
+            auto cached = getFeature(indexedFeature);
+            sourceLayer = &cached.layer;
+            geometryTileFeature = std::move(cached.feature);
+
+            if (sourceFeatureState != nullptr) {
+                optional<std::string> idStr = featureIDtoString(geometryTileFeature->getID());
+                if (idStr) {
+                    sourceFeatureState->getState(state, sourceLayer->getName(), *idStr);
+                }
             }
         }
 
@@ -184,6 +225,37 @@ void FeatureIndex::addFeature(std::unordered_map<std::string, std::vector<Featur
     }
 }
 
+FeatureIndex::CachedFeature FeatureIndex::getFeature(const IndexedSubfeature& indexedFeature) const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& cachedLayer = cachedLayers[indexedFeature.sourceLayerName];
+    if (!cachedLayer.layer) {
+        cachedLayer.layer = tileData->getLayer(indexedFeature.sourceLayerName);
+        assert(cachedLayer.layer);
+    }
+
+    const auto cached = cachedLayer.features.find(indexedFeature.index);
+    if (cached != cachedLayer.features.end()) {
+        cachedFeatures.splice(cachedFeatures.begin(), cachedFeatures, cached->second);
+        return {*cachedLayer.layer, cached->second->feature};
+    }
+
+    if (cachedFeatures.size() == maxCachedFeatures) {
+        const CacheEntry& evicted = cachedFeatures.back();
+        evicted.layer.features.erase(evicted.index);
+        cachedFeatures.pop_back();
+    }
+
+    std::shared_ptr<const GeometryTileFeature> feature = cachedLayer.layer->getFeature(indexedFeature.index);
+    assert(feature);
+    // Decode the geometry and properties while the cache is locked; queries, which might run on
+    // several threads at once, only read them afterwards.
+    feature->getGeometries();
+    feature->getProperties();
+    cachedFeatures.push_front({cachedLayer, indexedFeature.index, feature});
+    cachedLayer.features.emplace(indexedFeature.index, cachedFeatures.begin());
+    return {*cachedLayer.layer, std::move(feature)};
+}
+
 optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(
         const GeometryCoordinates& queryGeometry,
         const std::array<float, 2>& translate,
@@ -241,4 +313,13 @@ void DynamicFeatureIndex::insert(std::shared_ptr<Feature> feature,
     features.push_back({std::move(feature), std::move(envelope)});
 }
 
+void FeatureIndexQuery::query(std::unordered_map<std::string, std::vector<Feature>>& result,
+                              const TransformState& transformState,
+                              const RenderedQueryOptions& options,
+                              const std::unordered_map<std::string, const RenderLayer*>& layers,
+                              const SourceFeatureState& featureState) const {
+    featureIndex->query(result, queryGeometry, transformState, posMatrix, tileSize, scale, options, tileID, layers,
+                        queryPadding, featureState);
+}
+
 } // namespace mbgl
@@ -5,9 +5,11 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/geo.hpp>
-#include <mbgl/util/grid_index.hpp>
 #include <mbgl/util/mat4.hpp>
 
+#include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -74,12 +76,20 @@ protected:
 
 class FeatureIndex {
 public:
+    // Decoded features kept for repeated queries, across all source layers of the tile.
+    static constexpr std::size_t maxCachedFeatures = 1024;
+
     FeatureIndex(std::unique_ptr<const GeometryTileData> tileData_);
+    ~FeatureIndex();
 
     const GeometryTileData* getData() { return tileData.get(); }
     
     void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketLeaderID);
 
+    // Packs the inserted geometries into the spatial index. Must be called once all features were
+    // inserted, before the index is queried.
+    void finish();
+
     void query(std::unordered_map<std::string, std::vector<Feature>>& result,
                const GeometryCoordinates& queryGeometry,
                const TransformState&,
@@ -119,10 +129,58 @@ private:
                     const mat4& posMatrix,
                     const SourceFeatureState* sourceFeatureState) const;
 
-    GridIndex<IndexedSubfeature> grid;
+    struct CachedFeature {
+        const GeometryTileLayer& layer;
+        std::shared_ptr<const GeometryTileFeature> feature;
+    };
+    CachedFeature getFeature(const IndexedSubfeature&) const;
+
+    class SpatialIndex;
+    std::unique_ptr<SpatialIndex> spatialIndex;
+    // Indexed features in the order they were inserted. Entries of the spatial index refer to them
+    // by their position, which is also their sort index.
+    std::vector<IndexedSubfeature> subfeatures;
     unsigned int sortIndex = 0;
 
+    // Source layers and decoded features that were hit by recent queries. Repeated queries over the
+    // same area, e.g. by hover handlers, don't decode them again. Once the cache is full, the least
+    // recently used feature is evicted.
+    struct CachedLayer;
+    struct CacheEntry {
+        CachedLayer& layer;
+        std::size_t index;
+        std::shared_ptr<const GeometryTileFeature> feature;
+    };
+    // Most recently used first.
+    using CacheEntries = std::list<CacheEntry>;
+    struct CachedLayer {
+        std::unique_ptr<GeometryTileLayer> layer;
+        std::unordered_map<std::size_t, CacheEntries::iterator> features;
+    };
+    mutable std::mutex cacheMutex;
+    mutable std::unordered_map<std::string, CachedLayer> cachedLayers;
+    mutable CacheEntries cachedFeatures;
+
     std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
     std::unique_ptr<const GeometryTileData> tileData;
 };
+
+// A query of the feature index of a rendered tile. It captures everything that depends on the tile
+// and on the render state at the time it was prepared, so that it can run on another thread.
+struct FeatureIndexQuery {
+    void query(std::unordered_map<std::string, std::vector<Feature>>& result,
+               const TransformState&,
+               const RenderedQueryOptions&,
+               const std::unordered_map<std::string, const RenderLayer*>&,
+               const SourceFeatureState&) const;
+
+    std::shared_ptr<const FeatureIndex> featureIndex;
+    GeometryCoordinates queryGeometry;
+    mat4 posMatrix;
+    double tileSize;
+    double scale;
+    UnwrappedTileID tileID;
+    float queryPadding;
+};
+
 } // namespace mbgl
@@ -8,6 +8,9 @@
 #include <mbgl/gfx/rendering_stats.hpp>
 #include <mbgl/gfx/texture.hpp>
 #include <mbgl/gfx/types.hpp>
+#include <mbgl/renderer/frame_profile.hpp>
+
+#include <vector>
 
 namespace mbgl {
 
@@ -27,6 +30,7 @@ public:
     static constexpr const uint32_t minimumRequiredVertexBindingCount = 8;
     const uint32_t maximumVertexBindingCount;
     bool supportsHalfFloatTextures = false;
+    bool supportsUnsignedIntIndices = false;
 
 public:
     Context(Context&&) = delete;
@@ -87,6 +91,14 @@ public:
 
     virtual const RenderingStats& renderingStats() const = 0;
 
+public:
+    // While enabled, every command encoder records the timings of its debug groups as a frame.
+    virtual void setProfilingEnabled(bool) = 0;
+
+    // Returns the recorded frames whose timings are complete. GPU timings lag behind by a few
+    // frames, so the last frames are only returned by later calls.
+    virtual std::vector<FrameProfile> takeFrameProfiles() = 0;
+
 #if not defined(NDEBUG)
 public:
     virtual void visualizeStencilBuffer() = 0;
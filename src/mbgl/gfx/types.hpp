@@ -139,6 +139,11 @@ enum class BufferUsageType : uint8_t {
     DynamicDraw,
 };
 
+enum class IndexType : uint8_t {
+    UnsignedShort,
+    UnsignedInt,
+};
+
 enum class TexturePixelType : uint8_t {
     RGBA,
     Alpha,
@@ -11,6 +11,8 @@
 namespace mbgl {
 namespace gfx {
 
+class Context;
+
 class UploadPass {
 protected:
     UploadPass() = default;
@@ -28,12 +30,16 @@ public:
         return { *this, name };
     }
 
+    // The context the resources are created for. Lets buckets pick a data layout that matches the
+    // capabilities of the device.
+    virtual Context& getContext() = 0;
+
 public:
     template <class Vertex>
     VertexBuffer<Vertex>
     createVertexBuffer(VertexVector<Vertex>&& v,
                        const BufferUsageType usage = BufferUsageType::StaticDraw) {
-        return { v.elements(), createVertexBufferResource(v.data(), v.bytes(), usage) };
+        return { v.elements(), createVertexBufferResource(v.data(), v.bytes(), usage, sizeof(Vertex)) };
     }
 
     template <class Vertex>
@@ -42,12 +48,26 @@ public:
         updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes());
     }
 
+    // Replaces `count` vertices of the buffer, starting at the vertex `offset`.
+    template <class Vertex>
+    void updateVertexBuffer(VertexBuffer<Vertex>& buffer, std::size_t offset, const Vertex* vertices, std::size_t count) {
+        assert(offset + count <= buffer.elements);
+        updateVertexBufferResourceRange(buffer.getResource(), offset * sizeof(Vertex), vertices, count * sizeof(Vertex));
+    }
+
     template <class DrawMode>
     IndexBuffer createIndexBuffer(IndexVector<DrawMode>&& v,
                                   const BufferUsageType usage = BufferUsageType::StaticDraw) {
         return { v.elements(), createIndexBufferResource(v.data(), v.bytes(), usage) };
     }
 
+    // Only available when the context supports 32-bit indices.
+    IndexBuffer createIndexBuffer(const std::vector<uint32_t>& v,
+                                  const BufferUsageType usage = BufferUsageType::StaticDraw) {
+        return { v.size(), createIndexBufferResource(v.data(), v.size() * sizeof(uint32_t), usage),
+                 IndexType::UnsignedInt };
+    }
+
     template <class DrawMode>
     void updateIndexBuffer(IndexBuffer& buffer, IndexVector<DrawMode>&& v) {
         assert(v.elements() == buffer.elements);
@@ -57,9 +77,14 @@ public:
 protected:
     virtual std::unique_ptr<VertexBufferResource> createVertexBufferResource(const void* data,
                                                                              std::size_t size,
-                                                                             BufferUsageType) = 0;
+                                                                             BufferUsageType,
+                                                                             std::size_t stride) = 0;
     virtual void
     updateVertexBufferResource(VertexBufferResource&, const void* data, std::size_t size) = 0;
+    virtual void updateVertexBufferResourceRange(VertexBufferResource&,
+                                                 std::size_t offset,
+                                                 const void* data,
+                                                 std::size_t size) = 0;
 
     virtual std::unique_ptr<IndexBufferResource> createIndexBufferResource(const void* data,
                                                                            std::size_t size,
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mbgl/gl/types.hpp>
+
+#include <string>
+
+namespace mbgl {
+namespace gl {
+
+// A linked program binary as returned by the driver, together with an identifier of
+// the shader sources, defines and driver it was produced from.
+class BinaryProgram {
+public:
+    // Initializes a BinaryProgram from its serialized representation. Throws if the
+    // data is malformed.
+    BinaryProgram(std::string&& data);
+
+    BinaryProgram(BinaryProgramFormat, std::string&& code, std::string identifier);
+
+    std::string serialize() const;
+
+    BinaryProgramFormat format() const {
+        return binaryFormat;
+    }
+
+    const std::string& code() const {
+        return binaryCode;
+    }
+
+    const std::string& identifier() const {
+        return binaryIdentifier;
+    }
+
+private:
+    BinaryProgramFormat binaryFormat = 0;
+    std::string binaryCode;
+    std::string binaryIdentifier;
+};
+
+} // namespace gl
+} // namespace mbgl
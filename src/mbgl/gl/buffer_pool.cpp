@@ -0,0 +1,171 @@
+#include <mbgl/gl/buffer_pool.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+std::size_t alignOffset(const std::size_t offset, const std::size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+constexpr std::size_t BufferPool::pageSize;
+constexpr std::size_t BufferPool::maxAllocationSize;
+
+BufferPool::BufferPool(Context& context_, const Type type_) : context(context_), type(type_) {
+}
+
+BufferPool::~BufferPool() {
+    // Any remaining pooled resources would dangle once their pages are gone.
+    assert(std::all_of(pages.begin(), pages.end(), [](const auto& page) { return page->used == 0; }));
+    releaseEmptyPages();
+}
+
+optional<BufferPool::Allocation> BufferPool::allocate(const std::size_t size, const std::size_t alignment) {
+    assert(alignment > 0);
+    if (size == 0 || size > maxAllocationSize) {
+        return {};
+    }
+
+    // Pick the free block that leaves the least space unused. Among equally good blocks, prefer the
+    // fullest page so that sparsely used pages drain and can be deleted.
+    BufferPoolPage* bestPage = nullptr;
+    std::map<std::size_t, std::size_t>::iterator bestBlock;
+    std::size_t bestSlack = 0;
+    for (auto& page : pages) {
+        for (auto block = page->freeBlocks.begin(); block != page->freeBlocks.end(); ++block) {
+            if (alignOffset(block->first, alignment) + size > block->first + block->second) {
+                continue;
+            }
+            const std::size_t slack = block->second - size;
+            if (!bestPage || slack < bestSlack || (slack == bestSlack && page->used > bestPage->used)) {
+                bestPage = page.get();
+                bestBlock = block;
+                bestSlack = slack;
+            }
+        }
+    }
+
+    if (!bestPage) {
+        bestPage = &createPage();
+        bestBlock = bestPage->freeBlocks.begin();
+    }
+
+    const std::size_t blockOffset = bestBlock->first;
+    const std::size_t blockEnd = blockOffset + bestBlock->second;
+    const std::size_t offset = alignOffset(blockOffset, alignment);
+    bestPage->freeBlocks.erase(bestBlock);
+    if (offset > blockOffset) {
+        bestPage->freeBlocks.emplace(blockOffset, offset - blockOffset);
+    }
+    if (offset + size < blockEnd) {
+        bestPage->freeBlocks.emplace(offset + size, blockEnd - offset - size);
+    }
+
+    bestPage->used += size;
+    // Allocations are reported like buffer objects of their own, so the stats don't depend on pooling.
+    auto& stats = context.renderingStats();
+    stats.numBuffers++;
+    (type == Type::Vertex ? stats.memVertexBuffers : stats.memIndexBuffers) += int(size);
+    stats.memPooledBuffersUsed += int(size);
+    return Allocation{ bestPage, offset };
+}
+
+void BufferPool::free(BufferPoolPage& page, const std::size_t offset, const std::size_t size) {
+    assert(&page.pool == this);
+    assert(page.used >= size);
+
+    auto& blocks = page.freeBlocks;
+    std::size_t start = offset;
+    std::size_t end = offset + size;
+
+    auto next = blocks.lower_bound(offset);
+    assert(next == blocks.end() || next->first >= end);
+    if (next != blocks.end() && next->first == end) {
+        end += next->second;
+        next = blocks.erase(next);
+    }
+    if (next != blocks.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->first + prev->second == start) {
+            start = prev->first;
+            blocks.erase(prev);
+        }
+    }
+    blocks.emplace(start, end - start);
+
+    page.used -= size;
+    auto& stats = context.renderingStats();
+    stats.numBuffers--;
+    (type == Type::Vertex ? stats.memVertexBuffers : stats.memIndexBuffers) -= int(size);
+    stats.memPooledBuffersUsed -= int(size);
+
+    if (page.used == 0) {
+        const auto emptyPages =
+            std::count_if(pages.begin(), pages.end(), [](const auto& p) { return p->used == 0; });
+        if (emptyPages > 1) {
+            releasePage(page);
+        }
+    }
+}
+
+void BufferPool::bind(const BufferPoolPage& page) {
+    if (type == Type::Vertex) {
+        context.vertexBuffer = page.buffer;
+    } else {
+        // Be sure to unbind any existing vertex array object before binding the index buffer
+        // so that we don't mess up another VAO
+        context.bindVertexArray = 0;
+        context.globalVertexArrayState.indexBuffer = page.buffer;
+    }
+}
+
+void BufferPool::releaseEmptyPages() {
+    while (true) {
+        const auto it = std::find_if(pages.begin(), pages.end(), [](const auto& page) { return page->used == 0; });
+        if (it == pages.end()) {
+            break;
+        }
+        releasePage(**it);
+    }
+}
+
+BufferPoolPage& BufferPool::createPage() {
+    BufferID id = 0;
+    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+    context.renderingStats().memPooledBuffers += int(pageSize);
+
+    // NOLINTNEXTLINE(performance-move-const-arg)
+    pages.push_back(std::make_unique<BufferPoolPage>(*this, UniqueBuffer{ std::move(id), { context } }));
+    auto& page = *pages.back();
+    page.freeBlocks.emplace(0, pageSize);
+
+    bind(page);
+    MBGL_CHECK_ERROR(glBufferData(type == Type::Vertex ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER,
+                                  pageSize, nullptr, GL_STATIC_DRAW));
+    return page;
+}
+
+void BufferPool::releasePage(BufferPoolPage& page) {
+    assert(page.used == 0);
+    auto& stats = context.renderingStats();
+    stats.memPooledBuffers -= int(pageSize);
+    // Deleting the page abandons its buffer object, which is deleted with the next cleanup. Like any
+    // other abandoned buffer object, it counts towards numBuffers until then.
+    stats.numBuffers++;
+    pages.erase(std::find_if(pages.begin(), pages.end(), [&](const auto& p) { return p.get() == &page; }));
+}
+
+} // namespace gl
+} // namespace mbgl
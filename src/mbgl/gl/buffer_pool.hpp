@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mbgl/gl/object.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+class BufferPool;
+
+// A large buffer object that a buffer pool carves allocations out of.
+class BufferPoolPage {
+public:
+    BufferPoolPage(BufferPool& pool_, UniqueBuffer&& buffer_) : pool(pool_), buffer(std::move(buffer_)) {}
+
+    BufferPool& pool;
+    UniqueBuffer buffer;
+
+    // Unallocated byte ranges, keyed by their offset. Adjacent ranges are always merged.
+    std::map<std::size_t, std::size_t> freeBlocks;
+    std::size_t used = 0;
+};
+
+// Suballocates static vertex or index buffers from a few large buffer objects, so that buckets
+// created and destroyed while tiles cycle through the cache don't each allocate and delete their
+// own buffer objects. Allocations are placed in the smallest free block that fits, freed blocks
+// are merged with their neighbours, and pages that become empty are deleted, except for one
+// spare page that is kept to absorb the next tile's allocations.
+class BufferPool {
+public:
+    enum class Type : bool { Vertex, Index };
+
+    BufferPool(Context&, Type);
+    ~BufferPool();
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    struct Allocation {
+        BufferPoolPage* page;
+        std::size_t offset;
+    };
+
+    // Returns nothing for sizes that are better served by a buffer object of their own.
+    optional<Allocation> allocate(std::size_t size, std::size_t alignment);
+    void free(BufferPoolPage&, std::size_t offset, std::size_t size);
+
+    // Binds the buffer object of a page for uploading data to it.
+    void bind(const BufferPoolPage&);
+
+    // Deletes all empty pages, including the spare one.
+    void releaseEmptyPages();
+
+    static constexpr std::size_t pageSize = 1024 * 1024;
+    static constexpr std::size_t maxAllocationSize = pageSize / 4;
+
+private:
+    BufferPoolPage& createPage();
+    void releasePage(BufferPoolPage&);
+
+    Context& context;
+    const Type type;
+    std::vector<std::unique_ptr<BufferPoolPage>> pages;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -4,6 +4,7 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/renderable_resource.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
+#include <mbgl/gl/profiler.hpp>
 #include <mbgl/platform/gl_functions.hpp>
 
 #include <cstring>
@@ -11,9 +12,21 @@
 namespace mbgl {
 namespace gl {
 
+// Each command encoder records a frame, so that profiles cover everything until the cleanup.
+CommandEncoder::CommandEncoder(gl::Context& context_) : context(context_) {
+    if (auto profiler = context.getProfiler()) {
+        profiler->beginFrame();
+    }
+}
+
 CommandEncoder::~CommandEncoder() {
-    const auto debugGroup(createDebugGroup("cleanup"));
-    context.performCleanup();
+    {
+        const auto debugGroup(createDebugGroup("cleanup"));
+        context.performCleanup();
+    }
+    if (auto profiler = context.getProfiler()) {
+        profiler->endFrame();
+    }
 }
 
 std::unique_ptr<gfx::UploadPass>
@@ -31,7 +44,9 @@ void CommandEncoder::present(gfx::Renderable& renderable) {
 }
 
 void CommandEncoder::pushDebugGroup(const char* name) {
-    (void)name;
+    if (auto profiler = context.getProfiler()) {
+        profiler->pushGroup(name);
+    }
 #ifndef NDEBUG
     if (auto debugging = context.getDebuggingExtension()) {
         if (debugging->pushDebugGroup) {
@@ -45,6 +60,9 @@ void CommandEncoder::pushDebugGroup(const char* name) {
 }
 
 void CommandEncoder::popDebugGroup() {
+    if (auto profiler = context.getProfiler()) {
+        profiler->popGroup();
+    }
 #ifndef NDEBUG
     if (auto debugging = context.getDebuggingExtension()) {
         if (debugging->popDebugGroup) {
@@ -9,6 +9,12 @@
 #include <mbgl/gl/command_encoder.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
+#include <mbgl/gl/program_binary_extension.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
+#include <mbgl/gl/profiler.hpp>
+#include <mbgl/gl/stream_buffer.hpp>
+#include <mbgl/gl/buffer_pool.hpp>
+#include <mbgl/gl/index_buffer_resource.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
@@ -56,9 +62,19 @@ Context::Context(RendererBackend& backend_)
           return value;
       }()),
       backend(backend_),
-      stats() {}
+      stats(),
+      streamBuffer(std::make_unique<StreamBuffer>(*this)),
+      vertexBufferPool(std::make_unique<BufferPool>(*this, BufferPool::Type::Vertex)),
+      indexBufferPool(std::make_unique<BufferPool>(*this, BufferPool::Type::Index)) {}
 
 Context::~Context() {
+    // The profiler deletes its timer queries.
+    profiler.reset();
+    // Abandon the stream buffer and pool page objects so that they are deleted along with
+    // everything else.
+    streamBuffer.reset();
+    vertexBufferPool.reset();
+    indexBufferPool.reset();
     if (cleanupOnDestruction) {
         reset();
         assert(stats.isZero());
@@ -119,9 +135,32 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
             supportsHalfFloatTextures = true;
         }
 
+#if MBGL_USE_GLES2
+        supportsUnsignedIntIndices = strstr(extensions, "GL_OES_element_index_uint") != nullptr;
+#else
+        supportsUnsignedIntIndices = true;
+#endif
+
         if (!supportsVertexArrays()) {
             Log::Warning(Event::OpenGL, "Not using Vertex Array Objects");
         }
+
+        timerQuery = std::make_unique<extension::TimerQuery>(fn);
+        if (timerQuery->genQueries && timerQuery->deleteQueries && timerQuery->queryCounter &&
+            timerQuery->getQueryObjectiv && timerQuery->getQueryObjectui64v) {
+            timerQuery->checksDisjoint = strstr(extensions, "GL_EXT_disjoint_timer_query") != nullptr;
+        } else {
+            timerQuery.reset();
+        }
+
+        programBinary = std::make_unique<extension::ProgramBinary>(fn);
+        if (supportsProgramBinaries()) {
+            const auto getString = [](GLenum name) -> std::string {
+                const auto* value = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(name)));
+                return value ? value : "";
+            };
+            driverIdentifier = getString(GL_VENDOR) + '\n' + getString(GL_RENDERER) + '\n' + getString(GL_VERSION);
+        }
     }
 }
 
@@ -176,11 +215,58 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     // AttributeLocations::getFirstAttribName.
     MBGL_CHECK_ERROR(glBindAttribLocation(result, 0, location0AttribName));
 
+    if (supportsProgramBinaries() && programBinary->programParameteri) {
+        MBGL_CHECK_ERROR(programBinary->programParameteri(result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     linkProgram(result);
 
     return result;
 }
 
+UniqueProgram Context::createProgram(BinaryProgramFormat binaryFormat, const std::string& binaryProgram) {
+    assert(supportsProgramBinaries());
+    UniqueProgram result { MBGL_CHECK_ERROR(glCreateProgram()), { this } };
+    MBGL_CHECK_ERROR(programBinary->programBinary(result, static_cast<GLenum>(binaryFormat), binaryProgram.data(),
+                                                  static_cast<GLint>(binaryProgram.size())));
+
+    // Unlike a failed compilation, a rejected binary is expected and handled by the
+    // caller, so don't log the link status as an error.
+    GLint status;
+    MBGL_CHECK_ERROR(glGetProgramiv(result, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        throw std::runtime_error("binary program was rejected by the driver");
+    }
+
+    return result;
+}
+
+bool Context::supportsProgramBinaries() const {
+    return programBinary && programBinary->getProgramBinary && programBinary->programBinary;
+}
+
+optional<std::pair<BinaryProgramFormat, std::string>> Context::getBinaryProgram(ProgramID program_) const {
+    if (!supportsProgramBinaries()) {
+        return {};
+    }
+
+    GLint binaryLength = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+    if (binaryLength <= 0) {
+        return {};
+    }
+
+    std::string binary;
+    binary.resize(binaryLength);
+    GLenum binaryFormat;
+    MBGL_CHECK_ERROR(programBinary->getProgramBinary(program_, binaryLength, &binaryLength, &binaryFormat, &binary[0]));
+    if (static_cast<std::size_t>(binaryLength) != binary.size()) {
+        return {};
+    }
+
+    return { { binaryFormat, std::move(binary) } };
+}
+
 void Context::linkProgram(ProgramID program_) {
     MBGL_CHECK_ERROR(glLinkProgram(program_));
     verifyProgramLinkage(program_);
@@ -455,6 +541,11 @@ std::unique_ptr<gfx::DrawScopeResource> Context::createDrawScopeResource() {
 void Context::reset() {
     std::copy(pooledTextures.begin(), pooledTextures.end(), std::back_inserter(abandonedTextures));
     pooledTextures.resize(0);
+    // The buffer pools are already gone when resetting during destruction.
+    if (vertexBufferPool) {
+        vertexBufferPool->releaseEmptyPages();
+        indexBufferPool->releaseEmptyPages();
+    }
     performCleanup();
 }
 
@@ -600,11 +691,37 @@ const gfx::RenderingStats& Context::renderingStats() const {
     return stats;
 }
 
+void Context::setProfilingEnabled(const bool enabled) {
+    if (enabled && !profiler) {
+        profiler = std::make_unique<Profiler>(*this);
+    } else if (!enabled) {
+        profiler.reset();
+    }
+}
+
+std::vector<FrameProfile> Context::takeFrameProfiles() {
+    return profiler ? profiler->takeFinishedFrames() : std::vector<FrameProfile>();
+}
+
 void Context::finish() {
     MBGL_CHECK_ERROR(glFinish());
 }
 
+namespace {
+
+std::size_t indexSize(const gfx::IndexType type) {
+    return type == gfx::IndexType::UnsignedInt ? sizeof(uint32_t) : sizeof(uint16_t);
+}
+
+// Pooled index buffers start at an offset into the pool page.
+std::size_t indexByteOffset(const gfx::IndexBuffer& indexBuffer, const std::size_t indexOffset) {
+    return indexBuffer.getResource<IndexBufferResource>().poolOffset + indexSize(indexBuffer.type) * indexOffset;
+}
+
+} // namespace
+
 void Context::draw(const gfx::DrawMode& drawMode,
+                   const gfx::IndexBuffer& indexBuffer,
                    std::size_t indexOffset,
                    std::size_t indexLength) {
     switch (drawMode.type) {
@@ -626,8 +743,8 @@ void Context::draw(const gfx::DrawMode& drawMode,
     MBGL_CHECK_ERROR(glDrawElements(
         Enum<gfx::DrawModeType>::to(drawMode.type),
         static_cast<GLsizei>(indexLength),
-        GL_UNSIGNED_SHORT,
-        reinterpret_cast<GLvoid*>(sizeof(uint16_t) * indexOffset)));
+        Enum<gfx::IndexType>::to(indexBuffer.type),
+        reinterpret_cast<GLvoid*>(indexByteOffset(indexBuffer, indexOffset))));
 
     stats.numDrawCalls++;
 }
@@ -717,6 +834,8 @@ void Context::performCleanup() {
 }
 
 void Context::reduceMemoryUsage() {
+    vertexBufferPool->releaseEmptyPages();
+    indexBufferPool->releaseEmptyPages();
     performCleanup();
 
     // Ensure that all pending actions are executed to ensure that they happen before the app goes
@@ -14,6 +14,7 @@
 #include <mbgl/gfx/color_mode.hpp>
 #include <mbgl/platform/gl_functions.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 
 
 #include <functional>
@@ -21,6 +22,7 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <utility>
 
 namespace mbgl {
 namespace gl {
@@ -28,10 +30,15 @@ namespace gl {
 constexpr size_t TextureMax = 64;
 using ProcAddress = void (*)();
 class RendererBackend;
+class StreamBuffer;
+class BufferPool;
+class Profiler;
 
 namespace extension {
 class VertexArray;
+class TimerQuery;
 class Debugging;
+class ProgramBinary;
 } // namespace extension
 
 class Context final : public gfx::Context {
@@ -46,12 +53,21 @@ public:
     gfx::RenderingStats& renderingStats();
     const gfx::RenderingStats& renderingStats() const override;
 
+    void setProfilingEnabled(bool) override;
+    std::vector<FrameProfile> takeFrameProfiles() override;
+
     void initializeExtensions(const std::function<gl::ProcAddress(const char*)>&);
 
     void enableDebugging();
 
     UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources);
     UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
+    // Throws if the driver rejects the binary, e.g. after a driver update.
+    UniqueProgram createProgram(BinaryProgramFormat binaryFormat, const std::string& binaryProgram);
+    bool supportsProgramBinaries() const;
+    optional<std::pair<BinaryProgramFormat, std::string>> getBinaryProgram(ProgramID) const;
+    // Identifies the GL implementation that produced a program binary.
+    const std::string& getDriverIdentifier() const { return driverIdentifier; }
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
     UniqueTexture createUniqueTexture();
@@ -92,6 +108,7 @@ public:
     void setCullFaceMode(const gfx::CullFaceMode&);
 
     void draw(const gfx::DrawMode&,
+              const gfx::IndexBuffer&,
               std::size_t indexOffset,
               std::size_t indexLength);
 
@@ -127,6 +144,27 @@ public:
         return vertexArray.get();
     }
 
+    extension::TimerQuery* getTimerQueryExtension() const {
+        return timerQuery.get();
+    }
+
+    // Only set while profiling is enabled.
+    Profiler* getProfiler() const {
+        return profiler.get();
+    }
+
+    StreamBuffer& getStreamBuffer() {
+        return *streamBuffer;
+    }
+
+    BufferPool& getVertexBufferPool() {
+        return *vertexBufferPool;
+    }
+
+    BufferPool& getIndexBufferPool() {
+        return *indexBufferPool;
+    }
+
     void setCleanupOnDestruction(bool cleanup) {
         cleanupOnDestruction = cleanup;
     }
@@ -138,6 +176,13 @@ private:
     gfx::RenderingStats stats;
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
+    std::unique_ptr<extension::TimerQuery> timerQuery;
+    std::unique_ptr<extension::ProgramBinary> programBinary;
+    std::unique_ptr<StreamBuffer> streamBuffer;
+    std::unique_ptr<BufferPool> vertexBufferPool;
+    std::unique_ptr<BufferPool> indexBufferPool;
+    std::unique_ptr<Profiler> profiler;
+    std::string driverIdentifier;
 
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
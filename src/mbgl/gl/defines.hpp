@@ -75,6 +75,7 @@
 #define GL_FUNC_REVERSE_SUBTRACT 0x800B
 #define GL_FUNC_SUBTRACT 0x800A
 #define GL_GEQUAL 0x0206
+#define GL_GPU_DISJOINT_EXT 0x8FBB
 #define GL_GREATER 0x0204
 #define GL_INCR 0x1E02
 #define GL_INCR_WRAP 0x8507
@@ -117,6 +118,8 @@
 #define GL_OUT_OF_MEMORY 0x0505
 #define GL_PACK_ALIGNMENT 0x0D05
 #define GL_POINTS 0x0000
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
 #define GL_RENDERBUFFER 0x8D41
 #define GL_RENDERBUFFER_BINDING 0x8CA7
 #define GL_RENDERER 0x1F01
@@ -153,6 +156,7 @@
 #define GL_TEXTURE_MIN_FILTER 0x2801
 #define GL_TEXTURE_WRAP_S 0x2802
 #define GL_TEXTURE_WRAP_T 0x2803
+#define GL_TIMESTAMP 0x8E28
 #define GL_TRIANGLE_FAN 0x0006
 #define GL_TRIANGLES 0x0004
 #define GL_TRIANGLE_STRIP 0x0005
@@ -161,6 +165,8 @@
 #define GL_UNSIGNED_BYTE 0x1401
 #define GL_UNSIGNED_INT 0x1405
 #define GL_UNSIGNED_SHORT 0x1403
+#define GL_VENDOR 0x1F00
+#define GL_VERSION 0x1F02
 #define GL_VERTEX_SHADER 0x8B31
 #define GL_VIEWPORT 0x0BA2
 #define GL_ZERO 0
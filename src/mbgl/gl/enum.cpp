@@ -241,6 +241,24 @@ platform::GLenum Enum<gfx::BufferUsageType>::to(const gfx::BufferUsageType value
     return GL_INVALID_ENUM;
 }
 
+template <>
+gfx::IndexType Enum<gfx::IndexType>::from(const platform::GLint value) {
+    switch (value) {
+        case GL_UNSIGNED_SHORT: return gfx::IndexType::UnsignedShort;
+        case GL_UNSIGNED_INT: return gfx::IndexType::UnsignedInt;
+    }
+    return {};
+}
+
+template <>
+platform::GLenum Enum<gfx::IndexType>::to(const gfx::IndexType value) {
+    switch (value) {
+        case gfx::IndexType::UnsignedShort: return GL_UNSIGNED_SHORT;
+        case gfx::IndexType::UnsignedInt: return GL_UNSIGNED_INT;
+    }
+    return GL_INVALID_ENUM;
+}
+
 template <>
 gfx::TexturePixelType Enum<gfx::TexturePixelType>::from(const platform::GLint value) {
     switch (value) {
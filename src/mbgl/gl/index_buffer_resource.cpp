@@ -1,3 +1,4 @@
+#include <mbgl/gl/buffer_pool.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/index_buffer_resource.hpp>
 
@@ -5,6 +6,10 @@ namespace mbgl {
 namespace gl {
 
 IndexBufferResource::~IndexBufferResource() {
+    if (poolPage) {
+        buffer.release();
+        poolPage->pool.free(*poolPage, poolOffset, poolSize);
+    }
     auto& stats = buffer.get_deleter().context.renderingStats();
     stats.memIndexBuffers -= byteSize;
     assert(stats.memIndexBuffers >= 0);
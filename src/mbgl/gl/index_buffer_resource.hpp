@@ -3,9 +3,13 @@
 #include <mbgl/gfx/index_buffer.hpp>
 #include <mbgl/gl/object.hpp>
 
+#include <cstddef>
+
 namespace mbgl {
 namespace gl {
 
+class BufferPoolPage;
+
 class IndexBufferResource : public gfx::IndexBufferResource {
 public:
     IndexBufferResource(UniqueBuffer&& buffer_, int byteSize_) : buffer(std::move(buffer_)), byteSize(byteSize_) {}
@@ -13,6 +17,12 @@ public:
 
     UniqueBuffer buffer;
     int byteSize;
+
+    // Set for index buffers suballocated from a buffer pool. They share the buffer object of the
+    // pool page without owning it, and their indices start poolOffset bytes into it.
+    BufferPoolPage* poolPage = nullptr;
+    std::size_t poolOffset = 0;
+    std::size_t poolSize = 0;
 };
 
 } // namespace gl
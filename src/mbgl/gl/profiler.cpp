@@ -0,0 +1,168 @@
+#include <mbgl/gl/profiler.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+// Frames whose queries didn't resolve after this many frames are reported without GPU timings,
+// e.g. when the driver never makes the results available.
+constexpr std::size_t maxPendingFrames = 8;
+
+} // namespace
+
+Profiler::Profiler(Context& context) : timerQuery(context.getTimerQueryExtension()) {
+}
+
+Profiler::~Profiler() {
+    if (current) {
+        recycle(*current);
+    }
+    for (auto& frame : pending) {
+        recycle(frame);
+    }
+    if (timerQuery && !unusedQueries.empty()) {
+        MBGL_CHECK_ERROR(timerQuery->deleteQueries(GLsizei(unusedQueries.size()), unusedQueries.data()));
+    }
+}
+
+void Profiler::beginFrame() {
+    assert(!current);
+    current = PendingFrame();
+    current->profile.frame = frameCount++;
+    current->profile.start = Clock::now();
+    current->frameBegin = queryTimestamp();
+}
+
+void Profiler::endFrame() {
+    // Profiling may have been enabled while the frame was already being encoded.
+    if (!current) {
+        return;
+    }
+    assert(stack.empty());
+    current->frameEnd = queryTimestamp();
+    current->profile.cpuDuration = Clock::now() - current->profile.start;
+    pending.push_back(std::move(*current));
+    current = {};
+}
+
+void Profiler::pushGroup(const char* name) {
+    if (!current) {
+        return;
+    }
+    FrameProfile::Group group;
+    group.name = name;
+    group.depth = stack.size();
+    group.cpuStart = Clock::now() - current->profile.start;
+    stack.push_back(current->profile.groups.size());
+    current->profile.groups.push_back(std::move(group));
+    current->groupQueries.emplace_back(queryTimestamp(), nullopt);
+}
+
+void Profiler::popGroup() {
+    if (!current) {
+        return;
+    }
+    assert(!stack.empty());
+    const std::size_t index = stack.back();
+    stack.pop_back();
+    auto& group = current->profile.groups[index];
+    group.cpuDuration = Clock::now() - current->profile.start - group.cpuStart;
+    current->groupQueries[index].second = queryTimestamp();
+}
+
+std::vector<FrameProfile> Profiler::takeFinishedFrames() {
+    // A disjoint operation invalidates the timings of all queries that are still in flight.
+    bool disjoint = false;
+    if (timerQuery && timerQuery->checksDisjoint) {
+        GLint value = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_GPU_DISJOINT_EXT, &value));
+        disjoint = value != 0;
+    }
+
+    std::vector<FrameProfile> result;
+    while (!pending.empty() && resolve(pending.front(), disjoint || pending.size() > maxPendingFrames)) {
+        result.push_back(std::move(pending.front().profile));
+        recycle(pending.front());
+        pending.pop_front();
+    }
+    return result;
+}
+
+optional<QueryID> Profiler::queryTimestamp() {
+    if (!timerQuery) {
+        return {};
+    }
+    QueryID id = 0;
+    if (unusedQueries.empty()) {
+        MBGL_CHECK_ERROR(timerQuery->genQueries(1, &id));
+    } else {
+        id = unusedQueries.back();
+        unusedQueries.pop_back();
+    }
+    MBGL_CHECK_ERROR(timerQuery->queryCounter(id, GL_TIMESTAMP));
+    return id;
+}
+
+bool Profiler::resolve(PendingFrame& frame, const bool discardGPUTimings) {
+    if (!frame.frameBegin || !frame.frameEnd || discardGPUTimings) {
+        return true;
+    }
+
+    GLint available = 0;
+    MBGL_CHECK_ERROR(timerQuery->getQueryObjectiv(*frame.frameEnd, GL_QUERY_RESULT_AVAILABLE, &available));
+    if (!available) {
+        return false;
+    }
+
+    // Timestamps are written in order, so all earlier queries of the frame are available too.
+    const auto timestamp = [&](const QueryID id) {
+        uint64_t value = 0;
+        MBGL_CHECK_ERROR(timerQuery->getQueryObjectui64v(id, GL_QUERY_RESULT, &value));
+        return value;
+    };
+    const auto duration = [](const uint64_t begin, const uint64_t end) -> Duration {
+        return std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(end - begin));
+    };
+
+    const uint64_t frameBegin = timestamp(*frame.frameBegin);
+    frame.profile.gpuDuration = duration(frameBegin, timestamp(*frame.frameEnd));
+    for (std::size_t i = 0; i < frame.groupQueries.size(); ++i) {
+        const auto& queries = frame.groupQueries[i];
+        if (queries.first && queries.second) {
+            const uint64_t begin = timestamp(*queries.first);
+            auto& group = frame.profile.groups[i];
+            group.gpuStart = duration(frameBegin, begin);
+            group.gpuDuration = duration(begin, timestamp(*queries.second));
+        }
+    }
+    return true;
+}
+
+void Profiler::recycle(PendingFrame& frame) {
+    const auto reuse = [&](const optional<QueryID>& query) {
+        if (query) {
+            unusedQueries.push_back(*query);
+        }
+    };
+    reuse(frame.frameBegin);
+    reuse(frame.frameEnd);
+    for (const auto& queries : frame.groupQueries) {
+        reuse(queries.first);
+        reuse(queries.second);
+    }
+    frame.frameBegin = {};
+    frame.frameEnd = {};
+    frame.groupQueries.clear();
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mbgl/gl/types.hpp>
+#include <mbgl/renderer/frame_profile.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+
+namespace extension {
+class TimerQuery;
+} // namespace extension
+
+// Records the CPU time spent in every debug group of a frame. When the timer query extension is
+// available, it also brackets each group with GPU timestamp queries. Their results become
+// available a few frames later, so frames are only handed out once all their queries resolved.
+class Profiler {
+public:
+    explicit Profiler(Context&);
+    ~Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+
+    void pushGroup(const char* name);
+    void popGroup();
+
+    // Returns the frames whose timings are complete, oldest first.
+    std::vector<FrameProfile> takeFinishedFrames();
+
+private:
+    struct PendingFrame {
+        FrameProfile profile;
+        // Timestamp queries of the frame and of each group, in the order of profile.groups.
+        optional<QueryID> frameBegin;
+        optional<QueryID> frameEnd;
+        std::vector<std::pair<optional<QueryID>, optional<QueryID>>> groupQueries;
+    };
+
+    optional<QueryID> queryTimestamp();
+    bool resolve(PendingFrame&, bool discardGPUTimings);
+    void recycle(PendingFrame&);
+
+    extension::TimerQuery* const timerQuery;
+
+    uint64_t frameCount = 0;
+    optional<PendingFrame> current;
+    // Indices of the open groups of the current frame.
+    std::vector<std::size_t> stack;
+    std::deque<PendingFrame> pending;
+    std::vector<QueryID> unusedQueries;
+};
+
+} // namespace gl
+} // namespace mbgl
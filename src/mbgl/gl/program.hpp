@@ -10,12 +10,14 @@
 #include <mbgl/gfx/uniform.hpp>
 #include <mbgl/gl/vertex_array.hpp>
 #include <mbgl/gl/attribute.hpp>
+#include <mbgl/gl/binary_program.hpp>
 #include <mbgl/gl/uniform.hpp>
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/util/io.hpp>
 
 #include <mbgl/util/logging.hpp>
 #include <mbgl/programs/program_parameters.hpp>
+#include <mbgl/programs/gl/preludes.hpp>
 #include <mbgl/programs/gl/shader_source.hpp>
 #include <mbgl/programs/gl/shaders.hpp>
 
@@ -55,6 +57,14 @@ public:
             textureStates.queryLocations(program);
         }
 
+        // Reuses a program binary from the program cache.
+        Instance(Context& context, const BinaryProgram& binaryProgram)
+            : program(context.createProgram(binaryProgram.format(), binaryProgram.code())) {
+            attributeLocations.queryLocations(program);
+            uniformStates.queryLocations(program);
+            textureStates.queryLocations(program);
+        }
+
         static std::unique_ptr<Instance>
         createInstance(gl::Context& context,
                        const ProgramParameters& programParameters,
@@ -72,7 +82,49 @@ public:
                 (programs::gl::shaderSource() + programs::gl::fragmentPreludeOffset),
                 (programs::gl::shaderSource() + fragmentOffset)
             };
-            return std::make_unique<Instance>(context, vertexSource, fragmentSource);
+
+            const char* name = programs::gl::ShaderSource<Name>::name;
+
+            // Load the program binary from the cache if it was produced from the same sources
+            // and defines by the same driver; otherwise fall back to compiling from source.
+            const optional<std::string> cachePath = programParameters.cachePath(name, additionalDefines);
+            std::string identifier;
+            if (cachePath && context.supportsProgramBinaries()) {
+                identifier = context.getDriverIdentifier() +
+                             programs::gl::programIdentifier(programParameters.getDefines(),
+                                                             additionalDefines,
+                                                             programs::gl::preludeHash,
+                                                             programs::gl::ShaderSource<Name>::hash);
+                try {
+                    if (auto cachedBinaryProgram = util::readFile(*cachePath)) {
+                        const BinaryProgram binaryProgram(std::move(*cachedBinaryProgram));
+                        if (binaryProgram.identifier() == identifier) {
+                            return std::make_unique<Instance>(context, binaryProgram);
+                        }
+                        Log::Warning(Event::OpenGL, "Cached program %s changed. Recompilation required.", name);
+                    }
+                } catch (const std::exception& error) {
+                    Log::Warning(Event::OpenGL, "Could not load cached program %s: %s", name, error.what());
+                }
+            }
+
+            auto result = std::make_unique<Instance>(context, vertexSource, fragmentSource);
+
+            if (!identifier.empty()) {
+                try {
+                    if (auto binaryProgram = context.getBinaryProgram(result->program)) {
+                        util::write_file(
+                            *cachePath,
+                            BinaryProgram(binaryProgram->first, std::move(binaryProgram->second), identifier)
+                                .serialize());
+                        Log::Debug(Event::OpenGL, "Caching program in: %s", cachePath->c_str());
+                    }
+                } catch (const std::exception& error) {
+                    Log::Warning(Event::OpenGL, "Could not cache program %s: %s", name, error.what());
+                }
+            }
+
+            return result;
         }
 
         UniqueProgram program;
@@ -127,6 +179,7 @@ public:
                         instance.attributeLocations.toBindingArray(attributeBindings));
 
         context.draw(drawMode,
+                     indexBuffer,
                      indexOffset,
                      indexLength);
     }
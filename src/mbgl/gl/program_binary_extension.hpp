@@ -0,0 +1,42 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH           0x8741
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+class ProgramBinary {
+public:
+    template <typename Fn>
+    ProgramBinary(const Fn& loadExtension)
+        : getProgramBinary(loadExtension({ { "GL_OES_get_program_binary", "glGetProgramBinaryOES" },
+                                           { "GL_ARB_get_program_binary", "glGetProgramBinary" } })),
+          programBinary(loadExtension({ { "GL_OES_get_program_binary", "glProgramBinaryOES" },
+                                        { "GL_ARB_get_program_binary", "glProgramBinary" } })),
+          programParameteri(loadExtension({ { "GL_ARB_get_program_binary", "glProgramParameteri" } })) {
+    }
+
+    const ExtensionFunction<void(platform::GLuint program,
+                                 platform::GLsizei bufSize,
+                                 platform::GLsizei* length,
+                                 platform::GLenum* binaryFormat,
+                                 platform::GLvoid* binary)> getProgramBinary;
+
+    const ExtensionFunction<void(platform::GLuint program,
+                                 platform::GLenum binaryFormat,
+                                 const platform::GLvoid* binary,
+                                 platform::GLint length)> programBinary;
+
+    // Only needed on desktop GL to ask the driver to keep the binary retrievable.
+    const ExtensionFunction<void(platform::GLuint program, platform::GLenum pname, platform::GLint value)>
+        programParameteri;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,156 @@
+#include <mbgl/gl/stream_buffer.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+StreamBuffer::StreamBuffer(Context& context_) : context(context_) {
+}
+
+StreamBuffer::~StreamBuffer() {
+    // Any remaining streamed resources would dangle once the stream buffer is gone.
+    assert(slices.empty());
+}
+
+std::unique_ptr<VertexBufferResource> StreamBuffer::create(const void* data,
+                                                           const std::size_t size,
+                                                           const std::size_t stride) {
+    assert(stride > 0);
+    auto result = std::make_unique<VertexBufferResource>(UniqueBuffer{ 0, { context } }, 0);
+    result->streamBuffer = this;
+    result->streamStride = stride;
+    result->streamIndex = slices.size();
+    result->streamData.resize(size);
+    if (size > 0) {
+        std::memcpy(result->streamData.data(), data, size);
+    }
+    slices.push_back(result.get());
+    needsRepack = true;
+    return result;
+}
+
+void StreamBuffer::update(VertexBufferResource& slice, const void* data, const std::size_t size) {
+    assert(slice.streamBuffer == this);
+    slice.streamData.resize(size);
+    std::memcpy(slice.streamData.data(), data, size);
+    if (size > slice.streamCapacity) {
+        needsRepack = true;
+    } else {
+        markDirty(slice, 0, size);
+    }
+}
+
+void StreamBuffer::update(VertexBufferResource& slice,
+                          const std::size_t offset,
+                          const void* data,
+                          const std::size_t size) {
+    assert(slice.streamBuffer == this);
+    assert(offset + size <= slice.streamData.size());
+    std::memcpy(slice.streamData.data() + offset, data, size);
+    if (offset + size > slice.streamCapacity) {
+        needsRepack = true;
+    } else {
+        markDirty(slice, offset, offset + size);
+    }
+}
+
+void StreamBuffer::remove(VertexBufferResource& slice) {
+    assert(slice.streamBuffer == this);
+    assert(slices[slice.streamIndex] == &slice);
+    // The slot of a removed slice stays allocated until the slices are packed again, so the
+    // remaining slices can keep their offsets.
+    slices.back()->streamIndex = slice.streamIndex;
+    slices[slice.streamIndex] = slices.back();
+    slices.pop_back();
+}
+
+void StreamBuffer::markDirty(VertexBufferResource& slice, const std::size_t begin, const std::size_t end) {
+    if (begin == end) {
+        return;
+    }
+    if (slice.streamDirtyBegin == slice.streamDirtyEnd) {
+        slice.streamDirtyBegin = begin;
+        slice.streamDirtyEnd = end;
+    } else {
+        slice.streamDirtyBegin = std::min(slice.streamDirtyBegin, begin);
+        slice.streamDirtyEnd = std::max(slice.streamDirtyEnd, end);
+    }
+    dirty = true;
+}
+
+void StreamBuffer::upload() {
+    if (needsRepack) {
+        repack();
+    } else if (dirty) {
+        // Copy only the changed ranges into the packed copy.
+        for (auto* slice : slices) {
+            if (slice->streamDirtyBegin == slice->streamDirtyEnd) {
+                continue;
+            }
+            std::memcpy(staging.data() + slice->streamOffset * slice->streamStride + slice->streamDirtyBegin,
+                        slice->streamData.data() + slice->streamDirtyBegin,
+                        slice->streamDirtyEnd - slice->streamDirtyBegin);
+            slice->streamDirtyBegin = slice->streamDirtyEnd = 0;
+        }
+    } else {
+        return;
+    }
+    dirty = false;
+
+    if (staging.empty()) {
+        return;
+    }
+
+    auto& stats = context.renderingStats();
+    if (!resource) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        stats.numBuffers++;
+        // NOLINTNEXTLINE(performance-move-const-arg)
+        resource = std::make_unique<VertexBufferResource>(UniqueBuffer{ std::move(id), { context } }, 0);
+    }
+    const auto size = staging.size();
+    stats.memVertexBuffers += int(size) - resource->byteSize;
+    resource->byteSize = int(size);
+
+    // Orphan the storage that draw calls of the previous frame may still read from, so that the
+    // driver doesn't have to wait for them, then write all slices at once.
+    context.vertexBuffer = resource->buffer;
+    MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW));
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, staging.data()));
+}
+
+void StreamBuffer::repack() {
+    needsRepack = false;
+
+    // Pack the slices, aligning each to its stride so that it can be addressed with a vertex offset.
+    std::size_t size = 0;
+    for (auto* slice : slices) {
+        const std::size_t stride = slice->streamStride;
+        const std::size_t offset = (size + stride - 1) / stride * stride;
+        slice->streamOffset = offset / stride;
+        slice->streamCapacity = slice->streamData.size();
+        slice->streamDirtyBegin = slice->streamDirtyEnd = 0;
+        size = offset + slice->streamCapacity;
+    }
+
+    staging.resize(size);
+    for (const auto* slice : slices) {
+        if (!slice->streamData.empty()) {
+            std::memcpy(staging.data() + slice->streamOffset * slice->streamStride,
+                        slice->streamData.data(),
+                        slice->streamData.size());
+        }
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
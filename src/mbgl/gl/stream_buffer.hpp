@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mbgl/gl/vertex_buffer_resource.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+
+// Backs all vertex buffers created with BufferUsageType::StreamDraw with slices of a single buffer
+// object. Updates to those buffers only touch client memory and record the changed byte range. The
+// first upload after a change copies just those ranges into a packed copy of all slices, orphans
+// the buffer storage and writes the packed copy with a single call. Orphaning means the driver
+// doesn't have to wait for draw calls from the previous frame that still read from the storage.
+// The packed copy is only rebuilt when a slice is added or outgrows its slot.
+class StreamBuffer {
+public:
+    explicit StreamBuffer(Context&);
+    ~StreamBuffer();
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    std::unique_ptr<VertexBufferResource> create(const void* data, std::size_t size, std::size_t stride);
+    void update(VertexBufferResource&, const void* data, std::size_t size);
+    // Replaces part of a slice without changing its size.
+    void update(VertexBufferResource&, std::size_t offset, const void* data, std::size_t size);
+    void remove(VertexBufferResource&);
+
+    // Uploads the packed slices if any of them changed since the last upload.
+    void upload();
+
+    // The buffer object holding the packed slices, or nullptr until slice data has been uploaded.
+    const VertexBufferResource* getResource() const {
+        return resource.get();
+    }
+
+private:
+    void markDirty(VertexBufferResource&, std::size_t begin, std::size_t end);
+    void repack();
+
+    Context& context;
+    std::unique_ptr<VertexBufferResource> resource;
+    std::vector<VertexBufferResource*> slices;
+    std::vector<uint8_t> staging;
+    // Set when slices must be packed again, because one was added or outgrew its slot.
+    bool needsRepack = false;
+    bool dirty = false;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+class TimerQuery {
+public:
+    template <typename Fn>
+    TimerQuery(const Fn& loadExtension)
+        : genQueries(
+              loadExtension({ { "GL_EXT_disjoint_timer_query", "glGenQueriesEXT" },
+                              { "GL_ARB_timer_query", "glGenQueries" } })),
+          deleteQueries(
+              loadExtension({ { "GL_EXT_disjoint_timer_query", "glDeleteQueriesEXT" },
+                              { "GL_ARB_timer_query", "glDeleteQueries" } })),
+          queryCounter(
+              loadExtension({ { "GL_EXT_disjoint_timer_query", "glQueryCounterEXT" },
+                              { "GL_ARB_timer_query", "glQueryCounter" } })),
+          getQueryObjectiv(
+              loadExtension({ { "GL_EXT_disjoint_timer_query", "glGetQueryObjectivEXT" },
+                              { "GL_ARB_timer_query", "glGetQueryObjectiv" } })),
+          getQueryObjectui64v(
+              loadExtension({ { "GL_EXT_disjoint_timer_query", "glGetQueryObjectui64vEXT" },
+                              { "GL_ARB_timer_query", "glGetQueryObjectui64v" } })) {
+    }
+
+    const ExtensionFunction<void(platform::GLsizei n, platform::GLuint* ids)> genQueries;
+
+    const ExtensionFunction<void(platform::GLsizei n, const platform::GLuint* ids)> deleteQueries;
+
+    const ExtensionFunction<void(platform::GLuint id, platform::GLenum target)> queryCounter;
+
+    const ExtensionFunction<void(platform::GLuint id, platform::GLenum pname, platform::GLint* params)>
+        getQueryObjectiv;
+
+    const ExtensionFunction<void(platform::GLuint id, platform::GLenum pname, uint64_t* params)>
+        getQueryObjectui64v;
+
+    // Only GL_EXT_disjoint_timer_query reports when timings got invalidated, e.g. by the GPU
+    // changing its frequency.
+    bool checksDisjoint = false;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -1,12 +1,16 @@
 #include <mbgl/gl/upload_pass.hpp>
+#include <mbgl/gl/buffer_pool.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/enum.hpp>
 #include <mbgl/gl/defines.hpp>
 #include <mbgl/gl/command_encoder.hpp>
+#include <mbgl/gl/stream_buffer.hpp>
 #include <mbgl/gl/vertex_buffer_resource.hpp>
 #include <mbgl/gl/index_buffer_resource.hpp>
 #include <mbgl/gl/texture_resource.hpp>
 
+#include <cassert>
+
 namespace mbgl {
 namespace gl {
 
@@ -16,8 +20,36 @@ UploadPass::UploadPass(gl::CommandEncoder& commandEncoder_, const char* name)
     : commandEncoder(commandEncoder_), debugGroup(commandEncoder.createDebugGroup(name)) {
 }
 
+UploadPass::~UploadPass() {
+    // Flush all streamed vertex data that changed during this pass in a single upload.
+    commandEncoder.context.getStreamBuffer().upload();
+}
+
+gfx::Context& UploadPass::getContext() {
+    return commandEncoder.context;
+}
+
 std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResource(
-    const void* data, std::size_t size, const gfx::BufferUsageType usage) {
+    const void* data, std::size_t size, const gfx::BufferUsageType usage, const std::size_t stride) {
+    if (usage == gfx::BufferUsageType::StreamDraw) {
+        return commandEncoder.context.getStreamBuffer().create(data, size, stride);
+    }
+
+    if (usage == gfx::BufferUsageType::StaticDraw) {
+        auto& pool = commandEncoder.context.getVertexBufferPool();
+        // Aligning to the stride allows addressing the vertices with a vertex offset.
+        if (const auto allocation = pool.allocate(size, stride)) {
+            auto result = std::make_unique<gl::VertexBufferResource>(
+                UniqueBuffer{ BufferID(allocation->page->buffer), { commandEncoder.context } }, 0);
+            result->poolPage = allocation->page;
+            result->poolOffset = allocation->offset;
+            result->poolSize = size;
+            pool.bind(*allocation->page);
+            MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, allocation->offset, size, data));
+            return result;
+        }
+    }
+
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
     commandEncoder.context.renderingStats().numBuffers++;
@@ -33,12 +65,47 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
 void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
                                             const void* data,
                                             std::size_t size) {
-    commandEncoder.context.vertexBuffer = static_cast<gl::VertexBufferResource&>(resource).buffer;
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+    auto& glResource = static_cast<gl::VertexBufferResource&>(resource);
+    if (glResource.streamBuffer) {
+        glResource.streamBuffer->update(glResource, data, size);
+        return;
+    }
+    assert(!glResource.poolPage || size <= glResource.poolSize);
+    commandEncoder.context.vertexBuffer = glResource.buffer;
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, glResource.poolOffset, size, data));
+}
+
+void UploadPass::updateVertexBufferResourceRange(gfx::VertexBufferResource& resource,
+                                                 const std::size_t offset,
+                                                 const void* data,
+                                                 const std::size_t size) {
+    auto& glResource = static_cast<gl::VertexBufferResource&>(resource);
+    if (glResource.streamBuffer) {
+        glResource.streamBuffer->update(glResource, offset, data, size);
+        return;
+    }
+    assert(!glResource.poolPage || offset + size <= glResource.poolSize);
+    commandEncoder.context.vertexBuffer = glResource.buffer;
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, glResource.poolOffset + offset, size, data));
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(
     const void* data, std::size_t size, const gfx::BufferUsageType usage) {
+    if (usage == gfx::BufferUsageType::StaticDraw) {
+        auto& pool = commandEncoder.context.getIndexBufferPool();
+        // Aligning to four bytes allows addressing both 16 and 32 bit indices.
+        if (const auto allocation = pool.allocate(size, sizeof(uint32_t))) {
+            auto result = std::make_unique<gl::IndexBufferResource>(
+                UniqueBuffer{ BufferID(allocation->page->buffer), { commandEncoder.context } }, 0);
+            result->poolPage = allocation->page;
+            result->poolOffset = allocation->offset;
+            result->poolSize = size;
+            pool.bind(*allocation->page);
+            MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, allocation->offset, size, data));
+            return result;
+        }
+    }
+
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
     commandEncoder.context.renderingStats().numBuffers++;
@@ -57,10 +124,11 @@ void UploadPass::updateIndexBufferResource(gfx::IndexBufferResource& resource,
                                            std::size_t size) {
     // Be sure to unbind any existing vertex array object before binding the index buffer
     // so that we don't mess up another VAO
+    auto& glResource = static_cast<gl::IndexBufferResource&>(resource);
+    assert(!glResource.poolPage || size <= glResource.poolSize);
     commandEncoder.context.bindVertexArray = 0;
-    commandEncoder.context.globalVertexArrayState.indexBuffer =
-        static_cast<gl::IndexBufferResource&>(resource).buffer;
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
+    commandEncoder.context.globalVertexArrayState.indexBuffer = glResource.buffer;
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, glResource.poolOffset, size, data));
 }
 
 std::unique_ptr<gfx::TextureResource>
@@ -17,6 +17,9 @@ class Context;
 class UploadPass final : public gfx::UploadPass {
 public:
     UploadPass(gl::CommandEncoder&, const char* name);
+    ~UploadPass() override;
+
+    gfx::Context& getContext() override;
 
 private:
     void pushDebugGroup(const char* name) override;
@@ -25,8 +28,13 @@ private:
 public:
     std::unique_ptr<gfx::VertexBufferResource> createVertexBufferResource(const void* data,
                                                                           std::size_t size,
-                                                                          gfx::BufferUsageType) override;
+                                                                          gfx::BufferUsageType,
+                                                                          std::size_t stride) override;
     void updateVertexBufferResource(gfx::VertexBufferResource&, const void* data, std::size_t size) override;
+    void updateVertexBufferResourceRange(gfx::VertexBufferResource&,
+                                         std::size_t offset,
+                                         const void* data,
+                                         std::size_t size) override;
     std::unique_ptr<gfx::IndexBufferResource> createIndexBufferResource(const void* data,
                                                                         std::size_t size,
                                                                         gfx::BufferUsageType) override;
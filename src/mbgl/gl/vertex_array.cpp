@@ -1,6 +1,8 @@
 #include <mbgl/gl/vertex_array.hpp>
 #include <mbgl/gl/index_buffer_resource.hpp>
+#include <mbgl/gl/buffer_pool.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/gl/stream_buffer.hpp>
 
 namespace mbgl {
 namespace gl {
@@ -18,7 +20,28 @@ void VertexArray::bind(Context& context,
         if (state->bindings.size() <= location) {
             state->bindings.emplace_back(context, AttributeLocation(location));
         }
-        state->bindings[location] = bindings[location];
+        const auto& binding = bindings[location];
+        const auto* resource =
+            binding ? static_cast<const gl::VertexBufferResource*>(binding->vertexBufferResource) : nullptr;
+        if (resource && resource->streamBuffer) {
+            // Streamed vertices live in a slice of the shared stream buffer, which doesn't exist
+            // until some slice has data.
+            if (const auto* streamResource = resource->streamBuffer->getResource()) {
+                gfx::AttributeBinding streamed = *binding;
+                streamed.vertexBufferResource = streamResource;
+                streamed.vertexOffset += static_cast<uint32_t>(resource->streamOffset);
+                state->bindings[location] = streamed;
+            } else {
+                state->bindings[location] = nullopt;
+            }
+        } else if (resource && resource->poolPage) {
+            // Pooled vertices start at an offset into the pool page that is aligned to their stride.
+            gfx::AttributeBinding pooled = *binding;
+            pooled.vertexOffset += static_cast<uint32_t>(resource->poolOffset / binding->vertexStride);
+            state->bindings[location] = pooled;
+        } else {
+            state->bindings[location] = binding;
+        }
     }
 }
 
@@ -1,14 +1,24 @@
+#include <mbgl/gl/buffer_pool.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/gl/stream_buffer.hpp>
 #include <mbgl/gl/vertex_buffer_resource.hpp>
 
 namespace mbgl {
 namespace gl {
 
 VertexBufferResource::~VertexBufferResource() {
+    if (streamBuffer) {
+        streamBuffer->remove(*this);
+        // Streamed resources never allocated a buffer object of their own.
+        buffer.release();
+    } else if (poolPage) {
+        buffer.release();
+        poolPage->pool.free(*poolPage, poolOffset, poolSize);
+    }
     auto& stats = buffer.get_deleter().context.renderingStats();
     stats.memVertexBuffers -= byteSize;
     assert(stats.memVertexBuffers >= 0);
 }
 
 } // namespace gl
-} // namespace mbgl
\ No newline at end of file
+} // namespace mbgl
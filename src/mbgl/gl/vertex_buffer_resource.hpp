@@ -3,9 +3,15 @@
 #include <mbgl/gfx/vertex_buffer.hpp>
 #include <mbgl/gl/object.hpp>
 
+#include <cstdint>
+#include <vector>
+
 namespace mbgl {
 namespace gl {
 
+class StreamBuffer;
+class BufferPoolPage;
+
 class VertexBufferResource : public gfx::VertexBufferResource {
 public:
     VertexBufferResource(UniqueBuffer&& buffer_, int byteSize_) : buffer(std::move(buffer_)), byteSize(byteSize_) {}
@@ -13,6 +19,24 @@ public:
 
     UniqueBuffer buffer;
     int byteSize;
+
+    // Set for streamed vertex buffers, which don't own a buffer object. Their vertices are kept in
+    // client memory and uploaded as a slice of the stream buffer, starting at streamOffset vertices.
+    // The bytes in [streamDirtyBegin, streamDirtyEnd) changed since the last upload.
+    StreamBuffer* streamBuffer = nullptr;
+    std::vector<uint8_t> streamData;
+    std::size_t streamStride = 0;
+    std::size_t streamOffset = 0;
+    std::size_t streamCapacity = 0;
+    std::size_t streamIndex = 0;
+    std::size_t streamDirtyBegin = 0;
+    std::size_t streamDirtyEnd = 0;
+
+    // Set for vertex buffers suballocated from a buffer pool. They share the buffer object of the
+    // pool page without owning it, and their vertices start poolOffset bytes into it.
+    BufferPoolPage* poolPage = nullptr;
+    std::size_t poolOffset = 0;
+    std::size_t poolSize = 0;
 };
 
 } // namespace gl
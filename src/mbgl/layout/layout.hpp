@@ -31,6 +31,10 @@ public:
     };
     
     virtual bool hasDependencies() const = 0;
+
+    // Whether createBucket() may run concurrently with the other layouts of a tile,
+    // i.e. it does not write to the shared feature index.
+    virtual bool canCreateBucketInParallel() const { return false; }
 };
 
 class LayoutParameters {
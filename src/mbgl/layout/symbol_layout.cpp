@@ -349,6 +349,12 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
     const bool isPointPlacement = layout->get<SymbolPlacement>() == SymbolPlacementType::Point;
     const bool textAlongLine = layout->get<TextRotationAlignment>() == AlignmentType::Map && !isPointPlacement;
 
+    // Point labels produce about one symbol instance per feature; reserve up front
+    // instead of growing the vector while laying out.
+    if (isPointPlacement) {
+        symbolInstances.reserve(features.size());
+    }
+
     for (auto it = features.begin(); it != features.end(); ++it) {
         auto& feature = *it;
         if (feature.geometry.empty()) continue;
@@ -965,9 +971,19 @@ size_t SymbolLayout::addSymbol(SymbolBucket::Buffer& buffer,
     const auto& minFontScale = symbol.minFontScale;
 
     if (buffer.segments.empty() ||
-        buffer.segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max() ||
-        std::fabs(buffer.segments.back().sortKey - sortKey) > std::numeric_limits<float>::epsilon()) {
+        buffer.segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
+        buffer.segments.emplace_back(buffer.vertices.elements(), buffer.triangles.elements(), 0ul, 0ul, sortKey);
+    } else if (std::fabs(buffer.segments.back().sortKey - sortKey) > std::numeric_limits<float>::epsilon()) {
+#if defined(MBGL_BATCHED_SYMBOL_SEGMENTS)
+        // A segment that only starts because of a new sort key keeps addressing the vertex range of
+        // the previous one, so that both can still be drawn with a single call when they end up
+        // adjacent in the draw order.
+        const std::size_t vertexOffset = buffer.segments.back().vertexOffset;
+        const std::size_t vertexLengthSoFar = buffer.segments.back().vertexLength;
+        buffer.segments.emplace_back(vertexOffset, buffer.triangles.elements(), vertexLengthSoFar, 0ul, sortKey);
+#else
         buffer.segments.emplace_back(buffer.vertices.elements(), buffer.triangles.elements(), 0ul, 0ul, sortKey);
+#endif
     }
 
     // We're generating triangle fans, so we always start with the first
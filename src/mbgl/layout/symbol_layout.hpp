@@ -45,6 +45,7 @@ public:
 
     bool hasSymbolInstances() const override;
     bool hasDependencies() const override;
+    bool canCreateBucketInParallel() const override { return true; }
 
     std::map<std::string, Immutable<style::LayerProperties>> layerPaintProperties;
 
@@ -9,6 +9,7 @@ namespace attributes {
 
 MBGL_DEFINE_ATTRIBUTE(int16_t, 2, pos);
 MBGL_DEFINE_ATTRIBUTE(int16_t, 2, extrude);
+MBGL_DEFINE_ATTRIBUTE(uint8_t, 2, corner);
 MBGL_DEFINE_ATTRIBUTE(int16_t, 4, pos_offset);
 MBGL_DEFINE_ATTRIBUTE(int16_t, 2, pos_normal);
 MBGL_DEFINE_ATTRIBUTE(float, 3, projected_pos);
@@ -33,11 +34,20 @@ struct data {
 
 // Paint attributes
 
-MBGL_DEFINE_ATTRIBUTE(float, 2, color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, fill_color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, halo_color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, stroke_color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, outline_color);
+// Colors are encoded as two integers below 65536 (see attributeValue(const Color&)). Building with
+// MBGL_PACKED_COLOR_ATTRIBUTES stores them as 16-bit integers instead of floats, which halves their
+// vertex data; the shaders read back the same values either way.
+#if defined(MBGL_PACKED_COLOR_ATTRIBUTES)
+using ColorComponent = uint16_t;
+#else
+using ColorComponent = float;
+#endif
+
+MBGL_DEFINE_ATTRIBUTE(ColorComponent, 2, color);
+MBGL_DEFINE_ATTRIBUTE(ColorComponent, 2, fill_color);
+MBGL_DEFINE_ATTRIBUTE(ColorComponent, 2, halo_color);
+MBGL_DEFINE_ATTRIBUTE(ColorComponent, 2, stroke_color);
+MBGL_DEFINE_ATTRIBUTE(ColorComponent, 2, outline_color);
 MBGL_DEFINE_ATTRIBUTE(float, 1, opacity);
 MBGL_DEFINE_ATTRIBUTE(float, 1, stroke_opacity);
 MBGL_DEFINE_ATTRIBUTE(float, 1, blur);
@@ -10,6 +10,7 @@
 #include <mbgl/renderer/paint_property_binder.hpp>
 #include <mbgl/util/io.hpp>
 
+#include <iterator>
 #include <unordered_map>
 
 namespace mbgl {
@@ -131,7 +132,13 @@ public:
             return;
         }
 
-        for (auto& segment : segments) {
+        for (auto it = segments.begin(); it != segments.end();) {
+            const auto& segment = *it;
+            std::size_t indexLength = segment.indexLength;
+            for (++it; it != segments.end() && canMergeSegments(*std::prev(it), *it); ++it) {
+                indexLength += it->indexLength;
+            }
+
             auto drawScopeIt = segment.drawScopes.find(layerID);
 
             if (drawScopeIt == segment.drawScopes.end()) {
@@ -152,7 +159,7 @@ public:
                 textureBindings,
                 indexBuffer,
                 segment.indexOffset,
-                segment.indexLength);
+                indexLength);
         }
     }
 };
@@ -8,12 +8,17 @@ namespace mbgl {
 
 class ProgramParameters {
 public:
-    ProgramParameters(float pixelRatio, bool overdraw);
+    ProgramParameters(float pixelRatio, bool overdraw, optional<std::string> cacheDir = {});
 
     const std::string& getDefines() const;
 
+    // Returns the path of the program binary cache file for the given program and
+    // additional defines, or nothing if the program binary cache is disabled.
+    optional<std::string> cachePath(const char* name, const std::string& additionalDefines) const;
+
 private:
     std::string defines;
+    optional<std::string> cacheDir;
 };
 
 } // namespace mbgl
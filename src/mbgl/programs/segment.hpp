@@ -3,6 +3,7 @@
 #include <mbgl/gfx/draw_scope.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <map>
 
@@ -50,4 +51,45 @@ public:
 template <class AttributeList>
 using SegmentVector = std::vector<Segment<AttributeList>>;
 
+// Returns true if `next` directly follows `segment` in the index buffer and shares its vertex range,
+// so that both can be drawn with a single draw call.
+template <class AttributeList>
+bool canMergeSegments(const Segment<AttributeList>& segment, const Segment<AttributeList>& next) {
+    return segment.vertexOffset == next.vertexOffset &&
+           segment.indexOffset + segment.indexLength == next.indexOffset;
+}
+
+// Replaces every run of consecutive segments that share a sort key with a single segment, so that
+// the run can be drawn with one draw call. The segment-relative indices are rebased onto the first
+// vertex of their run, which may exceed 16 bits, so they are returned as 32-bit indices. Leaves the
+// segments untouched and returns no indices if no segments can be merged.
+template <class AttributeList>
+std::vector<uint32_t> coalesceSegments(SegmentVector<AttributeList>& segments, const std::vector<uint16_t>& indices) {
+    bool mergeable = false;
+    for (std::size_t i = 1; i < segments.size() && !mergeable; ++i) {
+        mergeable = segments[i - 1].sortKey == segments[i].sortKey;
+    }
+    if (!mergeable) {
+        return {};
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    SegmentVector<AttributeList> coalesced;
+    for (const auto& segment : segments) {
+        if (coalesced.empty() || coalesced.back().sortKey != segment.sortKey) {
+            coalesced.emplace_back(segment.vertexOffset, result.size(), 0, 0, segment.sortKey);
+        }
+        auto& run = coalesced.back();
+        const auto base = static_cast<uint32_t>(segment.vertexOffset - run.vertexOffset);
+        for (std::size_t i = segment.indexOffset; i < segment.indexOffset + segment.indexLength; ++i) {
+            result.push_back(base + indices[i]);
+        }
+        run.vertexLength = segment.vertexOffset + segment.vertexLength - run.vertexOffset;
+        run.indexLength += segment.indexLength;
+    }
+    segments = std::move(coalesced);
+    return result;
+}
+
 } // namespace mbgl
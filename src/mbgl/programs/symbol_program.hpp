@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include <array>
+#include <iterator>
 
 namespace mbgl {
 
@@ -316,6 +317,39 @@ public:
               const AttributeBindings& allAttributeBindings,
               const TextureBindings& textureBindings,
               const std::string& layerID) {
+        draw(context,
+             renderPass,
+             drawMode,
+             depthMode,
+             stencilMode,
+             colorMode,
+             cullFaceMode,
+             indexBuffer,
+             segment,
+             segment.indexLength,
+             uniformValues,
+             allAttributeBindings,
+             textureBindings,
+             layerID);
+    }
+
+    // Draws `indexLength` indices starting at the given segment, which may span the segments that
+    // follow it in the same vertex range (see canMergeSegments()).
+    template <class DrawMode>
+    void draw(gfx::Context& context,
+              gfx::RenderPass& renderPass,
+              const DrawMode& drawMode,
+              const gfx::DepthMode& depthMode,
+              const gfx::StencilMode& stencilMode,
+              const gfx::ColorMode& colorMode,
+              const gfx::CullFaceMode& cullFaceMode,
+              const gfx::IndexBuffer& indexBuffer,
+              const Segment<AttributeList>& segment,
+              const std::size_t indexLength,
+              const UniformValues& uniformValues,
+              const AttributeBindings& allAttributeBindings,
+              const TextureBindings& textureBindings,
+              const std::string& layerID) {
         static_assert(Primitive == gfx::PrimitiveTypeOf<DrawMode>::value, "incompatible draw mode");
 
         if (!program) {
@@ -341,7 +375,7 @@ public:
             textureBindings,
             indexBuffer,
             segment.indexOffset,
-            segment.indexLength);
+            indexLength);
     }
 
     template <class DrawMode>
@@ -364,7 +398,13 @@ public:
             return;
         }
 
-        for (const auto& segment : segments) {
+        for (auto it = segments.begin(); it != segments.end();) {
+            const auto& segment = *it;
+            std::size_t indexLength = segment.indexLength;
+            for (++it; it != segments.end() && canMergeSegments(*std::prev(it), *it); ++it) {
+                indexLength += it->indexLength;
+            }
+
             draw(context,
                  renderPass,
                  drawMode,
@@ -374,6 +414,7 @@ public:
                  cullFaceMode,
                  indexBuffer,
                  segment,
+                 indexLength,
                  uniformValues,
                  allAttributeBindings,
                  textureBindings,
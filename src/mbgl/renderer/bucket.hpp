@@ -20,7 +20,7 @@ using PatternLayerMap = std::map<std::string, PatternDependency>;
 class Placement;
 class TransformState;
 class BucketPlacementData;
-class RenderTile;
+class PlacementTile;
 
 class Bucket {
 public:
@@ -51,6 +51,11 @@ public:
         return 0;
     };
 
+    // Bytes of data-driven paint property attributes this bucket has uploaded.
+    virtual std::size_t getPaintPropertyBytes() const {
+        return 0;
+    }
+
     bool needsUpload() const {
         return hasData() && !uploaded;
     }
@@ -60,13 +65,13 @@ public:
     // Returns a pair, the first element of which is a bucket cross-tile id
     // on success call; `0` otherwise. The second element is `true` if
     // the bucket was originally registered; `false` otherwise.
-    virtual std::pair<uint32_t, bool> registerAtCrossTileIndex(CrossTileSymbolLayerIndex&, const RenderTile&) {
+    virtual std::pair<uint32_t, bool> registerAtCrossTileIndex(CrossTileSymbolLayerIndex&, const PlacementTile&) {
         return std::make_pair(0u, false);
     }
     // Places this bucket to the given placement.
     virtual void place(Placement&, const BucketPlacementData&, std::set<uint32_t>&) {}
     virtual void updateVertices(
-        const Placement&, bool /*updateOpacities*/, const TransformState&, const RenderTile&, std::set<uint32_t>&) {}
+        const Placement&, bool /*updateOpacities*/, const TransformState&, const PlacementTile&, std::set<uint32_t>&) {}
 
 protected:
     Bucket() = default;
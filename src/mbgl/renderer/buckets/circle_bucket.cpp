@@ -24,7 +24,8 @@ CircleBucket::CircleBucket(const std::map<std::string, Immutable<LayerProperties
 CircleBucket::~CircleBucket() = default;
 
 void CircleBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    // Feature state updates only upload the paint property vertices they changed.
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
         indexBuffer = uploadPass.createIndexBuffer(std::move(triangles));
     }
@@ -40,6 +41,10 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t CircleBucket::getPaintPropertyBytes() const {
+    return paintPropertyVertexBytes(paintPropertyBinders);
+}
+
 template <class Property>
 static float get(const CirclePaintProperties::PossiblyEvaluated& evaluated, const std::string& id, const std::map<std::string, CircleProgram::Binders>& paintPropertyBinders) {
     auto it = paintPropertyBinders.find(id);
@@ -4,6 +4,7 @@
 #include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/gfx/context.hpp>
 
 #include <mapbox/earcut.hpp>
 
@@ -124,11 +125,26 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
 }
 
 void FillBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    // Feature state updates only upload the paint property vertices they changed.
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
-        lineIndexBuffer = uploadPass.createIndexBuffer(std::move(lines));
-        triangleIndexBuffer =
-            triangles.empty() ? optional<gfx::IndexBuffer>{} : uploadPass.createIndexBuffer(std::move(triangles));
+
+        // Draw segments split at the 16-bit vertex limit with a single call where possible.
+        std::vector<uint32_t> wideLines;
+        std::vector<uint32_t> wideTriangles;
+        if (uploadPass.getContext().supportsUnsignedIntIndices) {
+            wideLines = coalesceSegments(lineSegments, lines.vector());
+            wideTriangles = coalesceSegments(triangleSegments, triangles.vector());
+        }
+
+        lineIndexBuffer = wideLines.empty() ? uploadPass.createIndexBuffer(std::move(lines))
+                                            : uploadPass.createIndexBuffer(wideLines);
+        if (!wideTriangles.empty()) {
+            triangleIndexBuffer = uploadPass.createIndexBuffer(wideTriangles);
+        } else {
+            triangleIndexBuffer =
+                triangles.empty() ? optional<gfx::IndexBuffer>{} : uploadPass.createIndexBuffer(std::move(triangles));
+        }
     }
 
     for (auto& pair : paintPropertyBinders) {
@@ -142,6 +158,10 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+std::size_t FillBucket::getPaintPropertyBytes() const {
+    return paintPropertyVertexBytes(paintPropertyBinders);
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     const auto& evaluated = getEvaluated<FillLayerProperties>(layer.evaluatedProperties);
     const std::array<float, 2>& translate = evaluated.get<FillTranslate>();
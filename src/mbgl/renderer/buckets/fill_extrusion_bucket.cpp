@@ -4,6 +4,7 @@
 #include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/gfx/context.hpp>
 #include <mbgl/util/constants.hpp>
 
 #include <mapbox/earcut.hpp>
@@ -169,9 +170,17 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
 }
 
 void FillExtrusionBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    // Feature state updates only upload the paint property vertices they changed.
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
-        indexBuffer = uploadPass.createIndexBuffer(std::move(triangles));
+
+        // Draw segments split at the 16-bit vertex limit with a single call where possible.
+        std::vector<uint32_t> wideTriangles;
+        if (uploadPass.getContext().supportsUnsignedIntIndices) {
+            wideTriangles = coalesceSegments(triangleSegments, triangles.vector());
+        }
+        indexBuffer = wideTriangles.empty() ? uploadPass.createIndexBuffer(std::move(triangles))
+                                            : uploadPass.createIndexBuffer(wideTriangles);
     }
 
     for (auto& pair : paintPropertyBinders) {
@@ -185,6 +194,10 @@ bool FillExtrusionBucket::hasData() const {
     return !triangleSegments.empty();
 }
 
+std::size_t FillExtrusionBucket::getPaintPropertyBytes() const {
+    return paintPropertyVertexBytes(paintPropertyBinders);
+}
+
 float FillExtrusionBucket::getQueryRadius(const RenderLayer& layer) const {
     const auto& evaluated = getEvaluated<FillExtrusionLayerProperties>(layer.evaluatedProperties);
     const std::array<float, 2>& translate = evaluated.get<FillExtrusionTranslate>();
@@ -37,6 +37,8 @@ public:
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    std::size_t getPaintPropertyBytes() const override;
+
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
     gfx::VertexVector<FillExtrusionLayoutVertex> vertices;
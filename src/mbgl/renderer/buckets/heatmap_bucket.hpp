@@ -30,6 +30,8 @@ public:
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    std::size_t getPaintPropertyBytes() const override;
+
     gfx::VertexVector<HeatmapLayoutVertex> vertices;
     gfx::IndexVector<gfx::Triangles> triangles;
     SegmentVector<HeatmapAttributes> segments;
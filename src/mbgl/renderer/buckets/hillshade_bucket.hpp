@@ -44,6 +44,11 @@ public:
         prepared = preparedState;
     }
 
+    // Uploads the DEM texture again on the next upload pass, e.g. after its border was backfilled.
+    void setDEMDataChanged() {
+        uploaded = false;
+    }
+
     // Raster-DEM Tile Sources use the default buffers from Painter
     gfx::VertexVector<HillshadeLayoutVertex> vertices;
     gfx::IndexVector<gfx::Triangles> indices;
@@ -2,6 +2,7 @@
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/style/layers/line_layer_impl.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/gfx/context.hpp>
 #include <mbgl/util/constants.hpp>
 
 #include <cassert>
@@ -520,9 +521,17 @@ void LineBucket::addPieSliceVertex(const GeometryCoordinate& currentVertex,
 }
 
 void LineBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    // Feature state updates only upload the paint property vertices they changed.
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
-        indexBuffer = uploadPass.createIndexBuffer(std::move(triangles));
+
+        // Draw segments split at the 16-bit vertex limit with a single call where possible.
+        std::vector<uint32_t> wideTriangles;
+        if (uploadPass.getContext().supportsUnsignedIntIndices) {
+            wideTriangles = coalesceSegments(segments, triangles.vector());
+        }
+        indexBuffer = wideTriangles.empty() ? uploadPass.createIndexBuffer(std::move(triangles))
+                                            : uploadPass.createIndexBuffer(wideTriangles);
     }
 
     for (auto& pair : paintPropertyBinders) {
@@ -536,6 +545,10 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t LineBucket::getPaintPropertyBytes() const {
+    return paintPropertyVertexBytes(paintPropertyBinders);
+}
+
 template <class Property>
 static float get(const LinePaintProperties::PossiblyEvaluated& evaluated, const std::string& id, const std::map<std::string, LineProgram::Binders>& paintPropertyBinders) {
     auto it = paintPropertyBinders.find(id);
@@ -7,10 +7,28 @@ namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+bool isOpaque(const std::shared_ptr<PremultipliedImage>& image) {
+    if (!image || !image->valid()) {
+        return false;
+    }
+    const std::size_t length = image->bytes();
+    for (std::size_t i = 3; i < length; i += 4) {
+        if (image->data[i] != 255) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 RasterBucket::RasterBucket(PremultipliedImage&& image_)
-    : image(std::make_shared<PremultipliedImage>(std::move(image_))) {}
+    : image(std::make_shared<PremultipliedImage>(std::move(image_))), opaque(isOpaque(image)) {}
 
-RasterBucket::RasterBucket(std::shared_ptr<PremultipliedImage> image_) : image(std::move(image_)) {}
+RasterBucket::RasterBucket(std::shared_ptr<PremultipliedImage> image_)
+    : image(std::move(image_)), opaque(isOpaque(image)) {}
 
 RasterBucket::~RasterBucket() = default;
 
@@ -42,10 +60,16 @@ void RasterBucket::clear() {
 
 void RasterBucket::setImage(std::shared_ptr<PremultipliedImage> image_) {
     image = std::move(image_);
+    opaque = isOpaque(image);
     texture = {};
     uploaded = false;
 }
 
+bool RasterBucket::coversTileOpaquely() const {
+    // Masked tiles only paint the parts of the tile that aren't covered by other tiles.
+    return opaque && hasData() && mask == TileMask{ { 0, 0, 0 } };
+}
+
 void RasterBucket::setMask(TileMask&& mask_) {
     if (mask == mask_) {
         return;
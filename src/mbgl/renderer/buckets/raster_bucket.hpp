@@ -25,7 +25,12 @@ public:
     void setImage(std::shared_ptr<PremultipliedImage>);
     void setMask(TileMask&&);
 
+    // Returns true if the bucket paints its whole tile with fully opaque pixels.
+    bool coversTileOpaquely() const;
+
     std::shared_ptr<PremultipliedImage> image;
+    // Whether all pixels of the image are fully opaque.
+    bool opaque = false;
     optional<gfx::Texture> texture;
     TileMask mask{ { 0, 0, 0 } };
 
@@ -178,6 +178,10 @@ bool SymbolBucket::hasData() const {
            hasTextCollisionBoxData() || hasIconCollisionCircleData() || hasTextCollisionCircleData();
 }
 
+std::size_t SymbolBucket::getPaintPropertyBytes() const {
+    return paintPropertyVertexBytes(paintProperties);
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
@@ -311,20 +315,23 @@ bool SymbolBucket::hasFormatSectionOverrides() const {
 }
 
 std::pair<uint32_t, bool> SymbolBucket::registerAtCrossTileIndex(CrossTileSymbolLayerIndex& index,
-                                                                 const RenderTile& renderTile) {
+                                                                 const PlacementTile& renderTile) {
+    std::lock_guard<std::mutex> lock(placementMutex);
     bool firstTimeAdded = index.addBucket(renderTile.getOverscaledTileID(), renderTile.matrix, *this);
     return std::make_pair(bucketInstanceId, firstTimeAdded);
 }
 
 void SymbolBucket::place(Placement& placement, const BucketPlacementData& data, std::set<uint32_t>& seenIds) {
+    std::lock_guard<std::mutex> lock(placementMutex);
     placement.placeSymbolBucket(data, seenIds);
 }
 
 void SymbolBucket::updateVertices(const Placement& placement,
                                   bool updateOpacities,
                                   const TransformState& state,
-                                  const RenderTile& tile,
+                                  const PlacementTile& tile,
                                   std::set<uint32_t>& seenIds) {
+    std::lock_guard<std::mutex> lock(placementMutex);
     if (updateOpacities) {
         placement.updateBucketOpacities(*this, state, seenIds);
         placementChangesUploaded = false;
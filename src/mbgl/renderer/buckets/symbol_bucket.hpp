@@ -13,6 +13,7 @@
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/text/placement.hpp>
 
+#include <mutex>
 #include <vector>
 
 namespace mbgl {
@@ -83,10 +84,12 @@ public:
 
     void upload(gfx::UploadPass&) override;
     bool hasData() const override;
-    std::pair<uint32_t, bool> registerAtCrossTileIndex(CrossTileSymbolLayerIndex&, const RenderTile&) override;
+
+    std::size_t getPaintPropertyBytes() const override;
+    std::pair<uint32_t, bool> registerAtCrossTileIndex(CrossTileSymbolLayerIndex&, const PlacementTile&) override;
     void place(Placement&, const BucketPlacementData&, std::set<uint32_t>&) override;
     void updateVertices(
-        const Placement&, bool updateOpacities, const TransformState&, const RenderTile&, std::set<uint32_t>&) override;
+        const Placement&, bool updateOpacities, const TransformState&, const PlacementTile&, std::set<uint32_t>&) override;
     bool hasTextData() const;
     bool hasIconData() const;
     bool hasSdfIconData() const;
@@ -126,6 +129,10 @@ public:
     struct PaintProperties {
         SymbolIconProgram::Binders iconBinders;
         SymbolSDFTextProgram::Binders textBinders;
+
+        std::size_t getVertexBytes() const {
+            return iconBinders.getVertexBytes() + textBinders.getVertexBytes();
+        }
     };
     std::map<std::string, PaintProperties> paintProperties;
 
@@ -198,6 +205,9 @@ public:
     const bool allowVerticalPlacement;
     const std::vector<style::TextWritingModeType> placementModes;
     mutable optional<bool> hasFormatSectionOverrides_;
+    // Held while the symbols are placed, so that an asynchronous placement does not see the
+    // render thread updating the cross-tile ids and the placed symbols of this bucket.
+    std::mutex placementMutex;
 
     FeatureSortOrder featureSortOrder;
 };
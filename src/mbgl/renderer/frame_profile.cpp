@@ -0,0 +1,89 @@
+#include <mbgl/renderer/frame_profile.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+namespace mbgl {
+
+namespace {
+
+using Writer = rapidjson::Writer<rapidjson::StringBuffer>;
+
+double microseconds(const Duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+void writeEvent(Writer& writer, const std::string& name, const int thread, const Duration start, const Duration duration) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(name);
+    writer.Key("ph");
+    writer.String("X");
+    writer.Key("pid");
+    writer.Int(0);
+    writer.Key("tid");
+    writer.Int(thread);
+    writer.Key("ts");
+    writer.Double(microseconds(start));
+    writer.Key("dur");
+    writer.Double(microseconds(duration));
+    writer.EndObject();
+}
+
+void writeThreadName(Writer& writer, const int thread, const char* name) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String("thread_name");
+    writer.Key("ph");
+    writer.String("M");
+    writer.Key("pid");
+    writer.Int(0);
+    writer.Key("tid");
+    writer.Int(thread);
+    writer.Key("args");
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(name);
+    writer.EndObject();
+    writer.EndObject();
+}
+
+} // namespace
+
+std::string toChromeTrace(const std::vector<FrameProfile>& profiles) {
+    constexpr int cpuThread = 0;
+    constexpr int gpuThread = 1;
+
+    rapidjson::StringBuffer s;
+    Writer writer(s);
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+    writeThreadName(writer, cpuThread, "CPU");
+    writeThreadName(writer, gpuThread, "GPU");
+
+    // GPU and CPU clocks aren't synchronized, so GPU work is shown relative to the CPU start of
+    // its frame.
+    const TimePoint origin = profiles.empty() ? TimePoint() : profiles.front().start;
+    for (const auto& profile : profiles) {
+        const Duration frameStart = profile.start - origin;
+        const std::string frameName = "frame " + std::to_string(profile.frame);
+        writeEvent(writer, frameName, cpuThread, frameStart, profile.cpuDuration);
+        if (profile.gpuDuration) {
+            writeEvent(writer, frameName, gpuThread, frameStart, *profile.gpuDuration);
+        }
+        for (const auto& group : profile.groups) {
+            writeEvent(writer, group.name, cpuThread, frameStart + group.cpuStart, group.cpuDuration);
+            if (group.gpuStart && group.gpuDuration) {
+                writeEvent(writer, group.name, gpuThread, frameStart + *group.gpuStart, *group.gpuDuration);
+            }
+        }
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+    return s.GetString();
+}
+
+} // namespace mbgl
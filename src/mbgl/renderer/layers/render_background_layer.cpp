@@ -161,6 +161,11 @@ optional<Color> RenderBackgroundLayer::getSolidBackground() const {
     return { evaluated.get<BackgroundColor>() * evaluated.get<BackgroundOpacity>() };
 }
 
+bool RenderBackgroundLayer::coversViewport() const {
+    const auto color = getSolidBackground();
+    return color && color->a >= 1.0f;
+}
+
 namespace {
 void addPatternIfNeeded(const std::string& id, const LayerPrepareParameters& params) {
     if (!params.patternAtlas.getPattern(id)) {
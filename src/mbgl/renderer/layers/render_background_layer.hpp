@@ -18,6 +18,7 @@ private:
     bool hasTransition() const override;
     bool hasCrossfade() const override;
     optional<Color> getSolidBackground() const override;
+    bool coversViewport() const override;
     void render(PaintParameters&) override;
     void prepare(const LayerPrepareParameters&) override;
 
@@ -18,6 +18,9 @@
 #include <mbgl/util/intersection_tests.hpp>
 #include <mbgl/util/math.hpp>
 
+#include <type_traits>
+#include <vector>
+
 namespace mbgl {
 
 using namespace style;
@@ -76,13 +79,61 @@ void RenderFillLayer::render(PaintParameters& parameters) {
     assert(renderTiles);
     if (unevaluated.get<FillPattern>().isUndefined()) {
         parameters.renderTileClippingMasks(renderTiles);
-        for (const RenderTile& tile : *renderTiles) {
+
+        // The fill and the outline are drawn with the same uniforms and attributes.
+        static_assert(std::is_same<FillProgram::UniformValues, FillOutlineProgram::UniformValues>::value &&
+                          std::is_same<FillProgram::AttributeBindings, FillOutlineProgram::AttributeBindings>::value,
+                      "fill and outline programs must share their bindings");
+        struct TileDraw {
+            const LayerRenderData* renderData = nullptr;
+            optional<FillProgram::UniformValues> uniformValues;
+            optional<FillProgram::AttributeBindings> attributeBindings;
+        };
+
+        const Size renderableSize = parameters.backend.getDefaultRenderable().getSize();
+        std::vector<TileDraw> tileDraws(renderTiles->size());
+        forEachRenderTileConcurrently([&](const std::size_t i) {
+            const RenderTile& tile = (*renderTiles)[i];
             const LayerRenderData* renderData = getRenderDataForPass(tile, parameters.pass);
             if (!renderData) {
-                continue;
+                return;
             }
-            auto& bucket = static_cast<FillBucket&>(*renderData->bucket);
+            const auto& bucket = static_cast<const FillBucket&>(*renderData->bucket);
             const auto& evaluated = getEvaluated<FillLayerProperties>(renderData->layerProperties);
+            const auto& paintPropertyBinders = bucket.paintPropertyBinders.at(getID());
+
+            TileDraw& tileDraw = tileDraws[i];
+            tileDraw.renderData = renderData;
+            tileDraw.uniformValues = FillProgram::computeAllUniformValues(
+                FillProgram::LayoutUniformValues {
+                    uniforms::matrix::Value(
+                        tile.translatedMatrix(evaluated.get<FillTranslate>(),
+                                              evaluated.get<FillTranslateAnchor>(),
+                                              parameters.state)
+                    ),
+                    uniforms::world::Value( renderableSize ),
+                },
+                paintPropertyBinders,
+                evaluated,
+                parameters.state.getZoom()
+            );
+            tileDraw.attributeBindings = FillProgram::computeAllAttributeBindings(
+                *bucket.vertexBuffer,
+                paintPropertyBinders,
+                evaluated
+            );
+        });
+
+        for (std::size_t i = 0; i < tileDraws.size(); ++i) {
+            const TileDraw& tileDraw = tileDraws[i];
+            if (!tileDraw.renderData) {
+                continue;
+            }
+            const RenderTile& tile = (*renderTiles)[i];
+            auto& bucket = static_cast<FillBucket&>(*tileDraw.renderData->bucket);
+            const auto& evaluated = getEvaluated<FillLayerProperties>(tileDraw.renderData->layerProperties);
+
+            checkRenderability(parameters, FillProgram::activeBindingCount(*tileDraw.attributeBindings));
 
             auto draw = [&] (auto& programInstance,
                              const auto& drawMode,
@@ -90,29 +141,6 @@ void RenderFillLayer::render(PaintParameters& parameters) {
                              const auto& indexBuffer,
                              const auto& segments,
                              auto&& textureBindings) {
-                const auto& paintPropertyBinders = bucket.paintPropertyBinders.at(getID());
-
-                const auto allUniformValues = programInstance.computeAllUniformValues(
-                    FillProgram::LayoutUniformValues {
-                        uniforms::matrix::Value(
-                            tile.translatedMatrix(evaluated.get<FillTranslate>(),
-                                                  evaluated.get<FillTranslateAnchor>(),
-                                                  parameters.state)
-                        ),
-                        uniforms::world::Value( parameters.backend.getDefaultRenderable().getSize() ),
-                    },
-                    paintPropertyBinders,
-                    evaluated,
-                    parameters.state.getZoom()
-                );
-                const auto allAttributeBindings = programInstance.computeAllAttributeBindings(
-                    *bucket.vertexBuffer,
-                    paintPropertyBinders,
-                    evaluated
-                );
-
-                checkRenderability(parameters, programInstance.activeBindingCount(allAttributeBindings));
-
                 programInstance.draw(parameters.context,
                                      *parameters.renderPass,
                                      drawMode,
@@ -122,8 +150,8 @@ void RenderFillLayer::render(PaintParameters& parameters) {
                                      gfx::CullFaceMode::disabled(),
                                      indexBuffer,
                                      segments,
-                                     allUniformValues,
-                                     allAttributeBindings,
+                                     *tileDraw.uniformValues,
+                                     *tileDraw.attributeBindings,
                                      std::forward<decltype(textureBindings)>(textureBindings),
                                      getID());
             };
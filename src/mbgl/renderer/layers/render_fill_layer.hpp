@@ -19,6 +19,7 @@ private:
     void evaluate(const PropertyEvaluationParameters&) override;
     bool hasTransition() const override;
     bool hasCrossfade() const override;
+    bool isClippedToTiles() const override { return true; }
     void render(PaintParameters&) override;
 
     bool queryIntersectsFeature(const GeometryCoordinates&,
@@ -17,6 +17,8 @@
 #include <mbgl/util/intersection_tests.hpp>
 #include <mbgl/util/math.hpp>
 
+#include <vector>
+
 namespace mbgl {
 
 using namespace style;
@@ -97,7 +99,43 @@ void RenderLineLayer::render(PaintParameters& parameters) {
 
     parameters.renderTileClippingMasks(renderTiles);
 
-    for (const RenderTile& tile : *renderTiles) {
+    // Most lines have neither a pattern, a gradient nor dashes. The draw parameters of these are
+    // computed for all tiles up front, which happens on worker threads for large tile sets.
+    struct TileDraw {
+        LineProgram::UniformValues uniformValues;
+        LineProgram::AttributeBindings attributeBindings;
+    };
+    std::vector<optional<TileDraw>> plainTileDraws;
+    if (unevaluated.get<LinePattern>().isUndefined() && unevaluated.get<LineGradient>().getValue().isUndefined()) {
+        plainTileDraws.resize(renderTiles->size());
+        forEachRenderTileConcurrently([&](const std::size_t i) {
+            const RenderTile& tile = (*renderTiles)[i];
+            const LayerRenderData* renderData = getRenderDataForPass(tile, parameters.pass);
+            if (!renderData) {
+                return;
+            }
+            const auto& evaluated = getEvaluated<LineLayerProperties>(renderData->layerProperties);
+            if (!evaluated.get<LineDasharray>().from.empty()) {
+                return;
+            }
+            const auto& bucket = static_cast<const LineBucket&>(*renderData->bucket);
+            const auto& paintPropertyBinders = bucket.paintPropertyBinders.at(getID());
+            paintPropertyBinders.setPatternParameters(
+                {}, {}, getCrossfade<LineLayerProperties>(renderData->layerProperties));
+
+            plainTileDraws[i] = TileDraw{
+                LineProgram::computeAllUniformValues(
+                    LineProgram::layoutUniformValues(
+                        evaluated, tile, parameters.state, parameters.pixelsToGLUnits, parameters.pixelRatio),
+                    paintPropertyBinders,
+                    evaluated,
+                    parameters.state.getZoom()),
+                LineProgram::computeAllAttributeBindings(*bucket.vertexBuffer, paintPropertyBinders, evaluated)};
+        });
+    }
+
+    for (std::size_t i = 0; i < renderTiles->size(); ++i) {
+        const RenderTile& tile = (*renderTiles)[i];
         const LayerRenderData* renderData = getRenderDataForPass(tile, parameters.pass);
         if (!renderData) {
             continue;
@@ -142,7 +180,24 @@ void RenderLineLayer::render(PaintParameters& parameters) {
                                  getID());
         };
 
-        if (!evaluated.get<LineDasharray>().from.empty()) {
+        if (i < plainTileDraws.size() && plainTileDraws[i]) {
+            const TileDraw& tileDraw = *plainTileDraws[i];
+            checkRenderability(parameters, LineProgram::activeBindingCount(tileDraw.attributeBindings));
+            parameters.programs.getLineLayerPrograms().line.draw(
+                parameters.context,
+                *parameters.renderPass,
+                gfx::Triangles(),
+                parameters.depthModeForSublayer(0, gfx::DepthMaskType::ReadOnly),
+                parameters.stencilModeForClipping(tile.id),
+                parameters.colorModeForRenderPass(),
+                gfx::CullFaceMode::disabled(),
+                *bucket.indexBuffer,
+                bucket.segments,
+                tileDraw.uniformValues,
+                tileDraw.attributeBindings,
+                LineProgram::TextureBindings{},
+                getID());
+        } else if (!evaluated.get<LineDasharray>().from.empty()) {
             const LinePatternCap cap =
                 bucket.layout.get<LineCap>() == LineCapType::Round ? LinePatternCap::Round : LinePatternCap::Square;
             const auto& dashPatternTexture = parameters.lineAtlas.getDashPatternTexture(
@@ -185,7 +240,8 @@ void RenderLineLayer::render(PaintParameters& parameters) {
                      LinePatternProgram::TextureBindings{
                          textures::image::Value{ tile.getIconAtlasTexture().getResource(), gfx::TextureFilterType::Linear },
                      });
-        } else if (!unevaluated.get<LineGradient>().getValue().isUndefined()) {
+        } else {
+            assert(!unevaluated.get<LineGradient>().getValue().isUndefined());
             assert(colorRampTexture);
 
             draw(parameters.programs.getLineLayerPrograms().lineGradient,
@@ -200,17 +256,6 @@ void RenderLineLayer::render(PaintParameters& parameters) {
                     LineGradientProgram::TextureBindings{
                         textures::image::Value{ colorRampTexture->getResource(), gfx::TextureFilterType::Linear },
                     });
-        } else {
-            draw(parameters.programs.getLineLayerPrograms().line,
-                 LineProgram::layoutUniformValues(
-                     evaluated,
-                     tile,
-                     parameters.state,
-                     parameters.pixelsToGLUnits,
-                     parameters.pixelRatio),
-                 {},
-                 {},
-                 LineProgram::TextureBindings{});
         }
     }
 }
@@ -20,6 +20,7 @@ private:
     void evaluate(const PropertyEvaluationParameters&) override;
     bool hasTransition() const override;
     bool hasCrossfade() const override;
+    bool isClippedToTiles() const override { return true; }
     void prepare(const LayerPrepareParameters&) override;
     void upload(gfx::UploadPass&) override;
     void render(PaintParameters&) override;
@@ -85,6 +85,19 @@ void RenderRasterLayer::prepare(const LayerPrepareParameters& params) {
     assert(renderTiles || imageData || !params.source->isEnabled());
 }
 
+void RenderRasterLayer::addOpaqueTiles(std::vector<UnwrappedTileID>& opaqueTiles) const {
+    const auto& evaluated = static_cast<const RasterLayerProperties&>(*evaluatedProperties).evaluated;
+    if (imageData || !renderTiles || evaluated.get<RasterOpacity>() < 1.0f) {
+        return;
+    }
+    for (const RenderTile& tile : *renderTiles) {
+        const auto* bucket = static_cast<const RasterBucket*>(tile.getBucket(*baseImpl));
+        if (bucket && bucket->coversTileOpaquely()) {
+            opaqueTiles.push_back(tile.id);
+        }
+    }
+}
+
 void RenderRasterLayer::render(PaintParameters& parameters) {
     if (parameters.pass != RenderPass::Translucent || (!renderTiles && !imageData)) {
         return;
@@ -20,6 +20,8 @@ private:
     bool hasCrossfade() const override;
     void prepare(const LayerPrepareParameters&) override;
     void render(PaintParameters&) override;
+    void addOpaqueTiles(std::vector<UnwrappedTileID>&) const override;
+    bool isClippedToTiles() const override { return true; }
 
     // Paint properties
     style::RasterPaintProperties::Unevaluated unevaluated;
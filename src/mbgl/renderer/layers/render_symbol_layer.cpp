@@ -21,6 +21,7 @@
 #include <mbgl/util/math.hpp>
 
 #include <cmath>
+#include <iterator>
 #include <set>
 
 namespace mbgl {
@@ -59,7 +60,14 @@ style::SymbolPropertyValues textPropertyValues(const style::SymbolPaintPropertie
 
 using SegmentWrapper = std::reference_wrapper<Segment<SymbolTextAttributes>>;
 using SegmentVectorWrapper = std::reference_wrapper<SegmentVector<SymbolTextAttributes>>;
-using SegmentsWrapper = variant<SegmentWrapper, SegmentVectorWrapper>;
+
+// A segment, optionally extended by the segments that follow it in the same vertex range.
+struct SegmentRange {
+    SegmentWrapper segment;
+    std::size_t indexLength;
+};
+
+using SegmentsWrapper = variant<SegmentRange, SegmentVectorWrapper>;
 
 struct RenderableSegment {
     RenderableSegment(SegmentWrapper segment_,
@@ -377,7 +385,7 @@ void RenderSymbolLayer::render(PaintParameters& parameters) {
         this->checkRenderability(parameters, programInstance.activeBindingCount(allAttributeBindings));
 
         segments.match(
-            [&](const std::reference_wrapper<Segment<SymbolTextAttributes>>& segment) {
+            [&](const SegmentRange& range) {
                 programInstance.draw(
                     parameters.context,
                     *parameters.renderPass,
@@ -387,7 +395,8 @@ void RenderSymbolLayer::render(PaintParameters& parameters) {
                     parameters.colorModeForRenderPass(),
                     gfx::CullFaceMode::disabled(),
                     *buffers.indexBuffer,
-                    segment,
+                    range.segment.get(),
+                    range.indexLength,
                     allUniformValues,
                     allAttributeBindings,
                     textureBindings,
@@ -534,11 +543,24 @@ void RenderSymbolLayer::render(PaintParameters& parameters) {
     }
 
     if (sortFeaturesByKey) {
-        for (auto& renderable : renderableSegments) {
+        for (auto it = renderableSegments.begin(); it != renderableSegments.end();) {
+            const RenderableSegment& renderable = *it;
+            SegmentRange range{renderable.segment, renderable.segment.get().indexLength};
+
+            // Consecutive renderables of the same bucket and symbol type are batched into a single
+            // draw call as long as their segments follow each other in the buffers.
+            for (++it; it != renderableSegments.end(); ++it) {
+                if (it->type != renderable.type || &it->renderData != &renderable.renderData ||
+                    !canMergeSegments(std::prev(it)->segment.get(), it->segment.get())) {
+                    break;
+                }
+                range.indexLength += it->segment.get().indexLength;
+            }
+
             if (renderable.type == SymbolType::Text) {
-                drawText(draw, renderable.tile, renderable.renderData, renderable.segment, renderable.bucketPaintProperties, parameters);
+                drawText(draw, renderable.tile, renderable.renderData, range, renderable.bucketPaintProperties, parameters);
             } else {
-                drawIcon(draw, renderable.tile, renderable.renderData, renderable.segment, renderable.bucketPaintProperties, parameters, renderable.type == SymbolType::IconSDF);
+                drawIcon(draw, renderable.tile, renderable.renderData, range, renderable.bucketPaintProperties, parameters, renderable.type == SymbolType::IconSDF);
             }
         }
     }
@@ -577,8 +599,10 @@ void RenderSymbolLayer::prepare(const LayerPrepareParameters& params) {
     placementData.clear();
 
     for (const RenderTile& renderTile : *renderTiles) {
-        auto* bucket = static_cast<SymbolBucket*>(renderTile.getBucket(*baseImpl));
-        if (bucket && bucket->bucketLeaderID == getID()) {
+        const LayerRenderData* renderData = renderTile.getLayerRenderData(*baseImpl);
+        if (!renderData || !renderData->bucket) continue;
+        const auto& bucket = static_cast<const SymbolBucket&>(*renderData->bucket);
+        if (bucket.bucketLeaderID == getID()) {
             // Only place this layer if it's the "group leader" for the bucket
             const Tile* tile = params.source->getRenderedTile(renderTile.id);
             assert(tile);
@@ -586,11 +610,21 @@ void RenderSymbolLayer::prepare(const LayerPrepareParameters& params) {
 
             auto featureIndex = static_cast<const GeometryTile*>(tile)->getFeatureIndex();
 
-            if (bucket->sortKeyRanges.empty()) {
-                placementData.push_back({*bucket, renderTile, featureIndex, baseImpl->source, nullopt});
+            if (bucket.sortKeyRanges.empty()) {
+                placementData.push_back({renderData->bucket,
+                                         PlacementTile(renderTile),
+                                         featureIndex,
+                                         baseImpl->source,
+                                         nullopt,
+                                         bucket.justReloaded});
             } else {
-                for (const auto& sortKeyRange : bucket->sortKeyRanges) {
-                    BucketPlacementData layerData{*bucket, renderTile, featureIndex, baseImpl->source, sortKeyRange};
+                for (const auto& sortKeyRange : bucket.sortKeyRanges) {
+                    BucketPlacementData layerData{renderData->bucket,
+                                                  PlacementTile(renderTile),
+                                                  featureIndex,
+                                                  baseImpl->source,
+                                                  sortKeyRange,
+                                                  bucket.justReloaded};
                     auto sortPosition = std::upper_bound(
                         placementData.cbegin(), placementData.cend(), layerData, [](const auto& lhs, const auto& rhs) {
                             assert(lhs.sortKeyRange && rhs.sortKeyRange);
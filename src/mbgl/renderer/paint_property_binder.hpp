@@ -15,7 +15,10 @@
 #include <mbgl/util/indexed_tuple.hpp>
 #include <mbgl/layout/pattern_layout.hpp>
 
+#include <algorithm>
 #include <bitset>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -28,6 +31,64 @@ struct FeatureVertexRange {
 
 using FeatureVertexRangeMap = std::map<std::string, std::vector<FeatureVertexRange>>;
 
+// Vertex ranges [start, end) that changed since the vertex buffer was uploaded.
+using DirtyVertexRanges = std::vector<std::pair<std::size_t, std::size_t>>;
+
+/*
+   Calls fn with the vertex ranges and the new state of every feature whose state changed. A batch
+   of state changes may cover many features that aren't in the tile, so the smaller map is walked.
+*/
+template <class Fn>
+void eachFeatureStateChange(const FeatureVertexRangeMap& featureMap, const FeatureStates& states, Fn&& fn) {
+    if (states.size() <= featureMap.size()) {
+        for (const auto& state : states) {
+            const auto positions = featureMap.find(state.first);
+            if (positions != featureMap.end()) {
+                fn(positions->second, state.second);
+            }
+        }
+    } else {
+        for (const auto& positions : featureMap) {
+            const auto state = states.find(positions.first);
+            if (state != states.end()) {
+                fn(positions.second, state->second);
+            }
+        }
+    }
+}
+
+inline bool isFeatureStateConstant(const style::PropertyExpressionBase& expression) {
+    return style::expression::isGlobalPropertyConstant(expression.getExpression(),
+                                                       std::array<std::string, 1>{{"feature-state"}});
+}
+
+/*
+   Uploads the dirty ranges of a vertex vector to the buffer created from it, instead of uploading
+   the whole vector again. Overlapping and adjacent ranges are merged into a single upload.
+*/
+template <class Vertex>
+void updateVertexBufferRanges(gfx::UploadPass& uploadPass,
+                              gfx::VertexBuffer<Vertex>& buffer,
+                              const gfx::VertexVector<Vertex>& vertices,
+                              DirtyVertexRanges& ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    for (auto it = ranges.begin(); it != ranges.end();) {
+        const std::size_t start = it->first;
+        std::size_t end = it->second;
+        for (++it; it != ranges.end() && it->first <= end; ++it) {
+            end = std::max(end, it->second);
+        }
+        uploadPass.updateVertexBuffer(buffer, start, vertices.data() + start, end - start);
+    }
+    ranges.clear();
+}
+
+// Size in bytes of the vertex data uploaded to a paint attribute buffer.
+template <class Vertex>
+std::size_t vertexBufferBytes(const optional<gfx::VertexBuffer<Vertex>>& buffer) {
+    return buffer ? buffer->elements * sizeof(Vertex) : 0;
+}
+
 /*
    ZoomInterpolatedAttribute<Attr> is a 'compound' attribute, representing two values of the
    the base attribute Attr.  These two values are provided to the shader to allow interpolation
@@ -52,22 +113,23 @@ inline uint16_t packUint8Pair(T a, T b) {
 }
 
 /*
-    Encode a four-component color value into a pair of floats.  Since csscolorparser
-    uses 8-bit precision for each color component, for each float we use the upper 8
-    bits for one component (e.g. (color.r * 255) * 256), and the lower 8 for another.
+    Encode a four-component color value into a pair of floats, or of 16-bit integers when
+    color attributes are packed.  Since csscolorparser uses 8-bit precision for each color
+    component, for each value we use the upper 8 bits for one component (e.g. (color.r * 255) * 256),
+    and the lower 8 for another.
     
     Also note that colors come in as floats 0..1, so we scale by 255.
 */
-inline std::array<float, 2> attributeValue(const Color& color) {
+inline std::array<attributes::ColorComponent, 2> attributeValue(const Color& color) {
     return {{
-        static_cast<float>(packUint8Pair(255 * color.r, 255 * color.g)),
-        static_cast<float>(packUint8Pair(255 * color.b, 255 * color.a))
+        static_cast<attributes::ColorComponent>(packUint8Pair(255 * color.r, 255 * color.g)),
+        static_cast<attributes::ColorComponent>(packUint8Pair(255 * color.b, 255 * color.a))
     }};
 }
 
-template <size_t N>
-std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>& min, const std::array<float, N>& max) {
-    std::array<float, N*2> result;
+template <typename T, size_t N>
+std::array<T, N*2> zoomInterpolatedAttributeValue(const std::array<T, N>& min, const std::array<T, N>& max) {
+    std::array<T, N*2> result;
     for (size_t i = 0; i < N; i++) {
         result[i]   = min[i];
         result[i+N] = max[i];
@@ -123,6 +185,9 @@ public:
     virtual std::tuple<ExpandToType<As, float>...> interpolationFactor(float currentZoom) const = 0;
     virtual std::tuple<ExpandToType<As, UniformValueType>...> uniformValue(const PossiblyEvaluatedType& currentValue) const = 0;
 
+    // Bytes of vertex data this binder has uploaded; constant binders don't upload any.
+    virtual std::size_t getVertexBytes() const { return 0; }
+
     static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedType& value, float zoom, T defaultValue);
 
     PaintPropertyStatistics<T> statistics;
@@ -215,7 +280,8 @@ public:
 
     SourceFunctionPaintPropertyBinder(style::PropertyExpression<T> expression_, T defaultValue_)
         : expression(std::move(expression_)),
-          defaultValue(std::move(defaultValue_)) {
+          defaultValue(std::move(defaultValue_)),
+          featureStateConstant(isFeatureStateConstant(expression)) {
     }
     void setPatternParameters(const optional<ImagePosition>&, const optional<ImagePosition>&, const CrossfadeParameters&) override {};
     void populateVertexVector(const GeometryTileFeature& feature,
@@ -243,19 +309,17 @@ public:
 
     void updateVertexVectors(const FeatureStates& states, const GeometryTileLayer& layer,
                              const ImagePositions&) override {
-        for (const auto& it : states) {
-            const auto positions = featureMap.find(it.first);
-            if (positions == featureMap.end()) {
-                continue;
-            }
-
-            for (const auto& pos : positions->second) {
+        if (featureStateConstant) {
+            return;
+        }
+        eachFeatureStateChange(featureMap, states, [&](const auto& positions, const FeatureState& state) {
+            for (const auto& pos : positions) {
                 std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(pos.featureIndex);
                 if (feature) {
-                    updateVertexVector(pos.start, pos.end, *feature, it.second);
+                    updateVertexVector(pos.start, pos.end, *feature, state);
                 }
             }
-        }
+        });
     }
 
     void updateVertexVector(std::size_t start, std::size_t end, const GeometryTileFeature& feature,
@@ -268,10 +332,21 @@ public:
         for (std::size_t i = start; i < end; ++i) {
             vertexVector.at(i) = BaseVertex{value};
         }
+        dirtyRanges.emplace_back(start, end);
     }
 
     void upload(gfx::UploadPass& uploadPass) override {
-        vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+        // Feature state changes only patch the vertices of the features they changed.
+        if (vertexBuffer && vertexBuffer->elements == vertexVector.elements()) {
+            updateVertexBufferRanges(uploadPass, *vertexBuffer, vertexVector, dirtyRanges);
+        } else {
+            vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+            dirtyRanges.clear();
+        }
+    }
+
+    std::size_t getVertexBytes() const override {
+        return vertexBufferBytes(vertexBuffer);
     }
 
     std::tuple<optional<gfx::AttributeBinding>> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
@@ -303,6 +378,9 @@ private:
     gfx::VertexVector<BaseVertex> vertexVector;
     optional<gfx::VertexBuffer<BaseVertex>> vertexBuffer;
     FeatureVertexRangeMap featureMap;
+    DirtyVertexRanges dirtyRanges;
+    // Feature state changes don't affect properties that don't use feature-state.
+    const bool featureStateConstant;
 };
 
 template <class T, class A>
@@ -316,7 +394,8 @@ public:
     CompositeFunctionPaintPropertyBinder(style::PropertyExpression<T> expression_, float zoom, T defaultValue_)
         : expression(std::move(expression_)),
           defaultValue(std::move(defaultValue_)),
-          zoomRange({zoom, zoom + 1}) {
+          zoomRange({zoom, zoom + 1}),
+          featureStateConstant(isFeatureStateConstant(expression)) {
     }
     void setPatternParameters(const optional<ImagePosition>&, const optional<ImagePosition>&, const CrossfadeParameters&) override {};
     void populateVertexVector(const GeometryTileFeature& feature,
@@ -354,19 +433,17 @@ public:
 
     void updateVertexVectors(const FeatureStates& states, const GeometryTileLayer& layer,
                              const ImagePositions&) override {
-        for (const auto& it : states) {
-            const auto positions = featureMap.find(it.first);
-            if (positions == featureMap.end()) {
-                continue;
-            }
-
-            for (const auto& pos : positions->second) {
+        if (featureStateConstant) {
+            return;
+        }
+        eachFeatureStateChange(featureMap, states, [&](const auto& positions, const FeatureState& state) {
+            for (const auto& pos : positions) {
                 std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(pos.featureIndex);
                 if (feature) {
-                    updateVertexVector(pos.start, pos.end, *feature, it.second);
+                    updateVertexVector(pos.start, pos.end, *feature, state);
                 }
             }
-        }
+        });
     }
 
     void updateVertexVector(std::size_t start, std::size_t end, const GeometryTileFeature& feature,
@@ -383,10 +460,21 @@ public:
         for (std::size_t i = start; i < end; ++i) {
             vertexVector.at(i) = Vertex{value};
         }
+        dirtyRanges.emplace_back(start, end);
     }
 
     void upload(gfx::UploadPass& uploadPass) override {
-        vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+        // Feature state changes only patch the vertices of the features they changed.
+        if (vertexBuffer && vertexBuffer->elements == vertexVector.elements()) {
+            updateVertexBufferRanges(uploadPass, *vertexBuffer, vertexVector, dirtyRanges);
+        } else {
+            vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+            dirtyRanges.clear();
+        }
+    }
+
+    std::size_t getVertexBytes() const override {
+        return vertexBufferBytes(vertexBuffer);
     }
 
     std::tuple<optional<gfx::AttributeBinding>> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
@@ -422,6 +510,8 @@ private:
     gfx::VertexVector<Vertex> vertexVector;
     optional<gfx::VertexBuffer<Vertex>> vertexBuffer;
     FeatureVertexRangeMap featureMap;
+    DirtyVertexRanges dirtyRanges;
+    const bool featureStateConstant;
 };
 
 template <class T, class A1, class A2>
@@ -494,6 +584,11 @@ public:
         }
     }
 
+    std::size_t getVertexBytes() const override {
+        return vertexBufferBytes(patternToVertexBuffer) + vertexBufferBytes(zoomInVertexBuffer) +
+               vertexBufferBytes(zoomOutVertexBuffer);
+    }
+
     std::tuple<optional<gfx::AttributeBinding>, optional<gfx::AttributeBinding>> attributeBinding(const PossiblyEvaluatedPropertyValue<Faded<T>>& currentValue) const override {
         if (currentValue.isConstant()) {
             return {};
@@ -681,6 +776,15 @@ public:
         );
     }
 
+    // Bytes of data-driven paint attribute data uploaded for these binders.
+    std::size_t getVertexBytes() const {
+        std::size_t bytes = 0;
+        util::ignore({
+            (bytes += binders.template get<Ps>()->getVertexBytes(), 0)...
+        });
+        return bytes;
+    }
+
     template <class P>
     const auto& statistics() const {
         return binders.template get<P>()->statistics;
@@ -690,4 +794,15 @@ private:
     Binders binders;
 };
 
+// Bytes of data-driven paint attribute data uploaded for the binders of every layer in a bucket,
+// which are stored by layer ID.
+template <class BindersByLayer>
+std::size_t paintPropertyVertexBytes(const BindersByLayer& bindersByLayer) {
+    std::size_t bytes = 0;
+    for (const auto& pair : bindersByLayer) {
+        bytes += pair.second.getVertexBytes();
+    }
+    return bytes;
+}
+
 } // namespace mbgl
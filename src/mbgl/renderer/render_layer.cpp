@@ -1,4 +1,6 @@
 #include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
@@ -7,11 +9,22 @@
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel_for.hpp>
+
+#include <algorithm>
 
 namespace mbgl {
 
 using namespace style;
 
+std::size_t RenderLayer::minTilesForConcurrentDraws = 32;
+
+PlacementTile::PlacementTile(const RenderTile& renderTile)
+    : id(renderTile.id),
+      matrix(renderTile.matrix),
+      overscaledID(renderTile.getOverscaledTileID()),
+      heldForFade(renderTile.holdForFade()) {}
+
 RenderLayer::RenderLayer(Immutable<style::LayerProperties> properties)
     : evaluatedProperties(std::move(properties)),
       baseImpl(evaluatedProperties->baseImpl) {
@@ -52,10 +65,56 @@ void RenderLayer::prepare(const LayerPrepareParameters& params) {
     addRenderPassesFromTiles();
 }
 
+bool RenderLayer::prepareIfNeeded(const LayerPrepareParameters& params) {
+    const uint64_t sourceRevision = params.source ? params.source->getPrepareRevision() : 0;
+    if (prepared && preparedSource == params.source && preparedSourceRevision == sourceRevision) {
+        return false;
+    }
+    prepare(params);
+    prepared = true;
+    preparedSource = params.source;
+    preparedSourceRevision = sourceRevision;
+    return true;
+}
+
 optional<Color> RenderLayer::getSolidBackground() const {
     return nullopt;
 }
 
+void RenderLayer::uploadBuckets(gfx::UploadPass& uploadPass) {
+    if (!renderTiles) {
+        return;
+    }
+    for (const RenderTile& tile : *renderTiles) {
+        Bucket* bucket = tile.getBucket(*baseImpl);
+        if (bucket && bucket->needsUpload()) {
+            bucket->upload(uploadPass);
+        }
+    }
+}
+
+void RenderLayer::removeOccludedTiles(const std::vector<UnwrappedTileID>& opaqueTiles) {
+    if (!renderTiles || opaqueTiles.empty() || !isClippedToTiles()) {
+        return;
+    }
+
+    auto visibleTiles = std::make_shared<std::vector<std::reference_wrapper<const RenderTile>>>();
+    visibleTiles->reserve(renderTiles->size());
+    for (const RenderTile& tile : *renderTiles) {
+        const bool occluded = std::any_of(opaqueTiles.begin(), opaqueTiles.end(), [&](const UnwrappedTileID& id) {
+            return tile.id == id || tile.id.isChildOf(id);
+        });
+        if (!occluded) {
+            visibleTiles->emplace_back(tile);
+        }
+    }
+    if (visibleTiles->size() != renderTiles->size()) {
+        renderTiles = std::move(visibleTiles);
+        // The tiles may get uncovered in the next frame.
+        prepared = false;
+    }
+}
+
 void RenderLayer::markContextDestroyed() {
     // no-op
 }
@@ -96,6 +155,18 @@ void RenderLayer::addRenderPassesFromTiles() {
     }
 }
 
+void RenderLayer::forEachRenderTileConcurrently(const std::function<void(std::size_t)>& fn) const {
+    assert(renderTiles);
+    if (renderTiles->size() < minTilesForConcurrentDraws) {
+        for (std::size_t i = 0; i < renderTiles->size(); ++i) {
+            fn(i);
+        }
+        return;
+    }
+    std::shared_ptr<Scheduler> scheduler = Scheduler::GetBackground();
+    util::parallelFor(*scheduler, renderTiles->size(), fn);
+}
+
 const LayerRenderData* RenderLayer::getRenderDataForPass(const RenderTile& tile, RenderPass pass) const {
     if (const LayerRenderData* renderData = tile.getLayerRenderData(*baseImpl)) {
         return bool(RenderPass(renderData->layerProperties->renderPasses) & pass) ? renderData : nullptr;
@@ -5,9 +5,12 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/style/layer_properties.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/mat4.hpp>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 
@@ -37,13 +40,32 @@ public:
     size_t end;
 };
 
+// Keeps the render tile properties used by the symbol placement. Unlike `RenderTile`, which
+// is re-created for every frame, it can be retained by an asynchronous placement.
+class PlacementTile {
+public:
+    explicit PlacementTile(const RenderTile&);
+
+    const OverscaledTileID& getOverscaledTileID() const { return overscaledID; }
+    bool holdForFade() const { return heldForFade; }
+
+    UnwrappedTileID id;
+    mat4 matrix;
+
+private:
+    OverscaledTileID overscaledID;
+    bool heldForFade;
+};
+
 class BucketPlacementData {
 public:
-    std::reference_wrapper<Bucket> bucket;
-    std::reference_wrapper<const RenderTile> tile;
+    std::shared_ptr<Bucket> bucket;
+    PlacementTile tile;
     std::shared_ptr<FeatureIndex> featureIndex;
     std::string sourceId;
     optional<SortKeyRange> sortKeyRange;
+    // The bucket flag is reset by the render thread, so the placement reads this snapshot.
+    bool justReloaded;
 };
 
 using LayerPlacementData = std::list<BucketPlacementData>;
@@ -97,6 +119,10 @@ public:
     // Checks whether the given zoom is inside this layer zoom range.
     bool supportsZoom(float zoom) const;
 
+    // Uploads the buckets of the tiles this layer renders. Buckets of tiles and layers that were
+    // removed because they are hidden are not uploaded.
+    void uploadBuckets(gfx::UploadPass&);
+
     virtual void upload(gfx::UploadPass&) {}
     virtual void render(PaintParameters&) = 0;
 
@@ -111,6 +137,13 @@ public:
 
     virtual void prepare(const LayerPrepareParameters&);
 
+    // Runs prepare() unless neither the layer nor the render data of its source changed since the
+    // previous call. Returns true if prepare() ran.
+    bool prepareIfNeeded(const LayerPrepareParameters&);
+
+    // Makes the next prepareIfNeeded() call run prepare(), e.g. after the layer was evaluated.
+    void invalidatePreparation() { prepared = false; }
+
     const LayerPlacementData& getPlacementData() const { return placementData; }
 
     // Latest evaluated properties.
@@ -123,6 +156,21 @@ public:
     // TODO: Only for background layers.
     virtual optional<Color> getSolidBackground() const;
 
+    // Returns true if the layer paints the whole map opaquely, which hides all layers below it.
+    virtual bool coversViewport() const { return false; }
+
+    // Adds the tiles that the layer paints opaquely, which hide the tiles of layers below.
+    virtual void addOpaqueTiles(std::vector<UnwrappedTileID>&) const {}
+
+    // Stops rendering and uploading the tiles hidden behind the given opaque tiles of layers above.
+    // Only affects layers that don't draw outside of their tiles.
+    void removeOccludedTiles(const std::vector<UnwrappedTileID>& opaqueTiles);
+
+    // Layers with at least this many tiles compute their draw parameters on worker threads. Below
+    // that, handing the work to other threads costs more than it saves.
+    // For testing: raising it makes every layer use the serial path.
+    static std::size_t minTilesForConcurrentDraws;
+
 protected:
     // Checks whether the current hardware can render this layer. If it can't, we'll show a warning
     // in the console to inform the developer.
@@ -130,8 +178,15 @@ protected:
 
     void addRenderPassesFromTiles();
 
+    // Returns true if everything the layer draws for a tile stays within the tile's bounds.
+    virtual bool isClippedToTiles() const { return false; }
+
     const LayerRenderData* getRenderDataForPass(const RenderTile&, RenderPass) const;
 
+    // Calls `fn` with the index of every render tile. Large tile sets are spread over worker
+    // threads, so `fn` may only compute draw parameters and must not use the graphics context.
+    void forEachRenderTileConcurrently(const std::function<void(std::size_t)>& fn) const;
+
 protected:
     // Stores current set of tiles to be rendered for this layer.
     RenderTiles renderTiles;
@@ -147,6 +202,10 @@ private:
     // that GPU is exceeded. More attributes are used when adding many data driven paint properties
     // to a layer.
     bool hasRenderFailures = false;
+
+    bool prepared = false;
+    const RenderSource* preparedSource = nullptr;
+    uint64_t preparedSourceRevision = 0;
 };
 
 using RenderLayerReferences = std::vector<std::reference_wrapper<RenderLayer>>;
@@ -1,5 +1,6 @@
 #include <mbgl/renderer/render_orchestrator.hpp>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/layermanager/layer_manager.hpp>
 #include <mbgl/renderer/renderer_observer.hpp>
@@ -50,7 +51,10 @@ public:
 
 private:
     bool hasRenderPass(RenderPass pass) const override { return layer.get().hasRenderPass(pass); }
-    void upload(gfx::UploadPass& pass) const override { layer.get().upload(pass); }
+    void upload(gfx::UploadPass& pass) const override {
+        layer.get().uploadBuckets(pass);
+        layer.get().upload(pass);
+    }
     void render(PaintParameters& parameters) const override { layer.get().render(parameters); }
     const std::string& getName() const override { return layer.get().getID(); }
 };
@@ -101,6 +105,138 @@ public:
     bool updateSymbolOpacities;
 };
 
+// Removes the layers hidden behind a layer that paints the whole map opaquely, and the tiles hidden
+// behind opaque tiles of layers above, so that they are neither uploaded nor rendered.
+void removeOccludedRenderItems(std::set<LayerRenderItem>& layerRenderItems) {
+    std::vector<UnwrappedTileID> opaqueTiles;
+    for (auto it = layerRenderItems.rbegin(); it != layerRenderItems.rend(); ++it) {
+        RenderLayer& layer = it->layer;
+        layer.removeOccludedTiles(opaqueTiles);
+        if (layer.coversViewport()) {
+            layerRenderItems.erase(layerRenderItems.begin(), std::next(it).base());
+            return;
+        }
+        layer.addOpaqueTiles(opaqueTiles);
+    }
+}
+
+std::unordered_map<std::string, const RenderLayer*> getCrossTileSymbolIndexLayers(
+    const std::unordered_map<std::string, const RenderLayer*>& layers) {
+    const auto hasCrossTileIndex = [] (const auto& pair) {
+        return pair.second->baseImpl->getTypeInfo()->crossTileIndex == style::LayerTypeInfo::CrossTileIndex::Required;
+    };
+
+    std::unordered_map<std::string, const RenderLayer*> crossTileSymbolIndexLayers;
+    std::copy_if(layers.begin(),
+                 layers.end(),
+                 std::inserter(crossTileSymbolIndexLayers, crossTileSymbolIndexLayers.begin()),
+                 hasCrossTileIndex);
+    return crossTileSymbolIndexLayers;
+}
+
+// The placed symbols that a query hits, and the query data of the buckets they belong to.
+struct RenderedSymbolQuery {
+    std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> symbols;
+    std::vector<RetainedQueryData> bucketQueryData;
+};
+
+// The bucket query data is copied rather than referenced, as the placement updates the sort order
+// of the bucket features on every frame.
+RenderedSymbolQuery prepareRenderedSymbolQuery(const ScreenLineString& geometry,
+                                               const std::unordered_map<std::string, const RenderLayer*>& layers,
+                                               const Placement& placement) {
+    RenderedSymbolQuery query;
+    if (getCrossTileSymbolIndexLayers(layers).empty()) {
+        return query;
+    }
+    query.symbols = placement.getCollisionIndex().queryRenderedSymbols(geometry);
+    query.bucketQueryData.reserve(query.symbols.size());
+    for (const auto& entry : query.symbols) {
+        query.bucketQueryData.push_back(placement.getQueryData(entry.first));
+    }
+    // Although symbol query is global, symbol results are only sortable within a bucket
+    // For a predictable global sort renderItems, we sort the buckets based on their corresponding tile position
+    std::sort(query.bucketQueryData.begin(),
+              query.bucketQueryData.end(),
+              [](const RetainedQueryData& a, const RetainedQueryData& b) {
+                  return std::tie(a.tileID.canonical.z, a.tileID.canonical.y, a.tileID.wrap, a.tileID.canonical.x) <
+                         std::tie(b.tileID.canonical.z, b.tileID.canonical.y, b.tileID.wrap, b.tileID.canonical.x);
+              });
+    return query;
+}
+
+void queryRenderedSymbols(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
+                          const RenderedSymbolQuery& query,
+                          const std::unordered_map<std::string, const RenderLayer*>& layers,
+                          const RenderedQueryOptions& options) {
+    const auto crossTileSymbolIndexLayers = getCrossTileSymbolIndexLayers(layers);
+    if (crossTileSymbolIndexLayers.empty()) {
+        return;
+    }
+
+    for (const auto& queryData : query.bucketQueryData) {
+        auto bucketSymbols = queryData.featureIndex->lookupSymbolFeatures(query.symbols.at(queryData.bucketInstanceId),
+                                                                          options,
+                                                                          crossTileSymbolIndexLayers,
+                                                                          queryData.tileID,
+                                                                          queryData.featureSortOrder);
+
+        for (auto layer : bucketSymbols) {
+            auto& resultFeatures = resultsByLayer[layer.first];
+            std::move(layer.second.begin(), layer.second.end(), std::inserter(resultFeatures, resultFeatures.end()));
+        }
+    }
+}
+
+// Combines the results of a query in the order of the queried layers.
+std::vector<Feature> combineQueryResults(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
+                                         const std::vector<std::string>& layerIDs) {
+    std::vector<Feature> result;
+    for (const auto& layerID : layerIDs) {
+        auto it = resultsByLayer.find(layerID);
+        if (it != resultsByLayer.end()) {
+            std::move(it->second.begin(), it->second.end(), std::back_inserter(result));
+        }
+    }
+    return result;
+}
+
+// A rendered features query that runs on the background scheduler. It holds everything the query
+// reads, captured on the render thread: the orchestrator keeps updating its own layers, tiles and
+// feature states in between frames, while the feature indexes of the tiles are immutable and only
+// need to be retained.
+class AsyncRenderedQuery {
+public:
+    AsyncRenderedQuery(ScreenLineString geometry_, RenderedQueryOptions options_, const TransformState& transformState_)
+        : geometry(std::move(geometry_)), options(std::move(options_)), transformState(transformState_) {}
+
+    std::vector<Feature> run() const {
+        std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
+        for (const auto& source : sources) {
+            for (const auto& tile : source.tiles) {
+                tile.query(resultsByLayer, transformState, options, layers, *source.featureState);
+            }
+        }
+        queryRenderedSymbols(resultsByLayer, symbols, layers, options);
+        dynamicIndex.query(resultsByLayer, geometry, transformState);
+        return combineQueryResults(resultsByLayer, layerIDs);
+    }
+
+    const ScreenLineString geometry;
+    const RenderedQueryOptions options;
+    const TransformState transformState;
+
+    // Copies of the queried render layers with the properties they were evaluated with. Only the
+    // layers that are backed by source data are copied, as no other layers are read by the query.
+    std::vector<std::unique_ptr<RenderLayer>> renderLayers;
+    std::unordered_map<std::string, const RenderLayer*> layers;
+    std::vector<std::string> layerIDs;
+
+    std::vector<RenderedSourceQuery> sources;
+    RenderedSymbolQuery symbols;
+    DynamicFeatureIndex dynamicIndex;
+};
+
 }  // namespace
 
 RenderOrchestrator::RenderOrchestrator(bool backgroundLayerAsColor_, const optional<std::string>& localFontFamily_)
@@ -137,6 +273,8 @@ void RenderOrchestrator::setObserver(RendererObserver* observer_) {
 
 std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     const std::shared_ptr<UpdateParameters>& updateParameters) {
+    const TimePoint buildStart = Clock::now();
+    RenderTreeStats stats;
     const bool isMapModeContinuous = updateParameters->mode == MapMode::Continuous;
     if (!isMapModeContinuous) {
         // Reset zoom history state.
@@ -260,6 +398,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         if (layerAddedOrChanged || zoomChanged || layer.hasTransition() || layer.hasCrossfade()) {
             auto previousMask = layer.evaluatedProperties->constantsMask();
             layer.evaluate(evaluationParameters);
+            layer.invalidatePreparation();
             if (previousMask != layer.evaluatedProperties->constantsMask()) {
                 constantsMaskChanged.insert(id);
             }
@@ -280,6 +419,11 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         renderSource->setObserver(this);
         renderSources.emplace(entry.first, std::move(renderSource));
     }
+
+    for (const auto& entry : sourceDiff.changed) {
+        renderSources.at(entry.first)->invalidatePreparedData();
+    }
+
     transformState = updateParameters->transformState;
     const bool tiltedView = transformState.getPitch() != 0.0f;
 
@@ -355,22 +499,55 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         return nullptr;
     }
 
+    // The render data prepared for the previous frame is reused, unless the camera, the style images
+    // or the layers and tiles it was created from changed. Sources and layers track the latter.
+    const bool preparedDataStale = !isMapModeContinuous || !imageDiff.added.empty() || !imageDiff.removed.empty() ||
+                                   !imageDiff.changed.empty() ||
+                                   preparedProjMatrix != renderTreeParameters->transformParams.projMatrix;
+    preparedProjMatrix = renderTreeParameters->transformParams.projMatrix;
+    if (preparedDataStale) {
+        for (const auto& entry : renderSources) {
+            entry.second->invalidatePreparedData();
+        }
+        for (RenderLayer& layer : orderedLayers) {
+            layer.invalidatePreparation();
+        }
+    }
+
     // Prepare. Update all matrices and generate data that we should upload to the GPU.
     for (const auto& entry : renderSources) {
-        if (entry.second->isEnabled()) {
-            entry.second->prepare(
-                {renderTreeParameters->transformParams, updateParameters->debugOptions, *imageManager});
+        RenderSource& source = *entry.second;
+        if (source.isEnabled()) {
+            const uint64_t revision = source.getPrepareRevision();
+            source.prepare({renderTreeParameters->transformParams, updateParameters->debugOptions, *imageManager});
+            if (source.getPrepareRevision() != revision) {
+                ++stats.preparedSources;
+            } else {
+                ++stats.reusedSources;
+            }
         }
     }
 
-    auto opaquePassCutOffEstimation = layerRenderItems.size();
     for (auto& renderItem : layerRenderItems) {
         RenderLayer& renderLayer = renderItem.layer;
-        renderLayer.prepare(
-            {renderItem.source, *imageManager, *patternAtlas, *lineAtlas, updateParameters->transformState});
+        if (renderLayer.prepareIfNeeded(
+                {renderItem.source, *imageManager, *patternAtlas, *lineAtlas, updateParameters->transformState})) {
+            ++stats.preparedLayers;
+        } else {
+            ++stats.reusedLayers;
+        }
         if (renderLayer.needsPlacement()) {
             layersNeedPlacement.emplace_back(renderLayer);
         }
+    }
+
+    // Hidden layers still take part in the symbol placement, so that labels don't move around when
+    // the layers covering them change.
+    removeOccludedRenderItems(layerRenderItems);
+
+    auto opaquePassCutOffEstimation = layerRenderItems.size();
+    for (auto& renderItem : layerRenderItems) {
+        RenderLayer& renderLayer = renderItem.layer;
         if (renderTreeParameters->opaquePassCutOff == 0) {
             --opaquePassCutOffEstimation;
             if (renderLayer.is3D()) {
@@ -384,9 +561,10 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     bool symbolBucketsAdded = false;
     std::set<std::string> usedSymbolLayers;
     auto longitude = updateParameters->transformState.getLatLng().longitude();
+    const bool placementPending = placementController.hasPendingPlacement();
     for (auto it = layersNeedPlacement.crbegin(); it != layersNeedPlacement.crend(); ++it) {
         RenderLayer& layer = *it;
-        auto result = crossTileSymbolIndex.addLayer(layer, longitude);
+        auto result = crossTileSymbolIndex.addLayer(layer, longitude, placementPending);
         if (isMapModeContinuous) {
             usedSymbolLayers.insert(layer.getID());
             symbolBucketsAdded = symbolBucketsAdded || (result & CrossTileSymbolIndex::AddLayerResult::BucketsAdded);
@@ -406,14 +584,31 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             placementUpdatePeriodOverride = optional<Duration>(Milliseconds(30));
         }
 
-        renderTreeParameters->placementChanged = !placementController.placementIsRecent(
-            updateParameters->timePoint, updateParameters->transformState.getZoom(), placementUpdatePeriodOverride);
+        if (placementPending) {
+            // Keep rendering with the current placement until the asynchronous one is ready.
+            renderTreeParameters->placementChanged = placementController.commitAsyncPlacement();
+        } else {
+            renderTreeParameters->placementChanged = !placementController.placementIsRecent(
+                updateParameters->timePoint, updateParameters->transformState.getZoom(), placementUpdatePeriodOverride);
+            if (renderTreeParameters->placementChanged) {
+                Mutable<Placement> placement = Placement::create(updateParameters, placementController.getPlacement());
+                crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
+                if (asyncPlacement && Scheduler::GetCurrent()) {
+                    placementController.placeAsync(
+                        std::move(placement), layersNeedPlacement, [this, weak = weakFactory.makeWeakPtr()] {
+                            if (weak) observer->onInvalidate();
+                        });
+                    renderTreeParameters->placementChanged = false;
+                } else {
+                    placement->placeLayers(layersNeedPlacement);
+                    placementController.setPlacement(std::move(placement));
+                }
+            }
+        }
         symbolBucketsChanged |= renderTreeParameters->placementChanged;
+        placementStats = renderTreeParameters->placementChanged ? placementController.getPlacement()->getStats()
+                                                                : PlacementStats();
         if (renderTreeParameters->placementChanged) {
-            Mutable<Placement> placement = Placement::create(updateParameters, placementController.getPlacement());
-            placement->placeLayers(layersNeedPlacement);
-            placementController.setPlacement(std::move(placement));
-            crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
             for (const auto& entry : renderSources) {
                 entry.second->updateFadingTiles();
             }
@@ -423,6 +618,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         renderTreeParameters->symbolFadeChange =
             placementController.getPlacement()->symbolFadeChange(updateParameters->timePoint);
         renderTreeParameters->needsRepaint = hasTransitions(updateParameters->timePoint);
+        // The map is not fully rendered until the pending placement is committed.
+        renderTreeParameters->loaded = renderTreeParameters->loaded && !placementController.hasPendingPlacement();
     } else {
         renderTreeParameters->placementChanged = symbolBucketsChanged = !layersNeedPlacement.empty();
         if (renderTreeParameters->placementChanged) {
@@ -431,6 +628,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             placement->placeLayers(layersNeedPlacement);
             placementController.setPlacement(std::move(placement));
         }
+        placementStats = renderTreeParameters->placementChanged ? placementController.getPlacement()->getStats()
+                                                                : PlacementStats();
         crossTileSymbolIndex.reset();
         renderTreeParameters->symbolFadeChange = 1.0f;
         renderTreeParameters->needsRepaint = false;
@@ -449,6 +648,9 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         }
     }
 
+    stats.buildDuration = Clock::now() - buildStart;
+    observer->onDidBuildRenderTree(stats);
+
     return std::make_unique<RenderTreeImpl>(std::move(renderTreeParameters),
                                             std::move(layerRenderItems),
                                             std::move(sourceRenderItems),
@@ -459,7 +661,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                             symbolBucketsChanged);
 }
 
-std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+std::unordered_map<std::string, const RenderLayer*> RenderOrchestrator::getQueriedLayers(
+    const RenderedQueryOptions& options) const {
     std::unordered_map<std::string, const RenderLayer*> layers;
     if (options.layerIDs) {
         for (const auto& layerID : *options.layerIDs) {
@@ -472,66 +675,68 @@ std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineS
             layers.emplace(entry.second->getID(), entry.second.get());
         }
     }
+    return layers;
+}
 
-    return queryRenderedFeatures(geometry, options, layers);
+std::unordered_map<std::string, const RenderLayer*> RenderOrchestrator::filterQueriedLayers(
+    const std::unordered_map<std::string, const RenderLayer*>& layers) const {
+    std::unordered_map<std::string, const RenderLayer*> filteredLayers;
+    for (const auto& pair : layers) {
+        if (!pair.second->needsRendering() || !pair.second->supportsZoom(zoomHistory.lastZoom)) {
+            continue;
+        }
+        filteredLayers.emplace(pair);
+    }
+    return filteredLayers;
 }
 
-void RenderOrchestrator::queryRenderedSymbols(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
-                                          const ScreenLineString& geometry,
-                                          const std::unordered_map<std::string, const RenderLayer*>& layers,
-                                          const RenderedQueryOptions& options) const {
-    const auto hasCrossTileIndex = [] (const auto& pair) {
-        return pair.second->baseImpl->getTypeInfo()->crossTileIndex == style::LayerTypeInfo::CrossTileIndex::Required;
-    };
+std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    return queryRenderedFeatures(geometry, options, getQueriedLayers(options));
+}
 
-    std::unordered_map<std::string, const RenderLayer*> crossTileSymbolIndexLayers;
-    std::copy_if(layers.begin(),
-                 layers.end(),
-                 std::inserter(crossTileSymbolIndexLayers, crossTileSymbolIndexLayers.begin()),
-                 hasCrossTileIndex);
+void RenderOrchestrator::queryRenderedFeatures(const ScreenLineString& geometry,
+                                               const RenderedQueryOptions& options,
+                                               std::function<void(std::vector<Feature>)> callback) {
+    auto query = std::make_shared<AsyncRenderedQuery>(geometry, options, transformState);
 
-    if (crossTileSymbolIndexLayers.empty()) {
-        return;
-    }
-    const Placement& placement = *placementController.getPlacement();
-    auto renderedSymbols = placement.getCollisionIndex().queryRenderedSymbols(geometry);
-    std::vector<std::reference_wrapper<const RetainedQueryData>> bucketQueryData;
-    bucketQueryData.reserve(renderedSymbols.size());
-    for (const auto& entry : renderedSymbols) {
-        bucketQueryData.emplace_back(placement.getQueryData(entry.first));
+    std::unordered_set<std::string> sourceIDs;
+    const auto filteredLayers = filterQueriedLayers(getQueriedLayers(options));
+    for (const auto& pair : filteredLayers) {
+        const RenderLayer* layer = pair.second;
+        if (layer->baseImpl->getTypeInfo()->source == style::LayerTypeInfo::Source::Required) {
+            auto copy = LayerManager::get()->createRenderLayer(layer->baseImpl);
+            copy->evaluatedProperties = layer->evaluatedProperties;
+            query->layers.emplace(pair.first, copy.get());
+            query->renderLayers.push_back(std::move(copy));
+            sourceIDs.emplace(layer->baseImpl->source);
+        }
+        query->layerIDs.push_back(pair.first);
+        layer->populateDynamicRenderFeatureIndex(query->dynamicIndex);
     }
-    // Although symbol query is global, symbol results are only sortable within a bucket
-    // For a predictable global sort renderItems, we sort the buckets based on their corresponding tile position
-    std::sort(bucketQueryData.begin(), bucketQueryData.end(), [](const RetainedQueryData& a, const RetainedQueryData& b) {
-        return
-            std::tie(a.tileID.canonical.z, a.tileID.canonical.y, a.tileID.wrap, a.tileID.canonical.x) <
-            std::tie(b.tileID.canonical.z, b.tileID.canonical.y, b.tileID.wrap, b.tileID.canonical.x);
-    });
-
-    for (auto wrappedQueryData : bucketQueryData) {
-        auto& queryData = wrappedQueryData.get();
-        auto bucketSymbols = queryData.featureIndex->lookupSymbolFeatures(renderedSymbols[queryData.bucketInstanceId],
-                                                                          options,
-                                                                          crossTileSymbolIndexLayers,
-                                                                          queryData.tileID,
-                                                                          queryData.featureSortOrder);
 
-        for (auto layer : bucketSymbols) {
-            auto& resultFeatures = resultsByLayer[layer.first];
-            std::move(layer.second.begin(), layer.second.end(), std::inserter(resultFeatures, resultFeatures.end()));
+    mat4 projMatrix;
+    transformState.getProjMatrix(projMatrix);
+
+    for (const auto& sourceID : sourceIDs) {
+        if (RenderSource* renderSource = getRenderSource(sourceID)) {
+            query->sources.push_back(
+                renderSource->prepareRenderedQuery(geometry, transformState, filteredLayers, projMatrix));
         }
     }
+
+    query->symbols = prepareRenderedSymbolQuery(geometry, filteredLayers, *placementController.getPlacement());
+
+    if (!threadPool) threadPool = Scheduler::GetBackground();
+    threadPool->scheduleAndReplyValue([query] { return query->run(); }, std::move(callback));
 }
 
 std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options, const std::unordered_map<std::string, const RenderLayer*>& layers) const {
     std::unordered_set<std::string> sourceIDs;
-    std::unordered_map<std::string, const RenderLayer*> filteredLayers;
-    for (const auto& pair : layers) {
-        if (!pair.second->needsRendering() || !pair.second->supportsZoom(zoomHistory.lastZoom)) {
-            continue;
-        }
-        filteredLayers.emplace(pair);
+    std::vector<std::string> layerIDs;
+    const auto filteredLayers = filterQueriedLayers(layers);
+    for (const auto& pair : filteredLayers) {
         sourceIDs.emplace(pair.second->baseImpl->source);
+        layerIDs.push_back(pair.first);
     }
 
     mat4 projMatrix;
@@ -545,7 +750,10 @@ std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineS
         }
     }
 
-    queryRenderedSymbols(resultsByLayer, geometry, filteredLayers, options);
+    queryRenderedSymbols(resultsByLayer,
+                         prepareRenderedSymbolQuery(geometry, filteredLayers, *placementController.getPlacement()),
+                         filteredLayers,
+                         options);
 
     mbgl::DynamicFeatureIndex dynamicIndex;
     for (const auto& pair : filteredLayers) {
@@ -553,21 +761,9 @@ std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineS
         layer->populateDynamicRenderFeatureIndex(dynamicIndex);
     }
     dynamicIndex.query(resultsByLayer, geometry, transformState);
-    std::vector<Feature> result;
-
-    if (resultsByLayer.empty()) {
-        return result;
-    }
 
     // Combine all results based on the style layer renderItems.
-    for (const auto& pair : filteredLayers) {
-        auto it = resultsByLayer.find(pair.second->baseImpl->id);
-        if (it != resultsByLayer.end()) {
-            std::move(it->second.begin(), it->second.end(), std::back_inserter(result));
-        }
-    }
-
-    return result;
+    return combineQueryResults(resultsByLayer, layerIDs);
 }
 
 std::vector<Feature> RenderOrchestrator::queryShapeAnnotations(const ScreenLineString& geometry) const {
@@ -587,10 +783,17 @@ std::vector<Feature> RenderOrchestrator::queryShapeAnnotations(const ScreenLineS
 }
 
 std::vector<Feature> RenderOrchestrator::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options) const {
-    const RenderSource* source = getRenderSource(sourceID);
-    if (!source) return {};
+    std::vector<Feature> result;
+    querySourceFeatures(sourceID, options, [&](Feature feature) { result.push_back(std::move(feature)); });
+    return result;
+}
 
-    return source->querySourceFeatures(options);
+void RenderOrchestrator::querySourceFeatures(const std::string& sourceID,
+                                             const SourceQueryOptions& options,
+                                             const std::function<void(Feature)>& callback) const {
+    if (const RenderSource* source = getRenderSource(sourceID)) {
+        source->querySourceFeatures(options, callback);
+    }
 }
 
 FeatureExtensionValue RenderOrchestrator::queryFeatureExtensions(const std::string& sourceID,
@@ -611,6 +814,14 @@ void RenderOrchestrator::setFeatureState(const std::string& sourceID, const opti
     }
 }
 
+void RenderOrchestrator::setFeatureStates(const std::string& sourceID,
+                                          const optional<std::string>& sourceLayerID,
+                                          const FeatureStates& states) {
+    if (RenderSource* renderSource = getRenderSource(sourceID)) {
+        renderSource->setFeatureStates(sourceLayerID, states);
+    }
+}
+
 void RenderOrchestrator::getFeatureState(FeatureState& state, const std::string& sourceID,
                                          const optional<std::string>& sourceLayerID,
                                          const std::string& featureID) const {
@@ -648,6 +859,10 @@ void RenderOrchestrator::collectPlacedSymbolData(bool enable) {
     placedSymbolDataCollected = enable;
 }
 
+void RenderOrchestrator::enableAsyncPlacement(bool enable) {
+    asyncPlacement = enable;
+}
+
 const std::vector<PlacedSymbolData>& RenderOrchestrator::getPlacedSymbolsData() const {
     return placementController.getPlacement()->getPlacedSymbolsData();
 }
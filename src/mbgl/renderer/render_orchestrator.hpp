@@ -13,6 +13,9 @@
 #include <mbgl/renderer/image_manager_observer.hpp>
 #include <mbgl/text/placement.hpp>
 
+#include <mapbox/std/weak.hpp>
+
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,6 +23,7 @@
 namespace mbgl {
 
 class RendererObserver;
+class Scheduler;
 class RenderSource;
 class UpdateParameters;
 class RenderStaticData;
@@ -52,7 +56,14 @@ public:
     std::unique_ptr<RenderTree> createRenderTree(const std::shared_ptr<UpdateParameters>&);
 
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&) const;
+    // Queries the rendered features on the background scheduler, and calls back on the current one.
+    void queryRenderedFeatures(const ScreenLineString&,
+                               const RenderedQueryOptions&,
+                               std::function<void(std::vector<Feature>)> callback);
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&) const;
+    void querySourceFeatures(const std::string& sourceID,
+                             const SourceQueryOptions&,
+                             const std::function<void(Feature)>& callback) const;
     std::vector<Feature> queryShapeAnnotations(const ScreenLineString&) const;
 
     FeatureExtensionValue queryFeatureExtensions(const std::string& sourceID,
@@ -64,6 +75,10 @@ public:
     void setFeatureState(const std::string& sourceID, const optional<std::string>& layerID,
                          const std::string& featureID, const FeatureState& state);
 
+    void setFeatureStates(const std::string& sourceID,
+                          const optional<std::string>& sourceLayerID,
+                          const FeatureStates& states);
+
     void getFeatureState(FeatureState& state, const std::string& sourceID, const optional<std::string>& layerID,
                          const std::string& featureID) const;
 
@@ -73,7 +88,9 @@ public:
     void reduceMemoryUse();
     void dumpDebugLogs();
     void collectPlacedSymbolData(bool);
+    void enableAsyncPlacement(bool);
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
+    PlacementStats getPlacementStats() const { return placementStats; }
     void clearData();
 
 private:
@@ -85,10 +102,10 @@ private:
           RenderLayer* getRenderLayer(const std::string& id);
     const RenderLayer* getRenderLayer(const std::string& id) const;
               
-    void queryRenderedSymbols(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
-                              const ScreenLineString& geometry,
-                              const std::unordered_map<std::string, const RenderLayer*>& layers,
-                              const RenderedQueryOptions& options) const;
+    std::unordered_map<std::string, const RenderLayer*> getQueriedLayers(const RenderedQueryOptions&) const;
+    // Removes the layers that are not rendered at the current zoom level.
+    std::unordered_map<std::string, const RenderLayer*> filterQueriedLayers(
+        const std::unordered_map<std::string, const RenderLayer*>&) const;
     
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&, const std::unordered_map<std::string, const RenderLayer*>&) const;
 
@@ -107,6 +124,8 @@ private:
 
     ZoomHistory zoomHistory;
     TransformState transformState;
+    // Projection of the previous frame, which the prepared render data of the layers depends on.
+    mat4 preparedProjMatrix{};
 
     std::unique_ptr<GlyphManager> glyphManager;
     std::unique_ptr<ImageManager> imageManager;
@@ -123,16 +142,23 @@ private:
 
     CrossTileSymbolIndex crossTileSymbolIndex;
     PlacementController placementController;
+    // Runs asynchronous feature queries.
+    std::shared_ptr<Scheduler> threadPool;
 
     const bool backgroundLayerAsColor;
     bool contextLost = false;
     bool placedSymbolDataCollected = false;
+    bool asyncPlacement = false;
+    // The placement work done for the last frame.
+    PlacementStats placementStats;
 
     // Vectors with reserved capacity of layerImpls->size() to avoid reallocation
     // on each frame.
     std::vector<Immutable<style::LayerProperties>> filteredLayersForSource;
     RenderLayerReferences orderedLayers;
     RenderLayerReferences layersNeedPlacement;
+
+    mapbox::base::WeakPtrFactory<RenderOrchestrator> weakFactory{this};
 };
 
 } // namespace mbgl
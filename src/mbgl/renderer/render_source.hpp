@@ -1,11 +1,15 @@
 #pragma once
 
+#include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/source_state.hpp>
+#include <mbgl/tile/source_feature_query.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geojson.hpp>
+#include <mbgl/util/immutable.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layer_properties.hpp>
@@ -45,6 +49,13 @@ public:
 
 using RenderTiles = std::shared_ptr<const std::vector<std::reference_wrapper<const RenderTile>>>;
 
+// The rendered tiles of a source to query, along with the feature states at the time the query was made.
+class RenderedSourceQuery {
+public:
+    std::vector<FeatureIndexQuery> tiles;
+    Immutable<SourceFeatureState> featureState = makeMutable<SourceFeatureState>();
+};
+
 class RenderSource : protected TileObserver {
 public:
     static std::unique_ptr<RenderSource> create(const Immutable<style::Source::Impl>&);
@@ -62,6 +73,11 @@ public:
     virtual std::unique_ptr<RenderItem> createRenderItem() = 0;
     // Creates the render data to be passed to the render item.
     virtual void prepare(const SourcePrepareParameters&) = 0;
+    // Incremented by prepare() whenever it re-creates the render data that layers refer to, e.g. the
+    // render tiles. Layers may keep what they derived from render data of the same revision.
+    uint64_t getPrepareRevision() const { return prepareRevision; }
+    // Makes the next prepare() call re-create the render data, e.g. after style images changed.
+    void invalidatePreparedData() { preparedDataValid = false; }
     virtual void updateFadingTiles() = 0;
     virtual bool hasFadingTiles() const = 0;
     // If supported, returns a shared list of RenderTiles, sorted by tile id and excluding tiles hold for fade;
@@ -82,8 +98,16 @@ public:
                           const RenderedQueryOptions& options,
                           const mat4& projMatrix) const = 0;
 
-    virtual std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const = 0;
+    // Captures the state needed to query the rendered features of this source, so that the query
+    // can run off the render thread.
+    virtual RenderedSourceQuery prepareRenderedQuery(const ScreenLineString&,
+                                                     const TransformState&,
+                                                     const std::unordered_map<std::string, const RenderLayer*>&,
+                                                     const mat4&) const {
+        return {};
+    }
+
+    virtual void querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const = 0;
 
     virtual FeatureExtensionValue
     queryFeatureExtensions(const Feature&,
@@ -95,6 +119,8 @@ public:
 
     virtual void setFeatureState(const optional<std::string>&, const std::string&, const FeatureState&) {}
 
+    virtual void setFeatureStates(const optional<std::string>&, const FeatureStates&) {}
+
     virtual void getFeatureState(FeatureState&, const optional<std::string>&, const std::string&) const {}
 
     virtual void removeFeatureState(const optional<std::string>&, const optional<std::string>&,
@@ -116,6 +142,9 @@ protected:
 
     bool enabled = false;
 
+    uint64_t prepareRevision = 0;
+    bool preparedDataValid = false;
+
     void onTileChanged(Tile&) override;
     void onTileError(Tile&, std::exception_ptr) final;
 };
@@ -49,12 +49,14 @@ static gfx::VertexVector<HeatmapTextureLayoutVertex> heatmapTextureVertices() {
     return result;
 }
 
-RenderStaticData::RenderStaticData(gfx::Context& context, float pixelRatio)
-    : programs(context, ProgramParameters{pixelRatio, false}),
+RenderStaticData::RenderStaticData(gfx::Context& context,
+                                   float pixelRatio,
+                                   const optional<std::string>& programCacheDir)
+    : programs(context, ProgramParameters{pixelRatio, false, programCacheDir}),
       clippingMaskSegments(tileTriangleSegments())
 #ifndef NDEBUG
       ,
-      overdrawPrograms(context, ProgramParameters{pixelRatio, true})
+      overdrawPrograms(context, ProgramParameters{pixelRatio, true, programCacheDir})
 #endif
 {
 }
@@ -8,8 +8,11 @@
 
 namespace mbgl {
 
-Renderer::Renderer(gfx::RendererBackend& backend, float pixelRatio_, const optional<std::string>& localFontFamily_)
-    : impl(std::make_unique<Impl>(backend, pixelRatio_, localFontFamily_)) {}
+Renderer::Renderer(gfx::RendererBackend& backend,
+                   float pixelRatio_,
+                   const optional<std::string>& localFontFamily_,
+                   const optional<std::string>& programCacheDir_)
+    : impl(std::make_unique<Impl>(backend, pixelRatio_, localFontFamily_, programCacheDir_)) {}
 
 Renderer::~Renderer() {
     gfx::BackendScope guard { impl->backend };
@@ -54,6 +57,25 @@ std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenBox& box, const
     );
 }
 
+void Renderer::queryRenderedFeatures(const ScreenLineString& geometry,
+                                     const RenderedQueryOptions& options,
+                                     QueryCallback callback) const {
+    impl->orchestrator.queryRenderedFeatures(geometry, options, std::move(callback));
+}
+
+void Renderer::queryRenderedFeatures(const ScreenCoordinate& point,
+                                     const RenderedQueryOptions& options,
+                                     QueryCallback callback) const {
+    impl->orchestrator.queryRenderedFeatures({point}, options, std::move(callback));
+}
+
+void Renderer::queryRenderedFeatures(const ScreenBox& box,
+                                     const RenderedQueryOptions& options,
+                                     QueryCallback callback) const {
+    impl->orchestrator.queryRenderedFeatures(
+        {box.min, {box.max.x, box.min.y}, box.max, {box.min.x, box.max.y}, box.min}, options, std::move(callback));
+}
+
 AnnotationIDs Renderer::queryPointAnnotations(const ScreenBox& box) const {
     if (!LayerManager::annotationsEnabled) {
         return {};
@@ -98,6 +120,12 @@ std::vector<Feature> Renderer::querySourceFeatures(const std::string& sourceID,
     return impl->orchestrator.querySourceFeatures(sourceID, options);
 }
 
+void Renderer::querySourceFeatures(const std::string& sourceID,
+                                   const SourceQueryOptions& options,
+                                   const std::function<void(Feature)>& callback) const {
+    impl->orchestrator.querySourceFeatures(sourceID, options, callback);
+}
+
 FeatureExtensionValue Renderer::queryFeatureExtensions(const std::string& sourceID,
                                                        const Feature& feature,
                                                        const std::string& extension,
@@ -111,6 +139,12 @@ void Renderer::setFeatureState(const std::string& sourceID, const optional<std::
     impl->orchestrator.setFeatureState(sourceID, sourceLayerID, featureID, state);
 }
 
+void Renderer::setFeatureStates(const std::string& sourceID,
+                                const optional<std::string>& sourceLayerID,
+                                const FeatureStates& states) {
+    impl->orchestrator.setFeatureStates(sourceID, sourceLayerID, states);
+}
+
 void Renderer::getFeatureState(FeatureState& state, const std::string& sourceID,
                                const optional<std::string>& sourceLayerID, const std::string& featureID) const {
     impl->orchestrator.getFeatureState(state, sourceID, sourceLayerID, featureID);
@@ -133,6 +167,18 @@ const std::vector<PlacedSymbolData>& Renderer::getPlacedSymbolsData() const {
     return impl->orchestrator.getPlacedSymbolsData();
 }
 
+PlacementStats Renderer::getPlacementStats() const {
+    return impl->orchestrator.getPlacementStats();
+}
+
+void Renderer::enableAsyncPlacement(bool enable) {
+    impl->orchestrator.enableAsyncPlacement(enable);
+}
+
+void Renderer::enableProfiling(bool enable) {
+    impl->profilingEnabled = enable;
+}
+
 void Renderer::reduceMemoryUse() {
     gfx::BackendScope guard { impl->backend };
     impl->reduceMemoryUse();
@@ -24,11 +24,15 @@ static RendererObserver& nullObserver() {
     return observer;
 }
 
-Renderer::Impl::Impl(gfx::RendererBackend& backend_, float pixelRatio_, const optional<std::string>& localFontFamily_)
+Renderer::Impl::Impl(gfx::RendererBackend& backend_,
+                     float pixelRatio_,
+                     const optional<std::string>& localFontFamily_,
+                     const optional<std::string>& programCacheDir_)
     : orchestrator(!backend_.contextIsShared(), localFontFamily_),
       backend(backend_),
       observer(&nullObserver()),
-      pixelRatio(pixelRatio_) {}
+      pixelRatio(pixelRatio_),
+      programCacheDir(programCacheDir_) {}
 
 Renderer::Impl::~Impl() {
     assert(gfx::BackendScope::exists());
@@ -47,11 +51,12 @@ void Renderer::Impl::render(const RenderTree& renderTree) {
     const auto& renderTreeParameters = renderTree.getParameters();
 
     if (!staticData) {
-        staticData = std::make_unique<RenderStaticData>(backend.getContext(), pixelRatio);
+        staticData = std::make_unique<RenderStaticData>(backend.getContext(), pixelRatio, programCacheDir);
     }
     staticData->has3D = renderTreeParameters.has3D;
 
     auto& context = backend.getContext();
+    context.setProfilingEnabled(profilingEnabled);
 
     // Blocks execution until the renderable is available.
     backend.getDefaultRenderable().wait();
@@ -204,6 +209,10 @@ void Renderer::Impl::render(const RenderTree& renderTree) {
     // CommandEncoder destructor submits render commands.
     parameters.encoder.reset();
 
+    for (const auto& profile : context.takeFrameProfiles()) {
+        observer->onDidProfileFrame(profile);
+    }
+
     observer->onDidFinishRenderingFrame(
         renderTreeParameters.loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
         renderTreeParameters.needsRepaint,
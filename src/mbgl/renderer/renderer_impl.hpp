@@ -17,7 +17,10 @@ class RendererBackend;
 
 class Renderer::Impl {
 public:
-    Impl(gfx::RendererBackend&, float pixelRatio_, const optional<std::string>& localFontFamily_);
+    Impl(gfx::RendererBackend&,
+         float pixelRatio_,
+         const optional<std::string>& localFontFamily_,
+         const optional<std::string>& programCacheDir_);
     ~Impl();
 
 private:
@@ -37,8 +40,12 @@ private:
     RendererObserver* observer;
 
     const float pixelRatio;
+    const optional<std::string> programCacheDir;
     std::unique_ptr<RenderStaticData> staticData;
 
+    // Applied to the context at the start of the next frame, when the backend is active.
+    bool profilingEnabled = false;
+
     enum class RenderState {
         Never,
         Partial,
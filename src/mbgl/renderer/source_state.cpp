@@ -3,94 +3,203 @@
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+#include <cassert>
+
 namespace mbgl {
 
+std::size_t SourceFeatureState::LayerStates::intern(const std::string& featureID) {
+    const auto result = featureIndices.emplace(featureID, featureIDs.size());
+    if (result.second) {
+        featureIDs.push_back(featureID);
+        changed.push_back(false);
+    }
+    return result.first->second;
+}
+
+optional<std::size_t> SourceFeatureState::LayerStates::find(const std::string& featureID) const {
+    const auto it = featureIndices.find(featureID);
+    if (it == featureIndices.end()) {
+        return nullopt;
+    }
+    return it->second;
+}
+
+void SourceFeatureState::LayerStates::set(Column& column, const std::size_t feature, const Value& value) {
+    if (column.size() <= feature) {
+        column.resize(featureIDs.size());
+    }
+    column[feature] = value;
+}
+
+FeatureState SourceFeatureState::LayerStates::state(const std::size_t feature) const {
+    FeatureState result;
+    for (const auto& column : current) {
+        if (feature < column.second.size() && column.second[feature]) {
+            result.emplace(column.first, *column.second[feature]);
+        }
+    }
+    return result;
+}
+
+std::vector<bool> SourceFeatureState::LayerStates::featuresWithState() const {
+    std::vector<bool> result(featureIDs.size(), false);
+    for (const auto& column : current) {
+        for (std::size_t feature = 0; feature < column.second.size(); ++feature) {
+            if (column.second[feature]) {
+                result[feature] = true;
+            }
+        }
+    }
+    return result;
+}
+
+void SourceFeatureState::LayerStates::compact() {
+    assert(changedFeatures.empty() && deletedFeatures.empty());
+    const std::vector<bool> live = featuresWithState();
+    if (std::size_t(std::count(live.begin(), live.end(), true)) * 2 > featureIDs.size()) {
+        return;
+    }
+
+    std::size_t next = 0;
+    for (std::size_t feature = 0; feature < featureIDs.size(); ++feature) {
+        if (!live[feature]) {
+            featureIndices.erase(featureIDs[feature]);
+            continue;
+        }
+        if (next != feature) {
+            featureIDs[next] = std::move(featureIDs[feature]);
+            featureIndices[featureIDs[next]] = next;
+            for (auto& column : current) {
+                auto& values = column.second;
+                if (next < values.size()) {
+                    values[next] = feature < values.size() ? std::move(values[feature]) : nullopt;
+                }
+            }
+        }
+        ++next;
+    }
+
+    featureIDs.resize(next);
+    changed.assign(next, false);
+    // The pending changes were all applied, so their columns only hold nullopt.
+    for (auto* columns : { &current, &changes }) {
+        for (auto& column : *columns) {
+            if (column.second.size() > next) {
+                column.second.resize(next);
+            }
+        }
+    }
+}
+
 void SourceFeatureState::updateState(const optional<std::string>& sourceLayerID, const std::string& featureID,
                                      const FeatureState& newState) {
-    std::string sourceLayer = sourceLayerID.value_or(std::string());
-    for (const auto& state : newState) {
-        auto& layerStates = stateChanges[sourceLayer];
-        auto& featureStates = layerStates[featureID];
-        featureStates[state.first] = state.second;
+    updateStates(sourceLayerID, {{featureID, newState}});
+}
+
+void SourceFeatureState::updateStates(const optional<std::string>& sourceLayerID, const FeatureStates& newStates) {
+    auto& layer = layers[sourceLayerID.value_or(std::string())];
+    for (const auto& featureStates : newStates) {
+        if (featureStates.second.empty()) {
+            continue;
+        }
+        const std::size_t feature = layer.intern(featureStates.first);
+        for (const auto& state : featureStates.second) {
+            layer.set(layer.changes[state.first], feature, state.second);
+        }
+        if (!layer.changed[feature]) {
+            layer.changed[feature] = true;
+            layer.changedFeatures.push_back(feature);
+        }
     }
 }
 
 void SourceFeatureState::getState(FeatureState& result, const optional<std::string>& sourceLayerID,
                                   const std::string& featureID) const {
-    std::string sourceLayer = sourceLayerID.value_or(std::string());
-    FeatureState current;
-    FeatureState changes;
-    auto layerStates = currentStates.find(sourceLayer);
-    if (layerStates != currentStates.end()) {
-        const auto currentStateEntry = layerStates->second.find(featureID);
-        if (currentStateEntry != layerStates->second.end()) {
-            current = currentStateEntry->second;
-        }
+    result.clear();
+    const auto layer = layers.find(sourceLayerID.value_or(std::string()));
+    if (layer == layers.end()) {
+        return;
+    }
+    const auto feature = layer->second.find(featureID);
+    if (!feature) {
+        return;
     }
 
-    layerStates = stateChanges.find(sourceLayer);
-    if (layerStates != stateChanges.end()) {
-        const auto stateChangesEntry = layerStates->second.find(featureID);
-        if (stateChangesEntry != layerStates->second.end()) {
-            changes = stateChangesEntry->second;
+    // Changes that were not yet applied take precedence over the current state.
+    for (const auto& column : layer->second.changes) {
+        if (*feature < column.second.size() && column.second[*feature]) {
+            result.emplace(column.first, *column.second[*feature]);
+        }
+    }
+    for (const auto& column : layer->second.current) {
+        if (*feature < column.second.size() && column.second[*feature]) {
+            result.emplace(column.first, *column.second[*feature]);
         }
     }
-    result = std::move(changes);
-    result.insert(current.begin(), current.end());
 }
 
 void SourceFeatureState::coalesceChanges(std::vector<RenderTile>& tiles) {
     LayerFeatureStates changes;
-    for (const auto& layerStatesEntry : stateChanges) {
-        const auto& sourceLayer = layerStatesEntry.first;
-        FeatureStates layerStates;
-        for (const auto& featureStatesEntry : stateChanges[sourceLayer]) {
-            const auto& featureID = featureStatesEntry.first;
-            for (const auto& stateEntry : stateChanges[sourceLayer][featureID]) {
-                const auto& stateKey = stateEntry.first;
-                const auto& stateVal = stateEntry.second;
-
-                auto currentState = currentStates[sourceLayer][featureID].find(stateKey);
-                if (currentState != currentStates[sourceLayer][featureID].end()) {
-                    currentState->second = stateVal;
-                } else {
-                    currentStates[sourceLayer][featureID].insert(std::make_pair(stateKey, stateVal));
+    std::vector<std::size_t> changedFeatures;
+    for (auto& entry : layers) {
+        auto& layer = entry.second;
+        changedFeatures.clear();
+
+        for (const std::size_t feature : layer.changedFeatures) {
+            for (auto& column : layer.changes) {
+                auto& values = column.second;
+                if (feature < values.size() && values[feature]) {
+                    layer.set(layer.current[column.first], feature, *values[feature]);
+                    values[feature] = nullopt;
                 }
             }
-            layerStates[featureID] = currentStates[sourceLayer][featureID];
+            layer.changed[feature] = false;
+            changedFeatures.push_back(feature);
         }
-        changes[sourceLayer] = std::move(layerStates);
-    }
+        layer.changedFeatures.clear();
 
-    for (const auto& layerStatesEntry : deletedStates) {
-        const auto& sourceLayer = layerStatesEntry.first;
-        FeatureStates layerStates = {{}, {}};
-
-        if (deletedStates[sourceLayer].empty()) {
-            for (const auto& featureStatesEntry : currentStates[sourceLayer]) {
-                const auto& featureID = featureStatesEntry.first;
-                layerStates[featureID] = {};
-                currentStates[sourceLayer][featureID] = {};
+        const bool removed = layer.deleteAll || !layer.deletedFeatures.empty();
+        if (layer.deleteAll) {
+            // Only the features that had a state are affected.
+            const std::vector<bool> hadState = layer.featuresWithState();
+            for (std::size_t feature = 0; feature < hadState.size(); ++feature) {
+                if (hadState[feature]) {
+                    changedFeatures.push_back(feature);
+                }
             }
+            layer.current.clear();
         } else {
-            for (const auto& feature : deletedStates[sourceLayer]) {
-                const auto& featureID = feature.first;
-                bool deleteWholeFeatureState = deletedStates[sourceLayer][featureID].empty();
-                if (deleteWholeFeatureState) {
-                    currentStates[sourceLayer][featureID] = {};
-                } else {
-                    for (const auto& stateEntry : deletedStates[sourceLayer][featureID]) {
-                        currentStates[sourceLayer][featureID].erase(stateEntry.first);
+            for (const auto& deleted : layer.deletedFeatures) {
+                const std::size_t feature = deleted.first;
+                for (auto& column : layer.current) {
+                    const auto& keys = deleted.second;
+                    if (feature < column.second.size() &&
+                        (keys.empty() || std::find(keys.begin(), keys.end(), column.first) != keys.end())) {
+                        column.second[feature] = nullopt;
                     }
                 }
-                layerStates[featureID] = currentStates[sourceLayer][featureID];
+                changedFeatures.push_back(feature);
             }
         }
-        changes[sourceLayer] = std::move(layerStates);
-    }
+        layer.deleteAll = false;
+        layer.deletedFeatures.clear();
 
-    stateChanges.clear();
-    deletedStates.clear();
+        if (!changedFeatures.empty()) {
+            auto& layerStates = changes[entry.first];
+            for (const std::size_t feature : changedFeatures) {
+                const auto& featureID = layer.featureIDs[feature];
+                if (layerStates.find(featureID) == layerStates.end()) {
+                    layerStates.emplace(featureID, layer.state(feature));
+                }
+            }
+        }
+
+        // Removing states is the only way features lose their state.
+        if (removed) {
+            layer.compact();
+        }
+    }
 
     if (changes.empty()) {
         return;
@@ -103,30 +212,47 @@ void SourceFeatureState::coalesceChanges(std::vector<RenderTile>& tiles) {
 
 void SourceFeatureState::removeState(const optional<std::string>& sourceLayerID, const optional<std::string>& featureID,
                                      const optional<std::string>& stateKey) {
-    std::string sourceLayer = sourceLayerID.value_or(std::string());
+    auto& layer = layers[sourceLayerID.value_or(std::string())];
+    if (layer.deleteAll) {
+        return;
+    }
 
-    bool sourceLayerDeleted = (deletedStates.count(sourceLayer) > 0) && deletedStates[sourceLayer].empty();
-    if (sourceLayerDeleted) {
+    if (!featureID) {
+        layer.deleteAll = true;
+        layer.deletedFeatures.clear();
         return;
     }
 
-    if (stateKey && featureID) {
-        if ((deletedStates.count(sourceLayer) == 0) && (deletedStates[sourceLayer].count(*featureID)) == 0) {
-            deletedStates[sourceLayer][*featureID][*stateKey] = {};
-        }
-    } else if (featureID) {
-        bool updateInQueue =
-            (stateChanges.count(sourceLayer) != 0U) && (stateChanges[sourceLayer].count(*featureID) != 0U);
-        if (updateInQueue) {
-            for (const auto& changeEntry : stateChanges[sourceLayer][*featureID]) {
-                deletedStates[sourceLayer][*featureID][changeEntry.first] = {};
+    const auto feature = layer.find(*featureID);
+    if (!feature) {
+        return;
+    }
+
+    const auto deleted = layer.deletedFeatures.find(*feature);
+    // The whole state of the feature is already going to be removed.
+    if (deleted != layer.deletedFeatures.end() && deleted->second.empty()) {
+        return;
+    }
+    auto& keys = layer.deletedFeatures[*feature];
+    if (stateKey) {
+        keys.push_back(*stateKey);
+    } else if (layer.changed[*feature]) {
+        // Only removes the keys that were changed since the last update.
+        for (const auto& column : layer.changes) {
+            if (*feature < column.second.size() && column.second[*feature]) {
+                keys.push_back(column.first);
             }
-        } else {
-            deletedStates[sourceLayer][*featureID] = {};
         }
     } else {
-        deletedStates[sourceLayer] = {};
+        keys.clear();
     }
 }
 
+bool SourceFeatureState::hasChanges() const {
+    return std::any_of(layers.begin(), layers.end(), [](const auto& entry) {
+        const auto& layer = entry.second;
+        return !layer.changedFeatures.empty() || !layer.deletedFeatures.empty() || layer.deleteAll;
+    });
+}
+
 } // namespace mbgl
@@ -3,6 +3,10 @@
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/util/feature.hpp>
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace mbgl {
 
 class RenderTile;
@@ -14,16 +18,51 @@ public:
 
     void updateState(const optional<std::string>& sourceLayerID, const std::string& featureID,
                      const FeatureState& newState);
+    // Updates the states of many features of a source layer at once.
+    void updateStates(const optional<std::string>& sourceLayerID, const FeatureStates& newStates);
     void getState(FeatureState& result, const optional<std::string>& sourceLayerID, const std::string& featureID) const;
     void removeState(const optional<std::string>& sourceLayerID, const optional<std::string>& featureID,
                      const optional<std::string>& stateKey);
 
     void coalesceChanges(std::vector<RenderTile>& tiles);
 
+    // Returns true if there are changes that were not yet applied to the tiles.
+    bool hasChanges() const;
+
 private:
-    LayerFeatureStates currentStates;
-    LayerFeatureStates stateChanges;
-    LayerFeatureStates deletedStates;
+    // One value per interned feature; features without a value for the key hold nullopt.
+    using Column = std::vector<optional<Value>>;
+
+    // The states of the features of a source layer. Feature IDs are interned into dense indices,
+    // and each state key is stored as a column indexed by them, so that setting the same key on
+    // many features doesn't allocate a map per feature.
+    struct LayerStates {
+        std::size_t intern(const std::string& featureID);
+        optional<std::size_t> find(const std::string& featureID) const;
+        void set(Column& column, std::size_t feature, const Value&);
+        FeatureState state(std::size_t feature) const;
+        // Returns which features have a value for any state key.
+        std::vector<bool> featuresWithState() const;
+        // Releases the interned IDs of features without state once they make up most of the interned
+        // features. Must only be called when there are no pending changes.
+        void compact();
+
+        std::unordered_map<std::string, std::size_t> featureIndices;
+        std::vector<std::string> featureIDs;
+
+        std::unordered_map<std::string, Column> current;
+        // Changes are applied to the current states when they're coalesced. The columns are kept
+        // allocated in between, and only the entries of the changed features are reset.
+        std::unordered_map<std::string, Column> changes;
+        std::vector<std::size_t> changedFeatures;
+        std::vector<bool> changed;
+
+        // Keys to remove from the states of a feature; an empty list removes the whole state.
+        std::unordered_map<std::size_t, std::vector<std::string>> deletedFeatures;
+        bool deleteAll = false;
+    };
+
+    std::unordered_map<std::string, LayerStates> layers;
 };
 
 } // namespace mbgl
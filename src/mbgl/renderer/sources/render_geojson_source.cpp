@@ -6,6 +6,8 @@
 
 #include <mapbox/eternal.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -89,6 +91,16 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
 
     auto data_ = impl().getData().lock();
     if (data.lock() != data_) {
+        // When only some features were updated, the other tiles keep their features.
+        const auto changedBounds = impl().getChangedBoundsSince(data);
+        const auto tileChanged = [&](const CanonicalTileID& tileID) {
+            const uint16_t buffer = impl().getOptions()->buffer;
+            return !changedBounds ||
+                   std::any_of(changedBounds->begin(), changedBounds->end(), [&](const LatLngBounds& bounds) {
+                       return style::boundsIntersectTile(bounds, tileID, buffer);
+                   });
+        };
+
         data = data_;
         if (parameters.mode != MapMode::Continuous) {
             // Clearing the tile pyramid in order to avoid render tests being flaky.
@@ -97,7 +109,7 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
             tilePyramid.reduceMemoryUse();
             const uint8_t maxZ = impl().getZoomRange().max;
             for (const auto& pair : tilePyramid.getTiles()) {
-                if (pair.first.canonical.z <= maxZ) {
+                if (pair.first.canonical.z <= maxZ && (needsRelayout || tileChanged(pair.first.canonical))) {
                     static_cast<GeoJSONTile*>(pair.second.get())->updateData(data_, needsRelayout);
                 }
             }
@@ -86,6 +86,8 @@ std::unique_ptr<RenderItem> RenderImageSource::createRenderItem() {
 
 void RenderImageSource::prepare(const SourcePrepareParameters& parameters) {
     assert(!renderData);
+    // The render data is handed over to the render item, so it is re-created for every frame.
+    ++prepareRevision;
     if (!isLoaded()) {
         renderData = std::make_unique<ImageSourceRenderData>(bucket, std::vector<mat4>{}, baseImpl->id);
         return;
@@ -111,9 +113,7 @@ RenderImageSource::queryRenderedFeatures(const ScreenLineString&,
     return std::unordered_map<std::string, std::vector<Feature>> {};
 }
 
-std::vector<Feature> RenderImageSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
-}
+void RenderImageSource::querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const {}
 
 void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
                                const std::vector<Immutable<LayerProperties>>&,
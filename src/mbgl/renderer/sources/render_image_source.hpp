@@ -59,7 +59,7 @@ public:
                           const RenderedQueryOptions& options,
                           const mat4& projMatrix) const final;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const final;
+    void querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const final;
 
     void reduceMemoryUse() final {
     }
@@ -116,9 +116,7 @@ RenderRasterDEMSource::queryRenderedFeatures(const ScreenLineString&,
     return std::unordered_map<std::string, std::vector<Feature>>{};
 }
 
-std::vector<Feature> RenderRasterDEMSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
-}
+void RenderRasterDEMSource::querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const {}
 
 
 } // namespace mbgl
@@ -16,8 +16,7 @@ public:
                           const RenderedQueryOptions& options,
                           const mat4& projMatrix) const override;
 
-    std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const override;
+    void querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const override;
 
 private:
     // RenderTileSetSource overrides
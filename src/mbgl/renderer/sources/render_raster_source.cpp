@@ -51,9 +51,7 @@ RenderRasterSource::queryRenderedFeatures(const ScreenLineString&,
     return std::unordered_map<std::string, std::vector<Feature>>{};
 }
 
-std::vector<Feature> RenderRasterSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
-}
+void RenderRasterSource::querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const {}
 
 
 } // namespace mbgl
@@ -19,8 +19,7 @@ private:
                           const RenderedQueryOptions& options,
                           const mat4& projMatrix) const override;
 
-    std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const override;
+    void querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const override;
 
     // RenderTileSetSource overrides
     void updateInternal(const Tileset&,
@@ -1,5 +1,6 @@
 #include <mbgl/renderer/sources/render_tile_source.hpp>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/renderer/buckets/debug_bucket.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/render_tree.hpp>
@@ -9,11 +10,14 @@
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
 namespace mbgl {
 
 using namespace style;
 
+std::size_t RenderTileSource::minTilesForConcurrentPreparation = 32;
+
 class TileSourceRenderItem : public RenderItem {
 public:
     TileSourceRenderItem(Immutable<std::vector<RenderTile>> renderTiles_, std::string name_)
@@ -59,17 +63,82 @@ std::unique_ptr<RenderItem> RenderTileSource::createRenderItem() {
 }
 
 void RenderTileSource::prepare(const SourcePrepareParameters& parameters) {
-    bearing = parameters.transform.state.getBearing();
+    if (renderTilesUpToDate(parameters)) {
+        return;
+    }
+
+    const auto& transform = parameters.transform;
+    bearing = transform.state.getBearing();
+    preparedZoom = transform.state.getZoom();
+    preparedProjMatrix = transform.projMatrix;
+    preparedNearClippedProjMatrix = transform.nearClippedProjMatrix;
+    preparedDebugOptions = parameters.debugOptions;
     filteredRenderTiles = nullptr;
     renderTilesSortedByY = nullptr;
+    preparedTiles.clear();
     auto tiles = makeMutable<std::vector<RenderTile>>();
     tiles->reserve(tilePyramid.getRenderedTiles().size());
     for (auto& entry : tilePyramid.getRenderedTiles()) {
+        const Tile& tile = entry.second;
+        preparedTiles.push_back({&tile, tile.usedByRenderedLayers, tile.holdForFade()});
         tiles->emplace_back(entry.first, entry.second);
-        tiles->back().prepare(parameters);
+    }
+    // Every render tile only touches its own tile, so large pyramids are prepared concurrently.
+    auto prepareTile = [&](const std::size_t i) { (*tiles)[i].prepare(parameters); };
+    if (tiles->size() < minTilesForConcurrentPreparation) {
+        for (std::size_t i = 0; i < tiles->size(); ++i) {
+            prepareTile(i);
+        }
+    } else {
+        std::shared_ptr<Scheduler> scheduler = Scheduler::GetBackground();
+        util::parallelFor(*scheduler, tiles->size(), prepareTile);
+    }
+    if (featureState.hasChanges()) {
+        featureStateSnapshot = nullopt;
     }
     featureState.coalesceChanges(*tiles);
     renderTiles = std::move(tiles);
+    preparedDataValid = true;
+    ++prepareRevision;
+}
+
+bool RenderTileSource::renderTilesUpToDate(const SourcePrepareParameters& parameters) const {
+    // Debug buckets reflect the loading state of the tiles, and feature state changes are applied
+    // while creating the render tiles.
+    if (!preparedDataValid || parameters.debugOptions != MapDebugOptions::NoDebug ||
+        preparedDebugOptions != MapDebugOptions::NoDebug || featureState.hasChanges()) {
+        return false;
+    }
+
+    // The tile matrices depend on the camera.
+    const auto& transform = parameters.transform;
+    if (bearing != transform.state.getBearing() || preparedZoom != transform.state.getZoom() ||
+        preparedProjMatrix != transform.projMatrix ||
+        preparedNearClippedProjMatrix != transform.nearClippedProjMatrix) {
+        return false;
+    }
+
+    const auto& renderedTiles = tilePyramid.getRenderedTiles();
+    if (renderedTiles.size() != preparedTiles.size()) {
+        return false;
+    }
+    std::size_t i = 0;
+    for (const auto& entry : renderedTiles) {
+        const Tile& tile = entry.second;
+        const PreparedTile& prepared = preparedTiles[i];
+        if (entry.first != (*renderTiles)[i].id || &tile != prepared.tile ||
+            tile.usedByRenderedLayers != prepared.usedByRenderedLayers || tile.holdForFade() != prepared.holdForFade) {
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+
+void RenderTileSource::onTileChanged(Tile& tile) {
+    // The render data of the tile has to be re-created.
+    preparedDataValid = false;
+    RenderSource::onTileChanged(tile);
 }
 
 void RenderTileSource::updateFadingTiles() {
@@ -130,15 +199,33 @@ RenderTileSource::queryRenderedFeatures(const ScreenLineString& geometry,
     return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, featureState);
 }
 
-std::vector<Feature> RenderTileSource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+RenderedSourceQuery
+RenderTileSource::prepareRenderedQuery(const ScreenLineString& geometry,
+                                       const TransformState& transformState,
+                                       const std::unordered_map<std::string, const RenderLayer*>& layers,
+                                       const mat4& projMatrix) const {
+    if (!featureStateSnapshot) {
+        featureStateSnapshot = Immutable<SourceFeatureState>(makeMutable<SourceFeatureState>(featureState));
+    }
+    return {tilePyramid.prepareRenderedQuery(geometry, transformState, layers, projMatrix), *featureStateSnapshot};
+}
+
+void RenderTileSource::querySourceFeatures(const SourceQueryOptions& options,
+                                           const SourceFeatureQuery::Callback& callback) const {
+    tilePyramid.querySourceFeatures(options, callback);
 }
 
 void RenderTileSource::setFeatureState(const optional<std::string>& sourceLayerID, const std::string& featureID,
                                        const FeatureState& state) {
+    featureStateSnapshot = nullopt;
     featureState.updateState(sourceLayerID, featureID, state);
 }
 
+void RenderTileSource::setFeatureStates(const optional<std::string>& sourceLayerID, const FeatureStates& states) {
+    featureStateSnapshot = nullopt;
+    featureState.updateStates(sourceLayerID, states);
+}
+
 void RenderTileSource::getFeatureState(FeatureState& state, const optional<std::string>& sourceLayerID,
                                        const std::string& featureID) const {
     featureState.getState(state, sourceLayerID, featureID);
@@ -147,6 +234,7 @@ void RenderTileSource::getFeatureState(FeatureState& state, const optional<std::
 void RenderTileSource::removeFeatureState(const optional<std::string>& sourceLayerID,
                                           const optional<std::string>& featureID,
                                           const optional<std::string>& stateKey) {
+    featureStateSnapshot = nullopt;
     featureState.removeState(sourceLayerID, featureID, stateKey);
 }
 
@@ -32,11 +32,17 @@ public:
                           const RenderedQueryOptions& options,
                           const mat4& projMatrix) const override;
 
-    std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const override;
+    RenderedSourceQuery prepareRenderedQuery(const ScreenLineString& geometry,
+                                             const TransformState& transformState,
+                                             const std::unordered_map<std::string, const RenderLayer*>& layers,
+                                             const mat4& projMatrix) const override;
+
+    void querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const override;
 
     void setFeatureState(const optional<std::string>&, const std::string&, const FeatureState&) override;
 
+    void setFeatureStates(const optional<std::string>&, const FeatureStates&) override;
+
     void getFeatureState(FeatureState& state, const optional<std::string>&, const std::string&) const override;
 
     void removeFeatureState(const optional<std::string>&, const optional<std::string>&,
@@ -45,16 +51,39 @@ public:
     void reduceMemoryUse() override;
     void dumpDebugLogs() const override;
 
+    // Sources with at least this many render tiles prepare them on worker threads.
+    // For testing: raising it makes every source use the serial path.
+    static std::size_t minTilesForConcurrentPreparation;
+
 protected:
     RenderTileSource(Immutable<style::Source::Impl>);
+    void onTileChanged(Tile&) override;
+
     TilePyramid tilePyramid;
     Immutable<std::vector<RenderTile>> renderTiles;
     mutable RenderTiles filteredRenderTiles;
     mutable RenderTiles renderTilesSortedByY;
 
 private:
+    // Returns true if the render tiles of the previous prepare() call are still valid.
+    bool renderTilesUpToDate(const SourcePrepareParameters&) const;
+
+    // The state of a rendered tile that the render tiles were created from.
+    struct PreparedTile {
+        const Tile* tile;
+        bool usedByRenderedLayers;
+        bool holdForFade;
+    };
+
     float bearing = 0.0F;
+    double preparedZoom = 0.0;
+    mat4 preparedProjMatrix;
+    mat4 preparedNearClippedProjMatrix;
+    MapDebugOptions preparedDebugOptions = MapDebugOptions::NoDebug;
+    std::vector<PreparedTile> preparedTiles;
     SourceFeatureState featureState;
+    // A copy of the feature states that is shared by the rendered queries until the states change.
+    mutable optional<Immutable<SourceFeatureState>> featureStateSnapshot;
 };
 
 /**
@@ -307,8 +307,18 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
     const std::unordered_map<std::string, const RenderLayer*>& layers, const RenderedQueryOptions& options,
     const mat4& projMatrix, const SourceFeatureState& featureState) const {
     std::unordered_map<std::string, std::vector<Feature>> result;
+    for (const auto& query : prepareRenderedQuery(geometry, transformState, layers, projMatrix)) {
+        query.query(result, transformState, options, layers, featureState);
+    }
+    return result;
+}
+
+std::vector<FeatureIndexQuery> TilePyramid::prepareRenderedQuery(
+    const ScreenLineString& geometry, const TransformState& transformState,
+    const std::unordered_map<std::string, const RenderLayer*>& layers, const mat4& projMatrix) const {
+    std::vector<FeatureIndexQuery> queries;
     if (renderedTiles.empty() || geometry.empty()) {
-        return result;
+        return queries;
     }
 
     LineString<double> queryGeometry;
@@ -353,21 +363,18 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(id, c));
         }
 
-        tile.queryRenderedFeatures(result, tileSpaceQueryGeometry, transformState, layers, options, projMatrix,
-                                   featureState);
+        tile.prepareRenderedQuery(queries, tileSpaceQueryGeometry, transformState, layers, projMatrix);
     }
 
-    return result;
+    return queries;
 }
 
-std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions& options) const {
-    std::vector<Feature> result;
-
+void TilePyramid::querySourceFeatures(const SourceQueryOptions& options,
+                                      const SourceFeatureQuery::Callback& callback) const {
+    SourceFeatureQuery query(options, callback);
     for (const auto& pair : tiles) {
-        pair.second->querySourceFeatures(result, options);
+        pair.second->querySourceFeatures(query);
     }
-
-    return result;
 }
 
 void TilePyramid::setCacheSize(size_t size) {
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/style/layer_properties.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/types.hpp>
+#include <mbgl/tile/source_feature_query.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/tile/tile_id.hpp>
@@ -55,7 +57,13 @@ public:
         const std::unordered_map<std::string, const RenderLayer*>&, const RenderedQueryOptions& options,
         const mat4& projMatrix, const mbgl::SourceFeatureState& featureState) const;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const;
+    // Prepares the queries of the rendered tiles that the given geometry might intersect.
+    std::vector<FeatureIndexQuery> prepareRenderedQuery(const ScreenLineString& geometry,
+                                                        const TransformState& transformState,
+                                                        const std::unordered_map<std::string, const RenderLayer*>&,
+                                                        const mat4& projMatrix) const;
+
+    void querySourceFeatures(const SourceQueryOptions&, const SourceFeatureQuery::Callback&) const;
 
     void setCacheSize(size_t);
     void reduceMemoryUse();
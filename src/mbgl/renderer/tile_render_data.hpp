@@ -48,12 +48,10 @@ public:
 
 private:
     // TileRenderData overrides.
+    // The bucket is uploaded by the layers rendering it, see RenderLayer::uploadBuckets().
     Bucket* getBucket(const style::Layer::Impl&) const override {
         return bucket ? bucket.get() : nullptr;
     }
-    void upload(gfx::UploadPass& uploadPass) override {
-        if (bucket) bucket->upload(uploadPass);
-    }
 
     std::shared_ptr<BucketType> bucket;
 };
@@ -1,17 +1,215 @@
 #include <mbgl/style/conversion/geojson.hpp>
 #include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <rapidjson/reader.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
 
 namespace mbgl {
 namespace style {
 namespace conversion {
 
+namespace {
+
+// Builds a JSON value from SAX events, like a JSDocument does while parsing.
+class ValueBuilder {
+public:
+    bool Null() { return push(JSValue()); }
+    bool Bool(const bool value) { return push(JSValue(value)); }
+    bool Int(const int value) { return push(JSValue(value)); }
+    bool Uint(const unsigned value) { return push(JSValue(value)); }
+    bool Int64(const int64_t value) { return push(JSValue(value)); }
+    bool Uint64(const uint64_t value) { return push(JSValue(value)); }
+    bool Double(const double value) { return push(JSValue(value)); }
+    bool String(const char* str, const rapidjson::SizeType length, bool) {
+        return push(JSValue(str, length, allocator));
+    }
+    bool Key(const char* str, const rapidjson::SizeType length, bool copy) { return String(str, length, copy); }
+    bool StartObject() { return push(JSValue(rapidjson::kObjectType)); }
+    bool StartArray() { return push(JSValue(rapidjson::kArrayType)); }
+
+    bool EndObject(const rapidjson::SizeType memberCount) {
+        const std::size_t first = stack.size() - 2 * memberCount;
+        JSValue& object = stack[first - 1];
+        for (std::size_t i = first; i < stack.size(); i += 2) {
+            object.AddMember(stack[i], stack[i + 1], allocator);
+        }
+        stack.resize(first);
+        return true;
+    }
+
+    bool EndArray(const rapidjson::SizeType elementCount) {
+        const std::size_t first = stack.size() - elementCount;
+        JSValue& array = stack[first - 1];
+        array.Reserve(elementCount, allocator);
+        for (std::size_t i = first; i < stack.size(); ++i) {
+            array.PushBack(stack[i], allocator);
+        }
+        stack.resize(first);
+        return true;
+    }
+
+    // Takes the value once all its events were received.
+    JSValue take() {
+        assert(stack.size() == 1);
+        JSValue value(std::move(stack.back()));
+        stack.clear();
+        return value;
+    }
+
+private:
+    bool push(JSValue&& value) {
+        stack.push_back(std::move(value));
+        return true;
+    }
+
+    rapidjson::CrtAllocator allocator;
+    std::vector<JSValue> stack;
+};
+
+// Reads a GeoJSON document without building a DOM of the whole document. The elements of the
+// "features" array of the root object are converted one by one as soon as they were read; all
+// other values are small and are converted once the document ends.
+class GeoJSONReader {
+public:
+    bool Null() { return value([](ValueBuilder& target) { return target.Null(); }); }
+    bool Bool(const bool b) { return value([&](ValueBuilder& target) { return target.Bool(b); }); }
+    bool Int(const int i) { return value([&](ValueBuilder& target) { return target.Int(i); }); }
+    bool Uint(const unsigned u) { return value([&](ValueBuilder& target) { return target.Uint(u); }); }
+    bool Int64(const int64_t i) { return value([&](ValueBuilder& target) { return target.Int64(i); }); }
+    bool Uint64(const uint64_t u) { return value([&](ValueBuilder& target) { return target.Uint64(u); }); }
+    bool Double(const double d) { return value([&](ValueBuilder& target) { return target.Double(d); }); }
+    bool RawNumber(const char*, rapidjson::SizeType, bool) { return false; }
+    bool String(const char* str, const rapidjson::SizeType length, const bool copy) {
+        return value([&](ValueBuilder& target) { return target.String(str, length, copy); });
+    }
+
+    bool Key(const char* str, const rapidjson::SizeType length, const bool copy) {
+        if (!readingFeature && depth == 1) {
+            featuresKey = length == std::strlen("features") && std::strncmp(str, "features", length) == 0;
+        }
+        return builder().Key(str, length, copy);
+    }
+
+    bool StartObject() {
+        if (inFeatures && depth == 2) {
+            readingFeature = true;
+        }
+        ++depth;
+        return builder().StartObject();
+    }
+
+    bool EndObject(const rapidjson::SizeType memberCount) {
+        --depth;
+        if (!builder().EndObject(memberCount)) {
+            return false;
+        }
+        if (readingFeature && depth == 2) {
+            readingFeature = false;
+            try {
+                features.push_back(mapbox::geojson::convert<mapbox::geojson::feature>(feature.take()));
+            } catch (const std::exception& ex) {
+                error = ex.what();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        if (inFeatures && depth == 2 && !readingFeature) {
+            error = "features must be objects";
+            return false;
+        }
+        if (!readingFeature && depth == 1 && featuresKey) {
+            inFeatures = true;
+            hasFeatures = true;
+        }
+        ++depth;
+        return builder().StartArray();
+    }
+
+    bool EndArray(const rapidjson::SizeType elementCount) {
+        --depth;
+        if (inFeatures && depth == 1) {
+            // The features were taken out of the array.
+            inFeatures = false;
+            return root.EndArray(0);
+        }
+        return builder().EndArray(elementCount);
+    }
+
+    optional<GeoJSON> finish(Error& err) {
+        JSValue document = root.take();
+        try {
+            const auto type = document.IsObject() ? document.FindMember("type") : document.MemberEnd();
+            if (type != document.MemberEnd() && type->value.IsString() &&
+                std::strcmp(type->value.GetString(), "FeatureCollection") == 0) {
+                if (!hasFeatures) {
+                    throw std::runtime_error("FeatureCollection must have features property");
+                }
+                return GeoJSON{std::move(features)};
+            }
+            return mapbox::geojson::convert(document);
+        } catch (const std::exception& ex) {
+            err = {ex.what()};
+            return nullopt;
+        }
+    }
+
+    std::string error;
+
+private:
+    template <class Fn>
+    bool value(Fn&& fn) {
+        if (inFeatures && depth == 2 && !readingFeature) {
+            error = "features must be objects";
+            return false;
+        }
+        return fn(builder());
+    }
+
+    ValueBuilder& builder() { return readingFeature ? feature : root; }
+
+    std::size_t depth = 0;
+    bool featuresKey = false;
+    bool inFeatures = false;
+    bool hasFeatures = false;
+    bool readingFeature = false;
+
+    ValueBuilder root;
+    ValueBuilder feature;
+    mapbox::geojson::feature_collection features;
+};
+
+} // namespace
+
 optional<GeoJSON> Converter<GeoJSON>::operator()(const Convertible& value, Error& error) const {
     return toGeoJSON(value, error);
 }
 
 optional<GeoJSON> parseGeoJSON(const std::string& value, Error& error) {
-    return convertJSON<GeoJSON>(value, error);
+    GeoJSONReader reader;
+    rapidjson::Reader parser;
+    rapidjson::StringStream stream(value.c_str());
+    const rapidjson::ParseResult result = parser.Parse(stream, reader);
+    if (!result) {
+        if (!reader.error.empty()) {
+            error = {reader.error};
+        } else {
+            error = {std::string{rapidjson::GetParseError_En(result.Code())} + " at offset " +
+                     util::toString(result.Offset())};
+        }
+        return nullopt;
+    }
+    return reader.finish(error);
 }
 
 } // namespace conversion
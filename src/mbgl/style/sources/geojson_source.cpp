@@ -41,12 +41,12 @@ void GeoJSONSource::setURL(const std::string& url_) {
 
 namespace {
 
-inline std::shared_ptr<GeoJSONData> createGeoJSONData(const mapbox::geojson::geojson& geoJSON,
+inline std::shared_ptr<GeoJSONData> createGeoJSONData(mapbox::geojson::geojson geoJSON,
                                                       const GeoJSONSource::Impl& impl) {
     if (auto data = impl.getData().lock()) {
-        return GeoJSONData::create(geoJSON, impl.getOptions(), data->getScheduler());
+        return GeoJSONData::create(std::move(geoJSON), impl.getOptions(), data->getScheduler());
     }
-    return GeoJSONData::create(geoJSON, impl.getOptions());
+    return GeoJSONData::create(std::move(geoJSON), impl.getOptions());
 }
 
 } // namespace
@@ -61,6 +61,38 @@ void GeoJSONSource::setGeoJSONData(std::shared_ptr<GeoJSONData> geoJSONData) {
     observer->onSourceChanged(*this);
 }
 
+void GeoJSONSource::updateFeatures(const GeoJSONData::Features& features) {
+    updateData(features, {});
+}
+
+void GeoJSONSource::removeFeatures(const std::vector<FeatureIdentifier>& ids) {
+    updateData({}, ids);
+}
+
+void GeoJSONSource::updateData(const GeoJSONData::Features& features, const std::vector<FeatureIdentifier>& removed) {
+    if (features.empty() && removed.empty()) {
+        return;
+    }
+
+    auto current = impl().getData().lock();
+    if (!current) {
+        // There is nothing to update yet.
+        setGeoJSON(GeoJSON{features});
+        return;
+    }
+
+    std::vector<LatLngBounds> changedBounds;
+    auto updated = current->update(features, removed, changedBounds);
+    if (!updated) {
+        Log::Warning(Event::General, "The data of GeoJSON source \"%s\" can't be updated", getID().c_str());
+        return;
+    }
+
+    req.reset();
+    baseImpl = makeMutable<Impl>(impl(), std::move(updated), std::move(changedBounds));
+    observer->onSourceChanged(*this);
+}
+
 optional<std::string> GeoJSONSource::getURL() const {
     return url;
 }
@@ -94,8 +126,9 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                 auto& current = static_cast<const Impl&>(*currentImpl);
                 conversion::Error error;
                 std::shared_ptr<GeoJSONData> geoJSONData;
-                if (optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*data, error)) {
-                    geoJSONData = createGeoJSONData(*geoJSON, current);
+                // The features are read straight from the response, without a DOM of the whole document.
+                if (optional<GeoJSON> geoJSON = conversion::parseGeoJSON(*data, error)) {
+                    geoJSONData = createGeoJSONData(std::move(*geoJSON), current);
                 } else {
                     // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for tiles to load.
                     Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s", error.message.c_str());
@@ -1,23 +1,221 @@
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/style/expression/expression.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/util/projection.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/thread_pool.hpp>
 
 #include <mapbox/geojsonvt.hpp>
+#include <mapbox/geometry/for_each_point.hpp>
 #include <supercluster.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace mbgl {
 namespace style {
 
+namespace {
+
+using Features = GeoJSONData::Features;
+
+// Features are tiled in shards of at most this many features, so that updating a few features
+// only re-tiles the shards that contain them.
+constexpr std::size_t maxShardSize = 1024;
+
+// Renderers that missed more updates than this reload all their tiles.
+constexpr std::size_t maxTrackedUpdates = 16;
+
+struct FeatureIdentifierHash {
+    std::size_t operator()(const FeatureIdentifier& id) const {
+        return id.match([](const std::string& value) { return std::hash<std::string>()(value); },
+                        [](const uint64_t value) { return std::hash<uint64_t>()(value); },
+                        [](const int64_t value) { return std::hash<int64_t>()(value); },
+                        [](const double value) { return std::hash<double>()(value); },
+                        [](const auto&) -> std::size_t { return 0; });
+    }
+};
+
+using FeatureIndices = std::unordered_map<FeatureIdentifier, std::size_t, FeatureIdentifierHash>;
+
+FeatureIndices indexFeatures(const Features& features) {
+    FeatureIndices indices;
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (!features[i].id.is<NullValue>()) {
+            indices.emplace(features[i].id, i);
+        }
+    }
+    return indices;
+}
+
+LatLngBounds featureBounds(const GeoJSONFeature& feature) {
+    LatLngBounds bounds = LatLngBounds::empty();
+    mapbox::geometry::for_each_point(feature.geometry, [&](const mapbox::geometry::point<double>& point) {
+        bounds.extend(LatLng(util::clamp(point.y, -90.0, 90.0), point.x));
+    });
+    return bounds;
+}
+
+Features toFeatures(GeoJSON geoJSON) {
+    if (geoJSON.is<Features>()) {
+        return std::move(geoJSON.get<Features>());
+    }
+    Features features;
+    if (geoJSON.is<GeoJSONFeature>()) {
+        features.push_back(geoJSON.get<GeoJSONFeature>());
+    } else {
+        features.emplace_back(geoJSON.get<mapbox::geometry::geometry<double>>());
+    }
+    return features;
+}
+
+// Drops the features with the `removed` ids, then replaces the features with the ids of the
+// `updated` features or appends them.
+Features applyChanges(Features features, const Features& updated, const std::vector<FeatureIdentifier>& removed) {
+    FeatureIndices indices = indexFeatures(features);
+    std::vector<bool> dropped(features.size(), false);
+    for (const auto& id : removed) {
+        auto it = indices.find(id);
+        if (it != indices.end()) {
+            dropped[it->second] = true;
+            indices.erase(it);
+        }
+    }
+    for (const auto& feature : updated) {
+        auto it = feature.id.is<NullValue>() ? indices.end() : indices.find(feature.id);
+        if (it != indices.end()) {
+            features[it->second] = feature;
+        } else {
+            if (!feature.id.is<NullValue>()) {
+                indices.emplace(feature.id, features.size());
+            }
+            features.push_back(feature);
+            dropped.push_back(false);
+        }
+    }
+
+    Features result;
+    result.reserve(features.size());
+    for (std::size_t i = 0; i < features.size(); ++i) {
+        if (!dropped[i]) {
+            result.push_back(std::move(features[i]));
+        }
+    }
+    return result;
+}
+
+// A slice of the features of a GeoJSON-VT source with its own tile index.
+struct GeoJSONVTShard {
+    using TileFeatures = GeoJSONData::TileFeatures;
+
+    GeoJSONVTShard(Features features_, const mapbox::geojsonvt::Options& options)
+        : features(std::move(features_)), index(features, options) {
+        for (const auto& feature : features) {
+            bounds.extend(featureBounds(feature));
+        }
+    }
+
+    TileFeatures getTile(const CanonicalTileID& id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index.getTile(id.z, id.x, id.y).features;
+    }
+
+    // GeoJSON-VT only keeps clipped and simplified tile geometry, so the features are kept for
+    // rebuilding the shard when they change.
+    const Features features;
+    LatLngBounds bounds = LatLngBounds::empty();
+
+private:
+    // The index splits tiles lazily, so concurrent tile requests take turns.
+    std::mutex mutex;
+    mapbox::geojsonvt::GeoJSONVT index;
+};
+
+using GeoJSONVTShards = std::vector<std::shared_ptr<GeoJSONVTShard>>;
+
+// The shard that holds a feature and the index of the feature in it.
+struct FeatureLocation {
+    const GeoJSONVTShard* shard;
+    std::size_t index;
+};
+
+using FeatureLocations = std::unordered_map<FeatureIdentifier, FeatureLocation, FeatureIdentifierHash>;
+
+void addFeatureLocations(FeatureLocations& locations, const GeoJSONVTShard& shard) {
+    for (std::size_t i = 0; i < shard.features.size(); ++i) {
+        if (!shard.features[i].id.is<NullValue>()) {
+            locations.emplace(shard.features[i].id, FeatureLocation{&shard, i});
+        }
+    }
+}
+
+void removeFeatureLocations(FeatureLocations& locations, const GeoJSONVTShard& shard) {
+    for (const auto& feature : shard.features) {
+        auto it = feature.id.is<NullValue>() ? locations.end() : locations.find(feature.id);
+        if (it != locations.end() && it->second.shard == &shard) {
+            locations.erase(it);
+        }
+    }
+}
+
+// Cuts the features into slices that fit into a shard.
+void sliceFeatures(Features features, std::vector<Features>& slices) {
+    for (std::size_t begin = 0; begin < features.size(); begin += maxShardSize) {
+        const std::size_t end = std::min(begin + maxShardSize, features.size());
+        Features slice;
+        slice.reserve(end - begin);
+        std::move(features.begin() + begin, features.begin() + end, std::back_inserter(slice));
+        slices.push_back(std::move(slice));
+    }
+}
+
+// Indexes the slices on the background workers.
+GeoJSONVTShards buildShards(std::vector<Features> slices, const mapbox::geojsonvt::Options& options) {
+    GeoJSONVTShards shards(slices.size());
+    std::shared_ptr<Scheduler> scheduler = Scheduler::GetBackground();
+    util::parallelFor(*scheduler, slices.size(), [&](const std::size_t i) {
+        shards[i] = std::make_shared<GeoJSONVTShard>(std::move(slices[i]), options);
+    });
+    return shards;
+}
+
+} // namespace
+
 class GeoJSONVTData final : public GeoJSONData {
     void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
         assert(fn);
         scheduler->scheduleAndReplyValue(
-            [id, impl = this->impl]() -> TileFeatures { return impl->getTile(id.z, id.x, id.y).features; }, fn);
+            [id, shards = this->shards, buffer = options->buffer]() -> TileFeatures {
+                GeoJSONVTShards tileShards;
+                for (const auto& shard : shards) {
+                    if (boundsIntersectTile(shard->bounds, id, buffer)) {
+                        tileShards.push_back(shard);
+                    }
+                }
+                if (tileShards.size() == 1) {
+                    return tileShards.front()->getTile(id);
+                }
+
+                // Shards split their tiles independently. They keep the order of the features, so
+                // their tiles are simply concatenated. Other tiles are requested concurrently, so
+                // this task doesn't wait for further tasks on the same workers.
+                TileFeatures features;
+                for (const auto& shard : tileShards) {
+                    TileFeatures tileFeatures = shard->getTile(id);
+                    std::move(tileFeatures.begin(), tileFeatures.end(), std::back_inserter(features));
+                }
+                return features;
+            },
+            fn);
     }
 
     Features getChildren(const std::uint32_t) final { return {}; }
@@ -30,16 +228,111 @@ class GeoJSONVTData final : public GeoJSONData {
 
     std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
 
+    std::shared_ptr<GeoJSONData> update(const Features& updated,
+                                        const std::vector<FeatureIdentifier>& removed,
+                                        std::vector<LatLngBounds>& changedBounds) final {
+        if (options->cluster) {
+            // Clusters are formed once there are features; see GeoJSONData::create().
+            Features features;
+            for (const auto& shard : shards) {
+                features.insert(features.end(), shard->features.begin(), shard->features.end());
+            }
+            changedBounds.push_back(LatLngBounds::world());
+            return GeoJSONData::create(GeoJSON{applyChanges(std::move(features), updated, removed)}, options, scheduler);
+        }
+
+        // The feature locations are only needed from here on, so they're built on the first update.
+        if (!locations) {
+            locations = std::make_unique<FeatureLocations>();
+            for (const auto& shard : shards) {
+                addFeatureLocations(*locations, *shard);
+            }
+        }
+        std::unordered_map<const GeoJSONVTShard*, std::size_t> shardIndices;
+        for (std::size_t i = 0; i < shards.size(); ++i) {
+            shardIndices.emplace(shards[i].get(), i);
+        }
+
+        // Collect the changes per shard. New features go to the last shard while it has room.
+        struct ShardChanges {
+            Features updated;
+            std::vector<FeatureIdentifier> removed;
+        };
+        std::map<std::size_t, ShardChanges> changes;
+        const auto locate = [&](const FeatureIdentifier& id) -> optional<std::size_t> {
+            auto it = id.is<NullValue>() ? locations->end() : locations->find(id);
+            if (it == locations->end()) {
+                return nullopt;
+            }
+            changedBounds.push_back(featureBounds(it->second.shard->features[it->second.index]));
+            return shardIndices.at(it->second.shard);
+        };
+        for (const auto& id : removed) {
+            if (const auto shard = locate(id)) {
+                changes[*shard].removed.push_back(id);
+            }
+        }
+        const bool lastShardFull = shards.empty() || shards.back()->features.size() >= maxShardSize;
+        const std::size_t appendShard = lastShardFull ? shards.size() : shards.size() - 1;
+        for (const auto& feature : updated) {
+            changedBounds.push_back(featureBounds(feature));
+            const auto shard = locate(feature.id);
+            changes[shard ? *shard : appendShard].updated.push_back(feature);
+        }
+
+        // Unchanged shards are shared, the others are rebuilt together and take their place.
+        GeoJSONVTShards result;
+        std::vector<Features> slices;
+        std::vector<std::size_t> rebuilt;
+        for (std::size_t i = 0; i <= shards.size(); ++i) {
+            auto it = changes.find(i);
+            if (it == changes.end()) {
+                if (i < shards.size()) {
+                    result.push_back(shards[i]);
+                }
+                continue;
+            }
+            Features features;
+            if (i < shards.size()) {
+                removeFeatureLocations(*locations, *shards[i]);
+                features = shards[i]->features;
+            }
+            sliceFeatures(applyChanges(std::move(features), it->second.updated, it->second.removed), slices);
+            while (rebuilt.size() < slices.size()) {
+                rebuilt.push_back(result.size());
+                result.emplace_back();
+            }
+        }
+        GeoJSONVTShards shardsBuilt = buildShards(std::move(slices), vtOptions);
+        for (std::size_t i = 0; i < rebuilt.size(); ++i) {
+            addFeatureLocations(*locations, *shardsBuilt[i]);
+            result[rebuilt[i]] = std::move(shardsBuilt[i]);
+        }
+        auto data = std::unique_ptr<GeoJSONVTData>(new GeoJSONVTData(std::move(result), vtOptions, options, scheduler));
+        // Updates are applied to the latest data, so it takes over the locations.
+        data->locations = std::move(locations);
+        return std::shared_ptr<GeoJSONData>(std::move(data));
+    }
+
     friend GeoJSONData;
-    GeoJSONVTData(const GeoJSON& geoJSON,
-                  const mapbox::geojsonvt::Options& options,
+    GeoJSONVTData(GeoJSONVTShards shards_,
+                  const mapbox::geojsonvt::Options& vtOptions_,
+                  Immutable<GeoJSONOptions> options_,
                   std::shared_ptr<Scheduler> scheduler_)
-        : impl(std::make_shared<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options)), scheduler(std::move(scheduler_)) {
+        : shards(std::move(shards_)),
+          vtOptions(vtOptions_),
+          options(std::move(options_)),
+          scheduler(std::move(scheduler_)) {
         assert(scheduler);
     }
 
-    std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> impl; // Accessed on worker thread.
+    const GeoJSONVTShards shards;
+    const mapbox::geojsonvt::Options vtOptions;
+    const Immutable<GeoJSONOptions> options;
     std::shared_ptr<Scheduler> scheduler;
+    // Where the features with an ID are stored. Only used by update(), which runs on the thread
+    // that owns the source.
+    std::unique_ptr<FeatureLocations> locations;
 };
 
 class SuperclusterData final : public GeoJSONData {
@@ -58,28 +351,210 @@ class SuperclusterData final : public GeoJSONData {
         return impl.getClusterExpansionZoom(cluster_id);
     }
 
+    std::shared_ptr<GeoJSONData> update(const Features& updated,
+                                        const std::vector<FeatureIdentifier>& removed,
+                                        std::vector<LatLngBounds>& changedBounds) final {
+        // Moving a single point can change clusters anywhere, so the clusters are rebuilt.
+        changedBounds.push_back(LatLngBounds::world());
+        return GeoJSONData::create(GeoJSON{applyChanges(impl.features, updated, removed)}, options);
+    }
+
     friend GeoJSONData;
-    SuperclusterData(const Features& features, const mapbox::supercluster::Options& options)
-        : impl(features, options) {}
+    SuperclusterData(const Features& features,
+                     const mapbox::supercluster::Options& clusterOptions,
+                     Immutable<GeoJSONOptions> options_)
+        : options(std::move(options_)), impl(features, clusterOptions) {}
+
+    const Immutable<GeoJSONOptions> options;
+    // Keeps the features it was created from, which are updated and clustered again on changes.
     mapbox::supercluster::Supercluster impl;
 };
 
-template <class T>
-T evaluateFeature(const mapbox::feature::feature<double>& f,
-                  const std::shared_ptr<expression::Expression>& expression,
-                  optional<T> accumulated = nullopt) {
-    const expression::EvaluationResult result = expression->evaluate(accumulated, f);
-    if (result) {
-        optional<T> typed = expression::fromExpressionValue<T>(*result);
-        if (typed) {
-            return std::move(*typed);
+namespace {
+
+// Exposes the properties of a point or cluster to the cluster expressions without copying them
+// into a feature. Supercluster only clusters points, so both are points.
+class ClusterPropertiesFeature final : public GeometryTileFeature {
+public:
+    explicit ClusterPropertiesFeature(const PropertyMap& properties_) : properties(properties_) {}
+
+    FeatureType getType() const override { return FeatureType::Point; }
+    const PropertyMap& getProperties() const override { return properties; }
+    optional<Value> getValue(const std::string& key) const override {
+        auto it = properties.find(key);
+        if (it != properties.end()) {
+            return optional<Value>(it->second);
+        }
+        return optional<Value>();
+    }
+
+private:
+    const PropertyMap& properties;
+};
+
+// Strips the ["number", value] assertion that the parser adds to arguments of numeric operators.
+const Value& withoutNumberAssertion(const Value& value) {
+    if (value.is<mapbox::base::ValueArray>()) {
+        const auto& array = value.get<mapbox::base::ValueArray>();
+        if (array.size() == 2 && array[0] == Value(std::string("number"))) {
+            return array[1];
         }
     }
-    return T();
+    return value;
 }
 
+// Returns the key of a ["get", key] expression.
+optional<std::string> propertyKey(const Value& value) {
+    if (value.is<mapbox::base::ValueArray>()) {
+        const auto& array = value.get<mapbox::base::ValueArray>();
+        if (array.size() == 2 && array[0] == Value(std::string("get")) && array[1].is<std::string>()) {
+            return array[1].get<std::string>();
+        }
+    }
+    return nullopt;
+}
+
+bool isAccumulated(const Value& value) {
+    return value == Value(mapbox::base::ValueArray{Value(std::string("accumulated"))});
+}
+
+// Computes the cluster properties of the points and clusters merged by supercluster. Map expressions
+// of the form ["get", key] and reduce expressions of the form [operator, ["accumulated"], ["get", key]]
+// with an arithmetic operator, which includes all the reduce expressions created from an operator
+// name, are computed on the property values directly. All other expressions are evaluated on the
+// properties in place.
+class ClusterAggregation {
+public:
+    explicit ClusterAggregation(const GeoJSONOptions::ClusterProperties& clusterProperties) {
+        properties.reserve(clusterProperties.size());
+        for (const auto& p : clusterProperties) {
+            Property property;
+            property.name = p.first;
+            property.map = p.second.first;
+            property.reduce = p.second.second;
+            property.mapKey = propertyKey(property.map->serialize());
+            compileReduce(property);
+            properties.push_back(std::move(property));
+        }
+    }
+
+    PropertyMap map(const PropertyMap& pointProperties) const {
+        PropertyMap result{};
+        if (pointProperties.empty()) return result;
+        const ClusterPropertiesFeature feature(pointProperties);
+        for (const auto& property : properties) {
+            if (property.mapKey) {
+                auto it = pointProperties.find(*property.mapKey);
+                result[property.name] = it != pointProperties.end()
+                                            ? expression::fromExpressionValue<Value>(
+                                                  expression::toExpressionValue(it->second))
+                                            : Value();
+            } else {
+                result[property.name] = evaluate(*property.map, feature, nullopt);
+            }
+        }
+        return result;
+    }
+
+    void reduce(PropertyMap& accumulated, const PropertyMap& clusterProperties) const {
+        const ClusterPropertiesFeature feature(clusterProperties);
+        for (const auto& property : properties) {
+            if (clusterProperties.count(property.name) == 0) {
+                continue;
+            }
+            Value& target = accumulated[property.name];
+            if (property.reduction == Reduction::None) {
+                target = evaluate(*property.reduce, feature, target);
+                continue;
+            }
+            auto it = clusterProperties.find(property.reduceKey);
+            const optional<double> lhs = numericValue<double>(target);
+            const optional<double> rhs =
+                it != clusterProperties.end() ? numericValue<double>(it->second) : optional<double>();
+            if (!lhs || !rhs) {
+                target = Value();
+                continue;
+            }
+            switch (property.reduction) {
+                case Reduction::Sum:
+                    target = Value(*lhs + *rhs);
+                    break;
+                case Reduction::Product:
+                    target = Value(*lhs * *rhs);
+                    break;
+                case Reduction::Max:
+                    target = Value(std::max(*lhs, *rhs));
+                    break;
+                case Reduction::Min:
+                    target = Value(std::min(*lhs, *rhs));
+                    break;
+                case Reduction::None:
+                    break;
+            }
+        }
+    }
+
+private:
+    enum class Reduction { None, Sum, Product, Max, Min };
+
+    struct Property {
+        std::string name;
+        std::shared_ptr<expression::Expression> map;
+        std::shared_ptr<expression::Expression> reduce;
+        // Set when the map expression only reads a property.
+        optional<std::string> mapKey;
+        // Set to an operator when the reduce expression combines the accumulated value with the
+        // numeric property reduceKey.
+        Reduction reduction = Reduction::None;
+        std::string reduceKey;
+    };
+
+    static void compileReduce(Property& property) {
+        const Value serialized = property.reduce->serialize();
+        if (!serialized.is<mapbox::base::ValueArray>()) return;
+        const auto& array = serialized.get<mapbox::base::ValueArray>();
+        if (array.size() != 3 || !array[0].is<std::string>() || !isAccumulated(withoutNumberAssertion(array[1]))) {
+            return;
+        }
+        const optional<std::string> key = propertyKey(withoutNumberAssertion(array[2]));
+        if (!key) return;
+
+        const std::string& op = array[0].get<std::string>();
+        if (op == "+") {
+            property.reduction = Reduction::Sum;
+        } else if (op == "*") {
+            property.reduction = Reduction::Product;
+        } else if (op == "max") {
+            property.reduction = Reduction::Max;
+        } else if (op == "min") {
+            property.reduction = Reduction::Min;
+        } else {
+            return;
+        }
+        property.reduceKey = *key;
+    }
+
+    static Value evaluate(const expression::Expression& expression,
+                          const GeometryTileFeature& feature,
+                          optional<Value> accumulated) {
+        const expression::EvaluationResult result =
+            expression.evaluate(expression::EvaluationContext(std::move(accumulated), &feature));
+        if (result) {
+            optional<Value> typed = expression::fromExpressionValue<Value>(*result);
+            if (typed) {
+                return std::move(*typed);
+            }
+        }
+        return Value();
+    }
+
+    std::vector<Property> properties;
+};
+
+} // namespace
+
 // static
-std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
+std::shared_ptr<GeoJSONData> GeoJSONData::create(GeoJSON geoJSON,
                                                  const Immutable<GeoJSONOptions>& options,
                                                  std::shared_ptr<Scheduler> scheduler) {
     constexpr double scale = util::EXTENT / util::tileSize;
@@ -88,27 +563,14 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
         clusterOptions.maxZoom = options->clusterMaxZoom;
         clusterOptions.extent = util::EXTENT;
         clusterOptions.radius = ::round(scale * options->clusterRadius);
-        auto feature = std::make_shared<Feature>();
-        clusterOptions.map = [feature, options](const PropertyMap& properties) -> PropertyMap {
-            PropertyMap ret{};
-            if (properties.empty()) return ret;
-            for (const auto& p : options->clusterProperties) {
-                feature->properties = properties;
-                ret[p.first] = evaluateFeature<Value>(*feature, p.second.first);
-            }
-            return ret;
+        auto aggregation = std::make_shared<const ClusterAggregation>(options->clusterProperties);
+        clusterOptions.map = [aggregation](const PropertyMap& properties) -> PropertyMap {
+            return aggregation->map(properties);
         };
-        clusterOptions.reduce = [feature, options](PropertyMap& toReturn, const PropertyMap& toFill) {
-            for (const auto& p : options->clusterProperties) {
-                if (toFill.count(p.first) == 0) {
-                    continue;
-                }
-                feature->properties = toFill;
-                optional<Value> accumulated(toReturn[p.first]);
-                toReturn[p.first] = evaluateFeature<Value>(*feature, p.second.second, accumulated);
-            }
+        clusterOptions.reduce = [aggregation](PropertyMap& toReturn, const PropertyMap& toFill) {
+            aggregation->reduce(toReturn, toFill);
         };
-        return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), clusterOptions));
+        return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), clusterOptions, options));
     }
 
     mapbox::geojsonvt::Options vtOptions;
@@ -117,8 +579,18 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
     vtOptions.buffer = ::round(scale * options->buffer);
     vtOptions.tolerance = scale * options->tolerance;
     vtOptions.lineMetrics = options->lineMetrics;
-    if (!scheduler) scheduler = Scheduler::GetSequenced();
-    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, vtOptions, std::move(scheduler)));
+    // Shards are thread-safe, so tiles are split concurrently.
+    if (!scheduler) scheduler = Scheduler::GetBackground();
+    std::vector<Features> slices;
+    sliceFeatures(toFeatures(std::move(geoJSON)), slices);
+    return std::shared_ptr<GeoJSONData>(
+        new GeoJSONVTData(buildShards(std::move(slices), vtOptions), vtOptions, options, std::move(scheduler)));
+}
+
+std::shared_ptr<GeoJSONData> GeoJSONData::update(const Features&,
+                                                 const std::vector<FeatureIdentifier>&,
+                                                 std::vector<LatLngBounds>&) {
+    return nullptr;
 }
 
 GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
@@ -127,6 +599,17 @@ GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
 GeoJSONSource::Impl::Impl(const GeoJSONSource::Impl& other, std::shared_ptr<GeoJSONData> data_)
     : Source::Impl(other), options(other.options), data(std::move(data_)) {}
 
+GeoJSONSource::Impl::Impl(const GeoJSONSource::Impl& other,
+                          std::shared_ptr<GeoJSONData> data_,
+                          std::vector<LatLngBounds> changedBounds)
+    : Source::Impl(other), options(other.options), data(std::move(data_)) {
+    const bool keepHistory = other.lastUpdate && other.lastUpdate->depth < maxTrackedUpdates;
+    lastUpdate = std::make_shared<const DataUpdate>(DataUpdate{other.data,
+                                                               std::move(changedBounds),
+                                                               keepHistory ? other.lastUpdate : nullptr,
+                                                               keepHistory ? other.lastUpdate->depth + 1 : 1});
+}
+
 GeoJSONSource::Impl::~Impl() = default;
 
 Range<uint8_t> GeoJSONSource::Impl::getZoomRange() const {
@@ -137,9 +620,42 @@ std::weak_ptr<GeoJSONData> GeoJSONSource::Impl::getData() const {
     return data;
 }
 
+optional<std::vector<LatLngBounds>> GeoJSONSource::Impl::getChangedBoundsSince(
+    const std::weak_ptr<GeoJSONData>& previous) const {
+    std::vector<LatLngBounds> result;
+    for (const DataUpdate* update = lastUpdate.get(); update; update = update->before.get()) {
+        result.insert(result.end(), update->changedBounds.begin(), update->changedBounds.end());
+        if (!update->previous.owner_before(previous) && !previous.owner_before(update->previous)) {
+            return result;
+        }
+    }
+    return nullopt;
+}
+
 optional<std::string> GeoJSONSource::Impl::getAttribution() const {
     return {};
 }
 
+bool boundsIntersectTile(const LatLngBounds& bounds, const CanonicalTileID& id, const uint16_t buffer) {
+    if (bounds.isEmpty()) {
+        return false;
+    }
+    // In units of tiles at the zoom level of the tile.
+    const double scale = std::pow(2.0, id.z);
+    const double margin = double(buffer) / util::tileSize;
+    const Point<double> nw = Projection::project(bounds.northwest(), scale) / util::tileSize;
+    const Point<double> se = Projection::project(bounds.southeast(), scale) / util::tileSize;
+    if (se.y < id.y - margin || nw.y > id.y + 1 + margin) {
+        return false;
+    }
+    // Features close to the antimeridian also show up in the tiles at the other side of the world.
+    for (const double wrap : {-scale, 0.0, scale}) {
+        if (se.x + wrap >= id.x - margin && nw.x + wrap <= id.x + 1 + margin) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace style
 } // namespace mbgl
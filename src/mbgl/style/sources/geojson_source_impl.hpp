@@ -4,6 +4,8 @@
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <vector>
+
 namespace mbgl {
 
 class AsyncRequest;
@@ -15,18 +17,37 @@ class GeoJSONSource::Impl final : public Source::Impl {
 public:
     Impl(std::string id, Immutable<GeoJSONOptions>);
     Impl(const GeoJSONSource::Impl&, std::shared_ptr<GeoJSONData>);
+    // Used when the data was derived from the data of `other` by GeoJSONData::update().
+    Impl(const GeoJSONSource::Impl& other, std::shared_ptr<GeoJSONData>, std::vector<LatLngBounds> changedBounds);
     ~Impl() final;
 
     Range<uint8_t> getZoomRange() const;
     std::weak_ptr<GeoJSONData> getData() const;
     const Immutable<GeoJSONOptions>& getOptions() const { return options; }
 
+    // Returns the bounds of all features that changed since `previous` was the data of this
+    // source, or nullopt if the data was replaced entirely since then.
+    optional<std::vector<LatLngBounds>> getChangedBoundsSince(const std::weak_ptr<GeoJSONData>& previous) const;
+
     optional<std::string> getAttribution() const final;
 
 private:
+    // Links the data to the data it was updated from. Only the last few updates are kept.
+    struct DataUpdate {
+        std::weak_ptr<GeoJSONData> previous;
+        std::vector<LatLngBounds> changedBounds;
+        std::shared_ptr<const DataUpdate> before;
+        std::size_t depth;
+    };
+
     Immutable<GeoJSONOptions> options;
     std::shared_ptr<GeoJSONData> data;
+    std::shared_ptr<const DataUpdate> lastUpdate;
 };
 
+// Whether features within the bounds can show up in the tile, which also contains the features
+// within `buffer` pixels around it.
+bool boundsIntersectTile(const LatLngBounds&, const CanonicalTileID&, uint16_t buffer);
+
 } // namespace style
 } // namespace mbgl
@@ -3,18 +3,51 @@
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/util/hash.hpp>
+
+#include <algorithm>
+#include <limits>
 
 namespace mbgl {
 
+namespace {
+
+// Cell size of the symbols spatial hash, in the grid units of `TileLayerIndex::getScaledCoordinates()`.
+constexpr int64_t kCellSize = 4;
+constexpr uint32_t kNoSymbol = std::numeric_limits<uint32_t>::max();
+
+int64_t getCellCoordinate(int64_t coordinate) {
+    // Rounds towards negative infinity, as the coordinates of the buffered symbols can be negative.
+    return coordinate >= 0 ? coordinate / kCellSize : -((-coordinate + kCellSize - 1) / kCellSize);
+}
+
+} // namespace
+
+std::size_t TileLayerIndex::CellHash::operator()(const Cell& cell) const {
+    return util::hash(cell.keyHash, cell.x, cell.y);
+}
+
 TileLayerIndex::TileLayerIndex(OverscaledTileID coord_,
                                std::vector<SymbolInstance>& symbolInstances,
+                               const std::vector<std::size_t>& keyHashes,
                                uint32_t bucketInstanceId_,
                                std::string bucketLeaderId_)
     : coord(coord_), bucketInstanceId(bucketInstanceId_), bucketLeaderId(std::move(bucketLeaderId_)) {
-    for (SymbolInstance& symbolInstance : symbolInstances) {
+    assert(keyHashes.size() == symbolInstances.size());
+    std::unordered_map<std::u16string, uint32_t> keyIndexes;
+    for (std::size_t i = 0; i < symbolInstances.size(); ++i) {
+        SymbolInstance& symbolInstance = symbolInstances[i];
         if (symbolInstance.crossTileID == SymbolInstance::invalidCrossTileID()) continue;
-        indexedSymbolInstances[symbolInstance.key].emplace_back(symbolInstance.crossTileID,
-                                                                getScaledCoordinates(symbolInstance, coord));
+        auto keyIndex = keyIndexes.emplace(symbolInstance.key, static_cast<uint32_t>(keys.size()));
+        if (keyIndex.second) keys.push_back(symbolInstance.key);
+
+        const auto index = static_cast<uint32_t>(indexedSymbolInstances.size());
+        const auto scaledCoord = getScaledCoordinates(symbolInstance, coord);
+        indexedSymbolInstances.emplace_back(symbolInstance.crossTileID, scaledCoord, keyIndex.first->second);
+        auto cell = cells.emplace(
+            Cell{keyHashes[i], getCellCoordinate(scaledCoord.x), getCellCoordinate(scaledCoord.y)}, index);
+        nextInCell.push_back(cell.second ? kNoSymbol : cell.first->second);
+        cell.first->second = index;
     }
 }
 
@@ -30,41 +63,73 @@ Point<int64_t> TileLayerIndex::getScaledCoordinates(SymbolInstance& symbolInstan
 }
 
 void TileLayerIndex::findMatches(SymbolBucket& bucket,
+                                 const std::vector<std::size_t>& keyHashes,
                                  const OverscaledTileID& newCoord,
-                                 std::set<uint32_t>& zoomCrossTileIDs) const {
+                                 std::unordered_set<uint32_t>& zoomCrossTileIDs) const {
     auto& symbolInstances = bucket.symbolInstances;
+    assert(keyHashes.size() == symbolInstances.size());
     float tolerance = coord.canonical.z < newCoord.canonical.z ? 1 : std::pow(2, coord.canonical.z - newCoord.canonical.z);
+    const auto cellTolerance = static_cast<int64_t>(std::ceil(tolerance));
+    // The number of cells to look up grows quadratically with the zoom difference, while scanning
+    // all symbols of the tile costs the same at every zoom level.
+    const int64_t cellSpan = 2 * cellTolerance / kCellSize + 2;
+    const bool scanSymbols = cellSpan * cellSpan > static_cast<int64_t>(indexedSymbolInstances.size());
 
     if (bucket.bucketLeaderID != bucketLeaderId) return;
 
-    for (auto& symbolInstance : symbolInstances) {
+    for (std::size_t i = 0; i < symbolInstances.size(); ++i) {
+        auto& symbolInstance = symbolInstances[i];
         if (symbolInstance.crossTileID) {
             // already has a match, skip
             continue;
         }
 
-        auto it = indexedSymbolInstances.find(symbolInstance.key);
-        if (it == indexedSymbolInstances.end()) {
-            // No symbol with this key in this bucket
-            continue;
-        }
-
         auto scaledSymbolCoord = getScaledCoordinates(symbolInstance, newCoord);
-
-        for (const IndexedSymbolInstance& thisTileSymbol : it->second) {
-            // Return any symbol with the same keys whose coordinates are within 1
-            // grid unit. (with a 4px grid, this covers a 12px by 12px area)
-            if (std::abs(thisTileSymbol.coord.x - scaledSymbolCoord.x) <= tolerance &&
-                std::abs(thisTileSymbol.coord.y - scaledSymbolCoord.y) <= tolerance &&
-                zoomCrossTileIDs.find(thisTileSymbol.crossTileID) == zoomCrossTileIDs.end()) {
-                // Once we've marked ourselves duplicate against this parent symbol,
-                // don't let any other symbols at the same zoom level duplicate against
-                // the same parent (see issue #10844)
-                zoomCrossTileIDs.insert(thisTileSymbol.crossTileID);
-                symbolInstance.crossTileID = thisTileSymbol.crossTileID;
-                break;
+        const auto matches = [&](const uint32_t index) {
+            const IndexedSymbolInstance& thisTileSymbol = indexedSymbolInstances[index];
+            return std::abs(thisTileSymbol.coord.x - scaledSymbolCoord.x) <= tolerance &&
+                   std::abs(thisTileSymbol.coord.y - scaledSymbolCoord.y) <= tolerance &&
+                   zoomCrossTileIDs.find(thisTileSymbol.crossTileID) == zoomCrossTileIDs.end() &&
+                   keys[thisTileSymbol.keyIndex] == symbolInstance.key;
+        };
+
+        // Find the first symbol with the same key whose coordinates are within 1
+        // grid unit. (with a 4px grid, this covers a 12px by 12px area)
+        uint32_t match = kNoSymbol;
+        if (scanSymbols) {
+            const auto count = static_cast<uint32_t>(indexedSymbolInstances.size());
+            for (uint32_t index = 0; index < count; ++index) {
+                if (matches(index)) {
+                    match = index;
+                    break;
+                }
+            }
+        } else {
+            for (int64_t x = getCellCoordinate(scaledSymbolCoord.x - cellTolerance);
+                 x <= getCellCoordinate(scaledSymbolCoord.x + cellTolerance);
+                 ++x) {
+                for (int64_t y = getCellCoordinate(scaledSymbolCoord.y - cellTolerance);
+                     y <= getCellCoordinate(scaledSymbolCoord.y + cellTolerance);
+                     ++y) {
+                    auto cell = cells.find(Cell{keyHashes[i], x, y});
+                    if (cell == cells.end()) continue;
+                    for (uint32_t index = cell->second; index != kNoSymbol; index = nextInCell[index]) {
+                        if (index < match && matches(index)) {
+                            match = index;
+                        }
+                    }
+                }
             }
         }
+
+        if (match != kNoSymbol) {
+            // Once we've marked ourselves duplicate against this parent symbol,
+            // don't let any other symbols at the same zoom level duplicate against
+            // the same parent (see issue #10844)
+            const uint32_t crossTileID = indexedSymbolInstances[match].crossTileID;
+            zoomCrossTileIDs.insert(crossTileID);
+            symbolInstance.crossTileID = crossTileID;
+        }
     }
 }
 
@@ -78,9 +143,9 @@ CrossTileSymbolLayerIndex::CrossTileSymbolLayerIndex(uint32_t& maxCrossTileID_)
 void CrossTileSymbolLayerIndex::handleWrapJump(float newLng) {
     const int wrapDelta = std::round((newLng - lng) / 360);
     if (wrapDelta != 0) {
-        std::map<uint8_t, std::map<OverscaledTileID,TileLayerIndex>> newIndexes;
+        std::map<uint8_t, std::unordered_map<OverscaledTileID, TileLayerIndex>> newIndexes;
         for (auto& zoomIndex : indexes) {
-            std::map<OverscaledTileID,TileLayerIndex> newZoomIndex;
+            std::unordered_map<OverscaledTileID, TileLayerIndex> newZoomIndex;
             for (auto& index : zoomIndex.second) {
                 // change the tileID's wrap and move its index
                 index.second.coord = index.second.coord.unwrapTo(index.second.coord.wrap + wrapDelta);
@@ -117,7 +182,8 @@ bool CrossTileSymbolLayerIndex::addBucket(const OverscaledTileID& tileID,
     auto& thisZoomIndexes = indexes[tileID.overscaledZ];
     auto previousIndex = thisZoomIndexes.find(tileID);
     if (previousIndex != thisZoomIndexes.end()) {
-        if (previousIndex->second.bucketInstanceId == bucket.bucketInstanceId && !bucket.hasUninitializedSymbols) {
+        if (previousIndex->second.bucketInstanceId == bucket.bucketInstanceId &&
+            (!bucket.hasUninitializedSymbols || keepIndexedSymbols)) {
             return false;
         } else {
             // We're replacing this bucket with an updated version
@@ -149,20 +215,35 @@ bool CrossTileSymbolLayerIndex::addBucket(const OverscaledTileID& tileID,
 
     auto& thisZoomUsedCrossTileIDs = usedCrossTileIDs[tileID.overscaledZ];
 
+    std::vector<std::size_t> keyHashes;
+    keyHashes.reserve(bucket.symbolInstances.size());
+    for (const auto& symbolInstance : bucket.symbolInstances) {
+        keyHashes.push_back(std::hash<std::u16string>()(symbolInstance.key));
+    }
+
+    std::vector<const TileLayerIndex*> childIndexes;
     for (auto& it : indexes) {
         auto zoom = it.first;
         const auto& zoomIndexes = it.second;
         if (zoom > tileID.overscaledZ) {
+            childIndexes.clear();
             for (auto& childIndex : zoomIndexes) {
                 if (childIndex.second.coord.isChildOf(tileID)) {
-                    childIndex.second.findMatches(bucket, tileID, thisZoomUsedCrossTileIDs);
+                    childIndexes.push_back(&childIndex.second);
                 }
             }
+            // Match against the children in a stable order.
+            std::sort(childIndexes.begin(), childIndexes.end(), [](const auto* a, const auto* b) {
+                return a->coord < b->coord;
+            });
+            for (const auto* childIndex : childIndexes) {
+                childIndex->findMatches(bucket, keyHashes, tileID, thisZoomUsedCrossTileIDs);
+            }
         } else {
             auto parentTileID = tileID.scaledTo(zoom);
             auto parentIndex = zoomIndexes.find(parentTileID);
             if (parentIndex != zoomIndexes.end()) {
-                parentIndex->second.findMatches(bucket, tileID, thisZoomUsedCrossTileIDs);
+                parentIndex->second.findMatches(bucket, keyHashes, tileID, thisZoomUsedCrossTileIDs);
             }
         }
     }
@@ -179,15 +260,14 @@ bool CrossTileSymbolLayerIndex::addBucket(const OverscaledTileID& tileID,
     thisZoomIndexes.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(tileID),
-        std::forward_as_tuple(tileID, bucket.symbolInstances, bucket.bucketInstanceId, bucket.bucketLeaderID));
+        std::forward_as_tuple(tileID, bucket.symbolInstances, keyHashes, bucket.bucketInstanceId, bucket.bucketLeaderID));
     return true;
 }
 
 void CrossTileSymbolLayerIndex::removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket) {
-    for (const auto& key : removedBucket.indexedSymbolInstances) {
-        for (auto indexedSymbolInstance : key.second) {
-            usedCrossTileIDs[zoom].erase(indexedSymbolInstance.crossTileID);
-        }
+    auto& zoomCrossTileIDs = usedCrossTileIDs[zoom];
+    for (const auto& indexedSymbolInstance : removedBucket.indexedSymbolInstances) {
+        zoomCrossTileIDs.erase(indexedSymbolInstance.crossTileID);
     }
 }
 
@@ -209,7 +289,7 @@ bool CrossTileSymbolLayerIndex::removeStaleBuckets(const std::unordered_set<uint
 
 CrossTileSymbolIndex::CrossTileSymbolIndex() = default;
 
-auto CrossTileSymbolIndex::addLayer(const RenderLayer& layer, float lng) -> AddLayerResult {
+auto CrossTileSymbolIndex::addLayer(const RenderLayer& layer, float lng, bool keepIndexedSymbols) -> AddLayerResult {
     auto found = layerIndexes.find(layer.getID());
     if (found == layerIndexes.end()) {
         found = layerIndexes
@@ -224,11 +304,11 @@ auto CrossTileSymbolIndex::addLayer(const RenderLayer& layer, float lng) -> AddL
     std::unordered_set<uint32_t> currentBucketIDs;
 
     layerIndex.handleWrapJump(lng);
+    layerIndex.setKeepIndexedSymbols(keepIndexedSymbols);
 
     for (const auto& item : layer.getPlacementData()) {
-        const RenderTile& renderTile = item.tile;
-        Bucket& bucket = item.bucket;
-        auto pair = bucket.registerAtCrossTileIndex(layerIndex, renderTile);
+        const PlacementTile& renderTile = item.tile;
+        auto pair = item.bucket->registerAtCrossTileIndex(layerIndex, renderTile);
         assert(pair.first != 0u);
         if (pair.second) result |= AddLayerResult::BucketsAdded;
         currentBucketIDs.insert(pair.first);
@@ -12,6 +12,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mbgl {
@@ -22,28 +23,55 @@ class SymbolBucket;
 
 class IndexedSymbolInstance {
 public:
-    IndexedSymbolInstance(uint32_t crossTileID_, Point<int64_t> coord_)
-        : crossTileID(crossTileID_), coord(coord_)
-    {}
+    IndexedSymbolInstance(uint32_t crossTileID_, Point<int64_t> coord_, uint32_t keyIndex_)
+        : crossTileID(crossTileID_), coord(coord_), keyIndex(keyIndex_) {}
 
     uint32_t crossTileID;
     Point<int64_t> coord;
+    // Index of the symbol key in `TileLayerIndex::keys`.
+    uint32_t keyIndex;
 };
 
 class TileLayerIndex {
 public:
+    // `keyHashes` are the hashes of the symbol keys, in the symbols order.
     TileLayerIndex(OverscaledTileID coord,
                    std::vector<SymbolInstance>&,
+                   const std::vector<std::size_t>& keyHashes,
                    uint32_t bucketInstanceId,
                    std::string bucketLeaderId);
 
     Point<int64_t> getScaledCoordinates(SymbolInstance&, const OverscaledTileID&) const;
-    void findMatches(SymbolBucket&, const OverscaledTileID&, std::set<uint32_t>&) const;
+    void findMatches(SymbolBucket&,
+                     const std::vector<std::size_t>& keyHashes,
+                     const OverscaledTileID&,
+                     std::unordered_set<uint32_t>&) const;
 
     OverscaledTileID coord;
     uint32_t bucketInstanceId;
     std::string bucketLeaderId;
-    std::map<std::u16string,std::vector<IndexedSymbolInstance>> indexedSymbolInstances;
+    // The indexed symbols, in the bucket order.
+    std::vector<IndexedSymbolInstance> indexedSymbolInstances;
+    // The distinct symbol keys of the bucket.
+    std::vector<std::u16string> keys;
+
+private:
+    // The symbols are hashed by their key and by their quantized coordinates, so that
+    // the matching symbols are looked up in the nearby cells only.
+    struct Cell {
+        std::size_t keyHash;
+        int64_t x;
+        int64_t y;
+        bool operator==(const Cell& other) const {
+            return keyHash == other.keyHash && x == other.x && y == other.y;
+        }
+    };
+    struct CellHash {
+        std::size_t operator()(const Cell&) const;
+    };
+    // The last symbol inserted into a cell; the other symbols of the cell are chained by `nextInCell`.
+    std::unordered_map<Cell, uint32_t, CellHash> cells;
+    std::vector<uint32_t> nextInCell;
 };
 
 class CrossTileSymbolLayerIndex {
@@ -52,13 +80,16 @@ public:
     bool addBucket(const OverscaledTileID&, const mat4& tileMatrix, SymbolBucket&);
     bool removeStaleBuckets(const std::unordered_set<uint32_t>& currentIDs);
     void handleWrapJump(float newLng);
+    // While set, the symbols of the already indexed buckets keep their cross-tile IDs.
+    void setKeepIndexedSymbols(bool keep) { keepIndexedSymbols = keep; }
 private:
     void removeBucketCrossTileIDs(uint8_t zoom, const TileLayerIndex& removedBucket);
 
-    std::map<uint8_t, std::map<OverscaledTileID,TileLayerIndex>> indexes;
-    std::map<uint8_t, std::set<uint32_t>> usedCrossTileIDs;
+    std::map<uint8_t, std::unordered_map<OverscaledTileID, TileLayerIndex>> indexes;
+    std::map<uint8_t, std::unordered_set<uint32_t>> usedCrossTileIDs;
     float lng = 0;
     uint32_t& maxCrossTileID;
+    bool keepIndexedSymbols = false;
 };
 
 class CrossTileSymbolIndex {
@@ -71,7 +102,10 @@ public:
         BucketsRemoved = 1 << 1
     };
 
-    AddLayerResult addLayer(const RenderLayer& layer, float lng);
+    // If `keepIndexedSymbols` is `true`, only the new buckets get indexed and the symbols of the already
+    // indexed buckets keep their cross-tile IDs, so that these buckets can be read by a pending asynchronous
+    // placement meanwhile.
+    AddLayerResult addLayer(const RenderLayer& layer, float lng, bool keepIndexedSymbols = false);
     void pruneUnusedLayers(const std::set<std::string>&);
 
     void reset();
@@ -1,4 +1,6 @@
+#include <limits>
 #include <list>
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -64,12 +66,13 @@ using namespace style;
 // PlacementContext implemenation
 class PlacementContext {
     std::reference_wrapper<const SymbolBucket> bucket;
-    std::reference_wrapper<const RenderTile> renderTile;
+    std::reference_wrapper<const PlacementTile> renderTile;
     std::reference_wrapper<const TransformState> state;
 
 public:
     PlacementContext(const SymbolBucket& bucket_,
-                     const RenderTile& renderTile_,
+                     const PlacementTile& renderTile_,
+                     bool justReloaded_,
                      const TransformState& state_,
                      float placementZoom,
                      CollisionGroups::CollisionGroup collisionGroup_,
@@ -77,6 +80,7 @@ public:
         : bucket(bucket_),
           renderTile(renderTile_),
           state(state_),
+          justReloaded(justReloaded_),
           pixelsToTileUnits(renderTile_.id.pixelsToTileUnits(1, placementZoom)),
           scale(std::pow(2, placementZoom - getOverscaledID().overscaledZ)),
           pixelRatio(util::tileSize * getOverscaledID().overscaleFactor() / util::EXTENT),
@@ -87,7 +91,7 @@ public:
 
     const SymbolBucket& getBucket() const { return bucket.get(); }
     const style::SymbolLayoutProperties::PossiblyEvaluated& getLayout() const { return *getBucket().layout; }
-    const RenderTile& getRenderTile() const { return renderTile.get(); }
+    const PlacementTile& getRenderTile() const { return renderTile.get(); }
 
     const OverscaledTileID& getOverscaledID() const { return renderTile.get().getOverscaledTileID(); }
 
@@ -97,6 +101,8 @@ public:
         return getLayout().get<style::TextVariableAnchor>();
     }
 
+    // Whether the bucket was just reloaded, as seen when the placement data was collected.
+    bool justReloaded;
     float pixelsToTileUnits;
     float scale;
     float pixelRatio;
@@ -150,6 +156,11 @@ public:
 
 PlacementController::PlacementController() : placement(makeMutable<Placement>()) {}
 
+PlacementController::~PlacementController() {
+    // The pending placement is reading the retained buckets.
+    if (pendingPlacement.valid()) pendingPlacement.wait();
+}
+
 void PlacementController::setPlacement(Immutable<Placement> placement_) {
     placement = std::move(placement_);
     stale = false;
@@ -171,6 +182,46 @@ bool PlacementController::hasTransitions(TimePoint now) const {
     return placement->hasTransitions(now);
 }
 
+void PlacementController::placeAsync(Mutable<Placement> newPlacement,
+                                     const RenderLayerReferences& layers,
+                                     std::function<void()> onReady) {
+    assert(!hasPendingPlacement());
+    assert(Scheduler::GetCurrent());
+    auto layersData = std::make_shared<std::vector<LayerPlacementData>>();
+    layersData->reserve(layers.size());
+    for (const RenderLayer& layer : layers) {
+        layersData->push_back(layer.getPlacementData());
+    }
+
+    // The task does not share the placement data ownership, as the last reference to a bucket
+    // must not be released on a background thread.
+    auto task = std::make_shared<std::packaged_task<Immutable<Placement>()>>(
+        [placement_ = std::move(newPlacement), data = layersData.get()]() mutable -> Immutable<Placement> {
+            placement_->placeLayers(*data);
+            return std::move(placement_);
+        });
+    pendingPlacement = task->get_future();
+    pendingPlacementData = std::move(layersData);
+
+    if (!threadPool) threadPool = Scheduler::GetBackground();
+    threadPool->schedule(
+        [task, notifyReady = Scheduler::GetCurrent()->bindOnce(std::move(onReady))] {
+            (*task)();
+            notifyReady();
+        });
+}
+
+bool PlacementController::commitAsyncPlacement() {
+    if (!pendingPlacement.valid() ||
+        pendingPlacement.wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
+        return false;
+    }
+
+    setPlacement(pendingPlacement.get());
+    pendingPlacementData.reset();
+    return true;
+}
+
 // Placement implementation
 
 Placement::Placement(std::shared_ptr<const UpdateParameters> updateParameters_,
@@ -186,6 +237,27 @@ Placement::Placement(std::shared_ptr<const UpdateParameters> updateParameters_,
     if (prevPlacement) {
         prevPlacement->get()->prevPlacement = nullopt; // Only hold on to one placement back
     }
+    // The symbol collision boxes are projected to the viewport, so the symbol placements can only be
+    // reused by a placement with the same camera, or with a camera that only panned in a non-tilted view.
+    retainSymbolPlacements = updateParameters->mode == MapMode::Continuous && !showCollisionBoxes && !isTiltedView();
+    if (retainSymbolPlacements && prevPlacement && getPrevPlacement()->updateParameters) {
+        const Placement& prev = *getPrevPlacement();
+        const TransformState& state = updateParameters->transformState;
+        const TransformState& prevState = prev.updateParameters->transformState;
+        const bool panOnly = prevState.getSize() == state.getSize() && prevState.getZoom() == state.getZoom() &&
+                             prevState.getBearing() == state.getBearing() &&
+                             prevState.getFieldOfView() == state.getFieldOfView();
+        // While the camera zooms or rotates, the next placement can't reuse this one either.
+        retainSymbolPlacements = panOnly;
+        reusePrevPlacement = panOnly && prev.retainSymbolPlacements &&
+                             prev.updateParameters->crossSourceCollisions == updateParameters->crossSourceCollisions;
+        if (reusePrevPlacement && prevState.getProjectionMatrix() != state.getProjectionMatrix()) {
+            const LatLng center = state.getLatLng();
+            const ScreenCoordinate prevPoint = prevState.latLngToScreenCoordinate(center);
+            const ScreenCoordinate point = state.latLngToScreenCoordinate(center);
+            reuseOffset = {float(point.x - prevPoint.x), float(point.y - prevPoint.y)};
+        }
+    }
 }
 
 Placement::Placement() : collisionIndex({}, MapMode::Static), collisionGroups(true) {}
@@ -193,18 +265,254 @@ Placement::Placement() : collisionIndex({}, MapMode::Static), collisionGroups(tr
 Placement::~Placement() = default;
 
 void Placement::placeLayers(const RenderLayerReferences& layers) {
+    std::vector<std::reference_wrapper<const LayerPlacementData>> layersData;
+    layersData.reserve(layers.size());
+    for (const RenderLayer& layer : layers) {
+        layersData.emplace_back(layer.getPlacementData());
+    }
+    prepareIncrementalPlacement(layersData);
     for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+        std::set<uint32_t> seenCrossTileIDs;
+        placeLayer(it->get().getPlacementData(), seenCrossTileIDs);
+    }
+    commit();
+}
+
+void Placement::placeLayers(const std::vector<LayerPlacementData>& layersData) {
+    prepareIncrementalPlacement(
+        std::vector<std::reference_wrapper<const LayerPlacementData>>(layersData.begin(), layersData.end()));
+    for (auto it = layersData.crbegin(); it != layersData.crend(); ++it) {
         std::set<uint32_t> seenCrossTileIDs;
         placeLayer(*it, seenCrossTileIDs);
     }
     commit();
 }
 
-void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCrossTileIDs) {
-    for (const BucketPlacementData& data : layer.getPlacementData()) {
-        Bucket& bucket = data.bucket;
-        bucket.place(*this, data, seenCrossTileIDs);
+void Placement::placeLayer(const LayerPlacementData& layerData, std::set<uint32_t>& seenCrossTileIDs) {
+    for (const BucketPlacementData& data : layerData) {
+        data.bucket->place(*this, data, seenCrossTileIDs);
+    }
+}
+
+namespace {
+
+std::pair<uint32_t, std::size_t> getBucketPlacementKey(const BucketPlacementData& data) {
+    return {static_cast<const SymbolBucket&>(*data.bucket).bucketInstanceId,
+            data.sortKeyRange ? data.sortKeyRange->start : 0u};
+}
+
+constexpr CollisionBoundaries kEmptyArea{{std::numeric_limits<float>::max(),
+                                          std::numeric_limits<float>::max(),
+                                          std::numeric_limits<float>::lowest(),
+                                          std::numeric_limits<float>::lowest()}};
+
+bool isEmptyArea(const CollisionBoundaries& area) {
+    return area[0] > area[2];
+}
+
+void extendArea(CollisionBoundaries& area, const std::vector<ProjectedCollisionBox>& projectedBoxes) {
+    for (const auto& projected : projectedBoxes) {
+        if (projected.isBox()) {
+            const auto& box = projected.box();
+            area = {{std::min(area[0], box.min.x),
+                     std::min(area[1], box.min.y),
+                     std::max(area[2], box.max.x),
+                     std::max(area[3], box.max.y)}};
+        } else if (projected.isCircle()) {
+            const auto& circle = projected.circle();
+            area = {{std::min(area[0], circle.center.x - circle.radius),
+                     std::min(area[1], circle.center.y - circle.radius),
+                     std::max(area[2], circle.center.x + circle.radius),
+                     std::max(area[3], circle.center.y + circle.radius)}};
+        }
+    }
+}
+
+CollisionBoundaries translateArea(const CollisionBoundaries& area, Point<float> offset) {
+    if (isEmptyArea(area)) return area;
+    return {{area[0] + offset.x, area[1] + offset.y, area[2] + offset.x, area[3] + offset.y}};
+}
+
+bool containsArea(const CollisionBoundaries& outer, const CollisionBoundaries& inner) {
+    return inner[0] >= outer[0] && inner[1] >= outer[1] && inner[2] < outer[2] && inner[3] < outer[3];
+}
+
+// Returns `true` if `b` overlaps `a`, the way `CollisionIndex::isOffscreen()` and `isInsideGrid()` test boxes.
+bool intersectsArea(const CollisionBoundaries& a, const CollisionBoundaries& b) {
+    return b[2] >= a[0] && b[0] < a[2] && b[3] >= a[1] && b[1] < a[3];
+}
+
+ProjectedCollisionBox translateBox(const ProjectedCollisionBox& projected, Point<float> offset) {
+    if (projected.isBox()) {
+        const auto& box = projected.box();
+        return {box.min.x + offset.x, box.min.y + offset.y, box.max.x + offset.x, box.max.y + offset.y};
+    }
+    if (projected.isCircle()) {
+        const auto& circle = projected.circle();
+        return {circle.center.x + offset.x, circle.center.y + offset.y, circle.radius};
+    }
+    return projected;
+}
+
+// The largest difference, in pixels, between a tile projection and the panned previous one, for
+// which the previous symbol placements of the tile are still reused.
+constexpr float kMaxPanError = 0.01f;
+
+// Returns `true` if both placements insert the same boxes into the collision index.
+bool insertSameBoxes(const RetainedSymbolPlacement& a, const RetainedSymbolPlacement& b) {
+    if (a.textFeature != b.textFeature || a.iconFeature != b.iconFeature) return false;
+    if (bool(a.variableOffset) != bool(b.variableOffset)) return false;
+    return !a.variableOffset || a.variableOffset->anchor == b.variableOffset->anchor;
+}
+
+} // namespace
+
+void Placement::prepareIncrementalPlacement(
+    const std::vector<std::reference_wrapper<const LayerPlacementData>>& layersData) {
+    if (!reusePrevPlacement) return;
+    const Placement& prev = *getPrevPlacement();
+    const Size size = collisionIndex.getTransformState().getSize();
+    const float padding = collisionIndex.getViewportPadding();
+    changedCollisionAreas.emplace(size.width + 2 * padding, size.height + 2 * padding, 25);
+
+    std::map<BucketPlacementKey, std::size_t> prevOrder;
+    for (std::size_t i = 0; i < prev.bucketPlacementOrder.size(); ++i) {
+        prevOrder.emplace(prev.bucketPlacementOrder[i], i);
+    }
+
+    // A symbol placement depends on the symbols placed before it, so the previous placements are
+    // reused only for the buckets, which keep their relative order.
+    std::set<BucketPlacementKey> placedBuckets;
+    optional<std::size_t> lastOrder;
+    for (auto it = layersData.crbegin(); it != layersData.crend(); ++it) {
+        for (const BucketPlacementData& data : it->get()) {
+            const BucketPlacementKey key = getBucketPlacementKey(data);
+            placedBuckets.insert(key);
+            auto found = prevOrder.find(key);
+            if (found == prevOrder.end()) continue;
+            if (lastOrder && found->second < *lastOrder) {
+                reorderedBuckets.insert(key);
+            } else {
+                lastOrder = found->second;
+            }
+        }
+    }
+
+    // The symbols of the removed and reordered buckets are not in the collision index
+    // anymore at their previous positions.
+    for (const auto& entry : prev.retainedBucketPlacements) {
+        if (placedBuckets.count(entry.first) == 0u || reorderedBuckets.count(entry.first) != 0u) {
+            for (const auto& symbol : entry.second->symbols) {
+                markChangedCollisionArea(translateArea(symbol.insertedArea, reuseOffset));
+            }
+        }
+    }
+}
+
+RetainedSymbolPlacement Placement::retainSymbolPlacement(const SymbolInstance& symbol,
+                                                         const JointPlacement& placement) {
+    const uint32_t crossTileID = symbol.crossTileID;
+    optional<VariableOffset> variableOffset;
+    auto foundOffset = variableOffsets.find(crossTileID);
+    if (foundOffset != variableOffsets.end()) variableOffset = foundOffset->second;
+    optional<style::TextWritingModeType> orientation;
+    auto foundOrientation = placedOrientations.find(crossTileID);
+    if (foundOrientation != placedOrientations.end()) orientation = foundOrientation->second;
+
+    CollisionBoundaries insertedArea = kEmptyArea;
+    std::vector<ProjectedCollisionBox> insertedTextBoxes;
+    std::vector<ProjectedCollisionBox> insertedIconBoxes;
+    if (insertedTextFeature) {
+        extendArea(insertedArea, textBoxes);
+        insertedTextBoxes = std::move(textBoxes);
+    }
+    if (insertedIconFeature) {
+        extendArea(insertedArea, iconBoxes);
+        insertedIconBoxes = std::move(iconBoxes);
+    }
+    return {&symbol,
+            crossTileID,
+            placement,
+            std::move(variableOffset),
+            orientation,
+            queriedArea,
+            insertedArea,
+            insertedTextFeature,
+            insertedIconFeature,
+            std::move(insertedTextBoxes),
+            std::move(insertedIconBoxes)};
+}
+
+bool Placement::canReuseSymbolPlacement(const RetainedSymbolPlacement& retained) const {
+    const CollisionBoundaries area = translateArea(retained.queriedArea, reuseOffset);
+    if (isEmptyArea(area)) return true;
+    if (collisionAreaChanged(area)) return false;
+    if (reuseOffset.x == 0.0f && reuseOffset.y == 0.0f) return true;
+
+    // After panning, a symbol gets the same placement if it was and still is entirely inside the
+    // collision grid, and if it was and still is either entirely on screen or entirely offscreen.
+    const Size size = collisionIndex.getTransformState().getSize();
+    const float padding = collisionIndex.getViewportPadding();
+    const CollisionBoundaries grid{{0.0f, 0.0f, size.width + 2 * padding, size.height + 2 * padding}};
+    const CollisionBoundaries viewport{{padding, padding, size.width + padding, size.height + padding}};
+    const CollisionBoundaries prevViewport = translateArea(viewport, reuseOffset);
+    if (!containsArea(grid, area) || !containsArea(translateArea(grid, reuseOffset), area)) return false;
+    if (containsArea(viewport, area) && containsArea(prevViewport, area)) return true;
+    return !intersectsArea(viewport, area) && !intersectsArea(prevViewport, area);
+}
+
+bool Placement::canReuseTileMatrix(const mat4& prevMatrix, const mat4& matrix) const {
+    if (reuseOffset.x == 0.0f && reuseOffset.y == 0.0f) return prevMatrix == matrix;
+    // The tile must be projected to the same screen area, moved by the camera pan.
+    const CollisionBoundaries prevBounds = collisionIndex.projectTileBoundaries(prevMatrix);
+    const CollisionBoundaries bounds = collisionIndex.projectTileBoundaries(matrix);
+    const CollisionBoundaries offset{{reuseOffset.x, reuseOffset.y, reuseOffset.x, reuseOffset.y}};
+    for (std::size_t i = 0; i < bounds.size(); ++i) {
+        if (std::abs(prevBounds[i] + offset[i] - bounds[i]) > kMaxPanError) return false;
+    }
+    return true;
+}
+
+RetainedSymbolPlacement Placement::translateSymbolPlacement(const RetainedSymbolPlacement& retained) const {
+    RetainedSymbolPlacement result = retained;
+    result.queriedArea = translateArea(retained.queriedArea, reuseOffset);
+    result.insertedArea = translateArea(retained.insertedArea, reuseOffset);
+    for (auto& box : result.textBoxes) box = translateBox(box, reuseOffset);
+    for (auto& box : result.iconBoxes) box = translateBox(box, reuseOffset);
+    return result;
+}
+
+void Placement::reuseSymbolPlacement(const RetainedSymbolPlacement& retained, const PlacementContext& ctx) {
+    ++stats.reusedSymbols;
+    const uint32_t bucketInstanceId = ctx.getBucket().bucketInstanceId;
+    if (retained.textFeature) {
+        collisionIndex.insertFeature(*retained.textFeature,
+                                     retained.textBoxes,
+                                     ctx.getLayout().get<TextIgnorePlacement>(),
+                                     bucketInstanceId,
+                                     ctx.collisionGroup.first);
     }
+    if (retained.iconFeature) {
+        collisionIndex.insertFeature(*retained.iconFeature,
+                                     retained.iconBoxes,
+                                     ctx.getLayout().get<IconIgnorePlacement>(),
+                                     bucketInstanceId,
+                                     ctx.collisionGroup.first);
+    }
+    if (retained.variableOffset) variableOffsets[retained.crossTileID] = *retained.variableOffset;
+    if (retained.orientation) placedOrientations[retained.crossTileID] = *retained.orientation;
+    placements.erase(retained.crossTileID);
+    placements.emplace(retained.crossTileID, retained.placement);
+}
+
+void Placement::markChangedCollisionArea(const CollisionBoundaries& area) {
+    if (!changedCollisionAreas || isEmptyArea(area)) return;
+    changedCollisionAreas->insert(0u, {{area[0], area[1]}, {area[2], area[3]}});
+}
+
+bool Placement::collisionAreaChanged(const CollisionBoundaries& area) const {
+    if (isEmptyArea(area)) return false;
+    return !changedCollisionAreas || changedCollisionAreas->hitTest({{area[0], area[1]}, {area[2], area[3]}});
 }
 
 namespace {
@@ -230,18 +538,23 @@ Point<float> calculateVariableLayoutOffset(style::SymbolAnchorType anchor,
 
 void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<uint32_t>& seenCrossTileIDs) {
     assert(updateParameters);
-    const auto& symbolBucket = static_cast<const SymbolBucket&>(params.bucket.get());
-    const RenderTile& renderTile = params.tile;
+    const auto& symbolBucket = static_cast<const SymbolBucket&>(*params.bucket);
+    const PlacementTile& renderTile = params.tile;
     PlacementContext ctx{symbolBucket,
                          params.tile,
+                         params.justReloaded,
                          collisionIndex.getTransformState(),
                          placementZoom,
                          collisionGroups.get(params.sourceId),
                          getAvoidEdges(symbolBucket, renderTile.matrix)};
-    for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
-        if (seenCrossTileIDs.count(symbol.crossTileID) != 0u) continue;
-        placeSymbol(symbol, ctx);
-        seenCrossTileIDs.insert(symbol.crossTileID);
+    if (!retainSymbolPlacements) {
+        for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
+            if (seenCrossTileIDs.count(symbol.crossTileID) != 0u) continue;
+            placeSymbol(symbol, ctx);
+            seenCrossTileIDs.insert(symbol.crossTileID);
+        }
+    } else {
+        placeRetainedSymbols(params, ctx, seenCrossTileIDs);
     }
 
     // As long as this placement lives, we have to hold onto this bucket's
@@ -252,8 +565,121 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
         std::forward_as_tuple(symbolBucket.bucketInstanceId, params.featureIndex, ctx.getOverscaledID()));
 }
 
+void Placement::placeRetainedSymbols(const BucketPlacementData& params,
+                                     const PlacementContext& ctx,
+                                     std::set<uint32_t>& seenCrossTileIDs) {
+    const PlacementTile& renderTile = params.tile;
+    const BucketPlacementKey key = getBucketPlacementKey(params);
+    bucketPlacementOrder.push_back(key);
+    const bool panned = reuseOffset.x != 0.0f || reuseOffset.y != 0.0f;
+
+    std::shared_ptr<const RetainedBucketPlacement> prevBucketPlacement;
+    if (reusePrevPlacement) {
+        const auto& prevPlacements = getPrevPlacement()->retainedBucketPlacements;
+        auto found = prevPlacements.find(key);
+        if (found != prevPlacements.end()) prevBucketPlacement = found->second;
+    }
+    // Line labels are projected along their lines, so panning changes more than their position.
+    if (prevBucketPlacement &&
+        (reorderedBuckets.count(key) != 0u || !canReuseTileMatrix(prevBucketPlacement->tileMatrix, renderTile.matrix) ||
+         (panned && ctx.placementType != SymbolPlacementType::Point) ||
+         prevBucketPlacement->heldForFade != renderTile.holdForFade() ||
+         prevBucketPlacement->justReloaded != params.justReloaded)) {
+        for (const auto& symbol : prevBucketPlacement->symbols) {
+            markChangedCollisionArea(translateArea(symbol.insertedArea, reuseOffset));
+        }
+        prevBucketPlacement.reset();
+    }
+
+    // The previous bucket placement is shared as long as all its symbols are reused for the same camera.
+    std::shared_ptr<RetainedBucketPlacement> bucketPlacement;
+    std::size_t reusedCount = 0u;
+    const auto getBucketPlacement = [&]() -> RetainedBucketPlacement& {
+        if (!bucketPlacement) {
+            bucketPlacement = std::make_shared<RetainedBucketPlacement>();
+            bucketPlacement->tileMatrix = renderTile.matrix;
+            bucketPlacement->heldForFade = renderTile.holdForFade();
+            bucketPlacement->justReloaded = params.justReloaded;
+            if (prevBucketPlacement) {
+                bucketPlacement->symbols = std::vector<RetainedSymbolPlacement>(
+                    prevBucketPlacement->symbols.begin(), prevBucketPlacement->symbols.begin() + reusedCount);
+            }
+        }
+        return *bucketPlacement;
+    };
+
+    std::size_t prevIndex = 0u;
+    for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
+        const RetainedSymbolPlacement* prevSymbolPlacement = nullptr;
+        if (prevBucketPlacement && prevIndex < prevBucketPlacement->symbols.size()) {
+            const auto& candidate = prevBucketPlacement->symbols[prevIndex];
+            if (candidate.symbolInstance == &symbol && candidate.crossTileID == symbol.crossTileID) {
+                prevSymbolPlacement = &candidate;
+                ++prevIndex;
+            }
+        }
+
+        if (seenCrossTileIDs.count(symbol.crossTileID) != 0u) {
+            if (prevSymbolPlacement) {
+                markChangedCollisionArea(translateArea(prevSymbolPlacement->insertedArea, reuseOffset));
+                getBucketPlacement();
+            }
+            continue;
+        }
+        seenCrossTileIDs.insert(symbol.crossTileID);
+
+        if (renderTile.holdForFade() || symbol.crossTileID == SymbolInstance::invalidCrossTileID()) {
+            placeSymbol(symbol, ctx);
+            continue;
+        }
+
+        if (prevSymbolPlacement && canReuseSymbolPlacement(*prevSymbolPlacement)) {
+            if (panned) {
+                RetainedSymbolPlacement moved = translateSymbolPlacement(*prevSymbolPlacement);
+                reuseSymbolPlacement(moved, ctx);
+                getBucketPlacement().symbols.push_back(std::move(moved));
+            } else {
+                reuseSymbolPlacement(*prevSymbolPlacement, ctx);
+                if (bucketPlacement) {
+                    bucketPlacement->symbols.push_back(*prevSymbolPlacement);
+                } else {
+                    ++reusedCount;
+                }
+            }
+            continue;
+        }
+
+        RetainedSymbolPlacement retained = retainSymbolPlacement(symbol, placeSymbol(symbol, ctx));
+        if (!prevSymbolPlacement || !insertSameBoxes(*prevSymbolPlacement, retained)) {
+            if (prevSymbolPlacement) {
+                markChangedCollisionArea(translateArea(prevSymbolPlacement->insertedArea, reuseOffset));
+            }
+            markChangedCollisionArea(retained.insertedArea);
+        }
+        getBucketPlacement().symbols.push_back(std::move(retained));
+    }
+
+    if (prevBucketPlacement) {
+        // The remaining symbols of the previous placement were not placed this time.
+        for (; prevIndex < prevBucketPlacement->symbols.size(); ++prevIndex) {
+            markChangedCollisionArea(translateArea(prevBucketPlacement->symbols[prevIndex].insertedArea, reuseOffset));
+            getBucketPlacement();
+        }
+    }
+
+    if (!bucketPlacement && prevBucketPlacement && !panned) {
+        retainedBucketPlacements[key] = std::move(prevBucketPlacement);
+    } else {
+        getBucketPlacement();
+        retainedBucketPlacements[key] = std::move(bucketPlacement);
+    }
+}
+
 JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext& ctx) {
     static const JointPlacement kUnplaced(false, false, false);
+    queriedArea = kEmptyArea;
+    insertedTextFeature = nullptr;
+    insertedIconFeature = nullptr;
     if (symbolInstance.crossTileID == SymbolInstance::invalidCrossTileID()) return kUnplaced;
 
     if (ctx.getRenderTile().holdForFade()) {
@@ -261,6 +687,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         // know yet if we have a duplicate in a parent tile that _should_ be placed.
         return kUnplaced;
     }
+    ++stats.placedSymbols;
     const SymbolBucket& bucket = ctx.getBucket();
     const mat4& posMatrix = ctx.getRenderTile().matrix;
     const auto& collisionGroup = ctx.collisionGroup;
@@ -327,6 +754,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                                                                  ctx.avoidEdges,
                                                                  collisionGroup.second,
                                                                  textBoxes);
+                extendArea(queriedArea, textBoxes);
                 if (placedFeature.first) {
                     placedOrientations.emplace(symbolInstance.crossTileID, orientation);
                 }
@@ -417,6 +845,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                                                                 ctx.avoidEdges,
                                                                 collisionGroup.second,
                                                                 textBoxes);
+                    extendArea(queriedArea, textBoxes);
 
                     if (doVariableIconPlacement) {
                         auto placedIconFeature =
@@ -434,6 +863,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                                                         ctx.avoidEdges,
                                                         collisionGroup.second,
                                                         iconBoxes);
+                        extendArea(queriedArea, iconBoxes);
                         iconBoxes.clear();
                         if (!placedIconFeature.first) continue;
                     }
@@ -535,6 +965,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         } else {
             placedIcon = placeIconFeature(symbolInstance.iconCollisionFeature);
         }
+        extendArea(queriedArea, iconBoxes);
         placeIcon = placedIcon.first;
         offscreen &= placedIcon.second;
     }
@@ -552,35 +983,25 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     }
 
     if (placeText) {
-        if (placedVerticalText.first && symbolInstance.verticalTextCollisionFeature) {
-            collisionIndex.insertFeature(*symbolInstance.verticalTextCollisionFeature,
-                                         textBoxes,
-                                         ctx.getLayout().get<TextIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        } else {
-            collisionIndex.insertFeature(symbolInstance.textCollisionFeature,
-                                         textBoxes,
-                                         ctx.getLayout().get<TextIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        }
+        insertedTextFeature = (placedVerticalText.first && symbolInstance.verticalTextCollisionFeature)
+                                  ? &*symbolInstance.verticalTextCollisionFeature
+                                  : &symbolInstance.textCollisionFeature;
+        collisionIndex.insertFeature(*insertedTextFeature,
+                                     textBoxes,
+                                     ctx.getLayout().get<TextIgnorePlacement>(),
+                                     bucket.bucketInstanceId,
+                                     collisionGroup.first);
     }
 
     if (placeIcon) {
-        if (placedVerticalIcon.first && symbolInstance.verticalIconCollisionFeature) {
-            collisionIndex.insertFeature(*symbolInstance.verticalIconCollisionFeature,
-                                         iconBoxes,
-                                         ctx.getLayout().get<IconIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        } else {
-            collisionIndex.insertFeature(symbolInstance.iconCollisionFeature,
-                                         iconBoxes,
-                                         ctx.getLayout().get<IconIgnorePlacement>(),
-                                         bucket.bucketInstanceId,
-                                         collisionGroup.first);
-        }
+        insertedIconFeature = (placedVerticalIcon.first && symbolInstance.verticalIconCollisionFeature)
+                                  ? &*symbolInstance.verticalIconCollisionFeature
+                                  : &symbolInstance.iconCollisionFeature;
+        collisionIndex.insertFeature(*insertedIconFeature,
+                                     iconBoxes,
+                                     ctx.getLayout().get<IconIgnorePlacement>(),
+                                     bucket.bucketInstanceId,
+                                     collisionGroup.first);
     }
 
     const bool hasIconCollisionCircleData = bucket.hasIconCollisionCircleData();
@@ -602,7 +1023,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     }
 
     JointPlacement result(
-        placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen || bucket.justReloaded);
+        placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen || ctx.justReloaded);
     placements.emplace(symbolInstance.crossTileID, result);
     newSymbolPlaced(symbolInstance, ctx, result, ctx.placementType, textBoxes, iconBoxes);
     return result;
@@ -625,7 +1046,7 @@ SymbolInstanceReferences getBucketSymbols(const SymbolBucket& bucket,
 } // namespace
 
 SymbolInstanceReferences Placement::getSortedSymbols(const BucketPlacementData& params, float) {
-    const auto& bucket = static_cast<const SymbolBucket&>(params.bucket.get());
+    const auto& bucket = static_cast<const SymbolBucket&>(*params.bucket);
     SymbolInstanceReferences sortedSymbols =
         getBucketSymbols(bucket, params.sortKeyRange, collisionIndex.getTransformState().getBearing());
     auto* previousPlacement = getPrevPlacement();
@@ -707,7 +1128,7 @@ void Placement::updateLayerBuckets(const RenderLayer& layer, const TransformStat
     std::set<uint32_t> seenCrossTileIDs;
     for (const auto& item : layer.getPlacementData()) {
         if (!item.sortKeyRange || item.sortKeyRange->isFirstRange()) {
-            item.bucket.get().updateVertices(*this, updateOpacities, state, item.tile, seenCrossTileIDs);
+            item.bucket->updateVertices(*this, updateOpacities, state, item.tile, seenCrossTileIDs);
         }
     }
 }
@@ -723,7 +1144,7 @@ Point<float> calculateVariableRenderShift(style::SymbolAnchorType anchor, float
 }
 } // namespace
 
-bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket, const TransformState& state, const RenderTile& tile) const {
+bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket, const TransformState& state, const PlacementTile& tile) const {
     using namespace style;
     const auto& layout = *bucket.layout;
     const bool alongLine = layout.get<SymbolPlacement>() != SymbolPlacementType::Point;
@@ -1291,7 +1712,7 @@ void TilePlacement::placeLayers(const RenderLayerReferences& layers) {
     // Populale intersections.
     populateIntersections = true;
     for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
-        placeLayer(*it, seenCrossTileIDs);
+        placeLayer(it->get().getPlacementData(), seenCrossTileIDs);
     }
 
     std::sort(intersections.begin(), intersections.end(), [](const Intersection& a, const Intersection& b) {
@@ -1328,7 +1749,7 @@ void TilePlacement::placeLayers(const RenderLayerReferences& layers) {
     // Place the rest labels.
     populateIntersections = false;
     for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
-        placeLayer(*it, seenCrossTileIDs);
+        placeLayer(it->get().getPlacementData(), seenCrossTileIDs);
     }
     commit();
 }
@@ -1345,7 +1766,7 @@ optional<CollisionBoundaries> TilePlacement::getAvoidEdges(const SymbolBucket& b
 
 void TilePlacement::placeSymbolBucket(const BucketPlacementData& params, std::set<uint32_t>& seen) {
     assert(updateParameters);
-    const auto& bucket = static_cast<const SymbolBucket&>(params.bucket.get());
+    const auto& bucket = static_cast<const SymbolBucket&>(*params.bucket);
     const auto& layout = *bucket.layout;
     if (!populateIntersections) {
         Placement::placeSymbolBucket(params, seen);
@@ -1355,9 +1776,10 @@ void TilePlacement::placeSymbolBucket(const BucketPlacementData& params, std::se
         // Collect intersection only for point placement.
         return;
     }
-    const RenderTile& renderTile = params.tile;
+    const PlacementTile& renderTile = params.tile;
     PlacementContext ctx{bucket,
                          params.tile,
+                         params.justReloaded,
                          collisionIndex.getTransformState(),
                          placementZoom,
                          collisionGroups.get(params.sourceId),
@@ -5,13 +5,17 @@
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/collision_index.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <future>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace mbgl {
 
+class Scheduler;
 class SymbolBucket;
+class PlacementTile;
 class SymbolInstance;
 using SymbolInstanceReferences = std::vector<std::reference_wrapper<const SymbolInstance>>;
 class UpdateParameters;
@@ -62,6 +66,35 @@ public:
     const bool skipFade;
 };
   
+// The placement of a symbol, retained so that the next placement can reuse it instead of
+// repeating the collision detection, if the collision index around the symbol did not change.
+class RetainedSymbolPlacement {
+public:
+    const SymbolInstance* symbolInstance;
+    uint32_t crossTileID;
+    JointPlacement placement;
+    optional<VariableOffset> variableOffset;
+    optional<style::TextWritingModeType> orientation;
+    // The area, which was tested against the collision index.
+    CollisionBoundaries queriedArea;
+    // The area covered by the boxes inserted into the collision index.
+    CollisionBoundaries insertedArea;
+    // The inserted features and their projected boxes; `nullptr` if not inserted.
+    const CollisionFeature* textFeature;
+    const CollisionFeature* iconFeature;
+    std::vector<ProjectedCollisionBox> textBoxes;
+    std::vector<ProjectedCollisionBox> iconBoxes;
+};
+
+class RetainedBucketPlacement {
+public:
+    mat4 tileMatrix;
+    bool heldForFade;
+    bool justReloaded;
+    // The placed symbols, in the placement order.
+    std::vector<RetainedSymbolPlacement> symbols;
+};
+
 struct RetainedQueryData {
     uint32_t bucketInstanceId;
     std::shared_ptr<FeatureIndex> featureIndex;
@@ -95,14 +128,36 @@ class PlacementContext;
 class PlacementController {
 public:
     PlacementController();
+    ~PlacementController();
     void setPlacement(Immutable<Placement>);
     const Immutable<Placement>& getPlacement() const { return placement; }
     void setPlacementStale() { stale = true; }
     bool placementIsRecent(TimePoint now, float zoom, optional<Duration> periodOverride = nullopt) const;
     bool hasTransitions(TimePoint now) const;
 
+    /**
+     * @brief Starts calculating the given placement for the given layers on the background thread pool.
+     *
+     * The placement data of the layers is copied, so the render layers and tiles can change meanwhile.
+     * The current placement is kept until `commitAsyncPlacement()` is called after the new placement
+     * is ready; `onReady` is invoked on the calling thread at that moment.
+     *
+     * Must be called on a thread with a current `Scheduler`.
+     */
+    void placeAsync(Mutable<Placement>, const RenderLayerReferences&, std::function<void()> onReady);
+
+    // Returns `true` if there is an asynchronous placement, which was not committed yet.
+    bool hasPendingPlacement() const { return pendingPlacement.valid(); }
+
+    // Makes the asynchronously calculated placement current; returns `false` if it is not ready yet.
+    bool commitAsyncPlacement();
+
 private:
     Immutable<Placement> placement;
+    std::future<Immutable<Placement>> pendingPlacement;
+    // Holds the buckets used by the pending placement, so that they are released on this thread.
+    std::shared_ptr<const std::vector<LayerPlacementData>> pendingPlacementData;
+    std::shared_ptr<Scheduler> threadPool;
     bool stale = false;
 };
 
@@ -119,6 +174,9 @@ public:
 
     virtual ~Placement();
     virtual void placeLayers(const RenderLayerReferences&);
+    // Places the given copies of the layers placement data, which are in the layers rendering order.
+    // Unlike the method above, does not access the render layers and can be called on any thread.
+    void placeLayers(const std::vector<LayerPlacementData>&);
     void updateLayerBuckets(const RenderLayer&, const TransformState&, bool updateOpacities) const;
     virtual float symbolFadeChange(TimePoint now) const;
     virtual bool hasTransitions(TimePoint now) const;
@@ -134,6 +192,7 @@ public:
     const JointPlacement* getSymbolPlacement(const SymbolInstance&) const;
 
     const RetainedQueryData& getQueryData(uint32_t bucketInstanceId) const;
+    const PlacementStats& getStats() const { return stats; }
 
     // Public constructors are required for makeMutable(), shall not be called directly.
     Placement();
@@ -143,7 +202,16 @@ protected:
     friend SymbolBucket;
     virtual void placeSymbolBucket(const BucketPlacementData&, std::set<uint32_t>& seenCrossTileIDs);
     JointPlacement placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext&);
-    void placeLayer(const RenderLayer&, std::set<uint32_t>&);
+    void placeLayer(const LayerPlacementData&, std::set<uint32_t>&);
+    void placeRetainedSymbols(const BucketPlacementData&, const PlacementContext&, std::set<uint32_t>&);
+    void prepareIncrementalPlacement(const std::vector<std::reference_wrapper<const LayerPlacementData>>&);
+    RetainedSymbolPlacement retainSymbolPlacement(const SymbolInstance&, const JointPlacement&);
+    void reuseSymbolPlacement(const RetainedSymbolPlacement&, const PlacementContext&);
+    bool canReuseSymbolPlacement(const RetainedSymbolPlacement&) const;
+    bool canReuseTileMatrix(const mat4& prevMatrix, const mat4& matrix) const;
+    RetainedSymbolPlacement translateSymbolPlacement(const RetainedSymbolPlacement&) const;
+    void markChangedCollisionArea(const CollisionBoundaries&);
+    bool collisionAreaChanged(const CollisionBoundaries&) const;
     virtual void commit();
     virtual void newSymbolPlaced(const SymbolInstance&,
                                  const PlacementContext&,
@@ -166,7 +234,7 @@ protected:
     }
 
     // Returns `true` if bucket vertices were updated; returns `false` otherwise.
-    bool updateBucketDynamicVertices(SymbolBucket&, const TransformState&, const RenderTile& tile) const;
+    bool updateBucketDynamicVertices(SymbolBucket&, const TransformState&, const PlacementTile& tile) const;
     void updateBucketOpacities(SymbolBucket&, const TransformState&, std::set<uint32_t>&) const;
     void markUsedJustification(SymbolBucket&,
                                style::TextVariableAnchorType,
@@ -196,9 +264,27 @@ protected:
     mutable optional<Immutable<Placement>> prevPlacement;
     bool showCollisionBoxes = false;
 
+    // Incremental placement: the symbol placements are retained for the next placement, which
+    // reuses them for the unchanged buckets, unless the collision index around a symbol changed.
+    using BucketPlacementKey = std::pair<uint32_t, std::size_t>; // bucket instance id, symbols range start
+    std::map<BucketPlacementKey, std::shared_ptr<const RetainedBucketPlacement>> retainedBucketPlacements;
+    std::vector<BucketPlacementKey> bucketPlacementOrder;
+    // The areas, where the collision index differs from the one of the previous placement.
+    optional<GridIndex<uint32_t>> changedCollisionAreas;
+    std::set<BucketPlacementKey> reorderedBuckets;
+    bool retainSymbolPlacements = false;
+    bool reusePrevPlacement = false;
+    // If the camera panned since the previous placement, the viewport offset of the previous symbol placements.
+    Point<float> reuseOffset{0.0f, 0.0f};
+
+    PlacementStats stats;
+
     // Cache being used by placeSymbol()
     std::vector<ProjectedCollisionBox> textBoxes;
     std::vector<ProjectedCollisionBox> iconBoxes;
+    CollisionBoundaries queriedArea;
+    const CollisionFeature* insertedTextFeature = nullptr;
+    const CollisionFeature* insertedIconFeature = nullptr;
     // Used for debug purposes.
     std::unordered_map<const CollisionFeature*, std::vector<ProjectedCollisionBox>> collisionCircles;
 };
@@ -1,5 +1,6 @@
 #include <mbgl/tile/custom_geometry_tile.hpp>
 #include <mbgl/tile/geojson_tile_data.hpp>
+#include <mbgl/tile/source_feature_query.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/actor/scheduler.hpp>
@@ -69,25 +70,12 @@ void CustomGeometryTile::setNecessity(TileNecessity newNecessity) {
     }
 }
 
-void CustomGeometryTile::querySourceFeatures(
-    std::vector<Feature>& result,
-    const SourceQueryOptions& queryOptions) {
-
+void CustomGeometryTile::querySourceFeatures(SourceFeatureQuery& query) {
     // Ignore the sourceLayer, there is only one
     auto layer = getData()->getLayer({});
 
     if (layer) {
-        auto featureCount = layer->featureCount();
-        for (std::size_t i = 0; i < featureCount; i++) {
-            auto feature = layer->getFeature(i);
-
-            // Apply filter, if any
-            if (queryOptions.filter && !(*queryOptions.filter)(style::expression::EvaluationContext { static_cast<float>(id.overscaledZ), feature.get() })) {
-                continue;
-            }
-
-            result.push_back(convertFeature(*feature, id.canonical));
-        }
+        query.addLayer(*layer, id);
     }
 }
 
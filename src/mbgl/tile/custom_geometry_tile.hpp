@@ -28,9 +28,7 @@ public:
 
     void setNecessity(TileNecessity) final;
 
-    void querySourceFeatures(
-        std::vector<Feature>& result,
-        const SourceQueryOptions&) override;
+    void querySourceFeatures(SourceFeatureQuery&) override;
 
 private:
     bool stale = true;
@@ -3,6 +3,7 @@
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/tile/geojson_tile_data.hpp>
+#include <mbgl/tile/source_feature_query.hpp>
 #include <utility>
 namespace mbgl {
 
@@ -28,24 +29,11 @@ void GeoJSONTile::updateData(std::shared_ptr<style::GeoJSONData> data_, bool nee
         });
 }
 
-void GeoJSONTile::querySourceFeatures(
-    std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
-
+void GeoJSONTile::querySourceFeatures(SourceFeatureQuery& query) {
     // Ignore the sourceLayer, there is only one
     if (auto tileData = getData()) {
         if (auto layer = tileData->getLayer({})) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
-
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(style::expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() })) {
-                    continue;
-                }
-
-                result.push_back(convertFeature(*feature, id.canonical));
-            }
+            query.addLayer(*layer, id);
         }
     }
 }
@@ -19,9 +19,7 @@ public:
 
     void updateData(std::shared_ptr<style::GeoJSONData> data, bool needsRelayout = false);
 
-    void querySourceFeatures(
-        std::vector<Feature>& result,
-        const SourceQueryOptions&) override;
+    void querySourceFeatures(SourceFeatureQuery&) override;
 
 private:
     std::shared_ptr<style::GeoJSONData> data;
@@ -18,6 +18,7 @@
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile_worker.hpp>
+#include <mbgl/tile/source_feature_query.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -76,16 +77,7 @@ optional<ImagePosition> GeometryTileRenderData::getPattern(const std::string& pa
 void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
     if (!layoutResult) return;
 
-    auto uploadFn = [&] (Bucket& bucket) {
-        if (bucket.needsUpload()) {
-            bucket.upload(uploadPass);
-        }
-    };
-
-    for (auto& entry : layoutResult->layerRenderData) {
-        uploadFn(*entry.second.bucket);
-    }
-
+    // The buckets are uploaded by the layers rendering them, see RenderLayer::uploadBuckets().
     assert(atlasTextures);
 
     if (layoutResult->glyphAtlasImage) {
@@ -319,11 +311,10 @@ float GeometryTile::getQueryPadding(const std::unordered_map<std::string, const
     return queryPadding;
 }
 
-void GeometryTile::queryRenderedFeatures(std::unordered_map<std::string, std::vector<Feature>>& result,
-                                         const GeometryCoordinates& queryGeometry, const TransformState& transformState,
-                                         const std::unordered_map<std::string, const RenderLayer*>& layers,
-                                         const RenderedQueryOptions& options, const mat4& projMatrix,
-                                         const SourceFeatureState& featureState) {
+void GeometryTile::prepareRenderedQuery(std::vector<FeatureIndexQuery>& queries,
+                                        const GeometryCoordinates& queryGeometry, const TransformState& transformState,
+                                        const std::unordered_map<std::string, const RenderLayer*>& layers,
+                                        const mat4& projMatrix) {
     if (!getData()) return;
 
     const float queryPadding = getQueryPadding(layers);
@@ -332,21 +323,22 @@ void GeometryTile::queryRenderedFeatures(std::unordered_map<std::string, std::ve
     transformState.matrixFor(posMatrix, id.toUnwrapped());
     matrix::multiply(posMatrix, projMatrix, posMatrix);
 
-    layoutResult->featureIndex->query(result, queryGeometry, transformState, posMatrix,
-                                      util::tileSize * id.overscaleFactor(),
-                                      std::pow(2, transformState.getZoom() - id.overscaledZ), options, id.toUnwrapped(),
-                                      layers, queryPadding * transformState.maxPitchScaleFactor(), featureState);
+    queries.push_back({layoutResult->featureIndex,
+                       queryGeometry,
+                       posMatrix,
+                       util::tileSize * id.overscaleFactor(),
+                       std::pow(2, transformState.getZoom() - id.overscaledZ),
+                       id.toUnwrapped(),
+                       queryPadding * transformState.maxPitchScaleFactor()});
 }
 
-void GeometryTile::querySourceFeatures(
-    std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
-
+void GeometryTile::querySourceFeatures(SourceFeatureQuery& query) {
     // Data not yet available, or tile is empty
     if (!getData()) {
         return;
     }
-    
+
+    const auto& options = query.getOptions();
     // No source layers, specified, nothing to do
     if (!options.sourceLayers) {
         Log::Warning(Event::General, "At least one sourceLayer required");
@@ -356,20 +348,8 @@ void GeometryTile::querySourceFeatures(
     for (const auto& sourceLayer : *options.sourceLayers) {
         // Go throught all sourceLayers, if any
         // to gather all the features
-        auto layer = getData()->getLayer(sourceLayer);
-        
-        if (layer) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
-
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(style::expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() })) {
-                    continue;
-                }
-
-                result.emplace_back(convertFeature(*feature, id.canonical));
-            }
+        if (auto layer = getData()->getLayer(sourceLayer)) {
+            query.addLayer(*layer, id);
         }
     }
 }
@@ -19,7 +19,7 @@ namespace mbgl {
 
 class GeometryTileData;
 class RenderLayer;
-class SourceQueryOptions;
+class SourceFeatureQuery;
 class TileParameters;
 class GlyphAtlas;
 class ImageAtlas;
@@ -51,15 +51,12 @@ public:
 
     bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override;
 
-    void queryRenderedFeatures(std::unordered_map<std::string, std::vector<Feature>>& result,
-                               const GeometryCoordinates& queryGeometry, const TransformState&,
-                               const std::unordered_map<std::string, const RenderLayer*>& layers,
-                               const RenderedQueryOptions& options, const mat4& projMatrix,
-                               const SourceFeatureState& featureState) override;
+    void prepareRenderedQuery(std::vector<FeatureIndexQuery>& queries,
+                              const GeometryCoordinates& queryGeometry, const TransformState&,
+                              const std::unordered_map<std::string, const RenderLayer*>& layers,
+                              const mat4& projMatrix) override;
 
-    void querySourceFeatures(
-        std::vector<Feature>& result,
-        const SourceQueryOptions&) override;
+    void querySourceFeatures(SourceFeatureQuery&) override;
 
     float getQueryPadding(const std::unordered_map<std::string, const RenderLayer*>&) override;
 
@@ -88,6 +88,9 @@ GeometryCollection convertGeometry(const Feature::geometry_type& geometryTileFea
 
 // convert from GeometryTileFeature to Feature (eventually we should eliminate GeometryTileFeature)
 Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&);
+// Same as above, but only with the given properties, which are looked up one by one instead of
+// copying all properties of the feature.
+Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&, const std::vector<std::string>& properties);
 
 // Fix up possibly-non-V2-compliant polygon geometry using angus clipper.
 // The result is guaranteed to have correctly wound, strictly simple rings.
@@ -18,6 +18,7 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/parallel_for.hpp>
 #include <mbgl/util/stopwatch.hpp>
 
 #include <unordered_set>
@@ -456,24 +457,59 @@ void GeometryTileWorker::finalizeLayout() {
         GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
         glyphAtlasImage = std::move(glyphAtlas.image);
 
-        for (auto& layout : layouts) {
+        // Layouts only touch their own state while preparing symbols, so the layouts of a tile are
+        // processed in parallel. Layouts that also write the shared feature index create their
+        // buckets afterwards, in the original order.
+        // The layouts still allocate from the global heap: a per-tile arena would need allocator
+        // aware symbol instances, quads and strings throughout SymbolBucket.
+        std::vector<std::unordered_map<std::string, LayerRenderData>> layoutRenderData(layouts.size());
+        std::shared_ptr<Scheduler> scheduler = Scheduler::GetBackground();
+        util::parallelFor(*scheduler, layouts.size(), [&](std::size_t i) {
             if (obsolete) {
                 return;
             }
 
+            auto& layout = layouts[i];
             layout->prepareSymbols(glyphMap, glyphAtlas.positions, imageMap, iconAtlas.iconPositions);
 
-            if (!layout->hasSymbolInstances()) {
-                continue;
+            if (!layout->canCreateBucketInParallel()) {
+                return;
+            }
+
+            if (layout->hasSymbolInstances()) {
+                layout->createBucket(iconAtlas.patternPositions,
+                                     featureIndex,
+                                     layoutRenderData[i],
+                                     firstLoad,
+                                     showCollisionBoxes,
+                                     id.canonical);
+            }
+
+            // Release the transient layout data right after bucket creation, on the thread that
+            // allocated it.
+            layout.reset();
+        });
+
+        for (std::size_t i = 0; i < layouts.size(); ++i) {
+            if (obsolete) {
+                return;
             }
 
-            // layout adds the bucket to buckets
-            layout->createBucket(
-                iconAtlas.patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
+            auto& layout = layouts[i];
+            if (layout && layout->hasSymbolInstances()) {
+                // layout adds the bucket to buckets
+                layout->createBucket(
+                    iconAtlas.patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
+            }
+
+            for (auto& pair : layoutRenderData[i]) {
+                renderData.emplace(pair.first, std::move(pair.second));
+            }
         }
     }
 
     layouts.clear();
+    featureIndex->finish();
 
     firstLoad = false;
     
@@ -108,6 +108,7 @@ void RasterDEMTile::backfillBorder(const RasterDEMTile& borderTile, const DEMTil
         this->neighboringTiles = this->neighboringTiles | mask;
         // mark HillshadeBucket.prepared as false so it runs through the prepare render pass
         // with the new texture data we just backfilled
+        bucket->setDEMDataChanged();
         bucket->setPrepared(false);
     }
 }
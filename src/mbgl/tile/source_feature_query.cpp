@@ -0,0 +1,41 @@
+#include <mbgl/tile/source_feature_query.hpp>
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/hash.hpp>
+
+namespace mbgl {
+
+SourceFeatureQuery::SourceFeatureQuery(const SourceQueryOptions& options_, Callback callback_)
+    : options(options_), callback(std::move(callback_)) {}
+
+std::size_t SourceFeatureQuery::FeatureIDHash::operator()(const FeatureIdentifier& id) const {
+    std::size_t seed = util::hash(id.which());
+    id.match([](const NullValue&) {}, [&](const auto& value) { util::hash_combine(seed, value); });
+    return seed;
+}
+
+void SourceFeatureQuery::addLayer(const GeometryTileLayer& layer, const OverscaledTileID& tileID) {
+    auto* layerFeatureIDs = options.deduplicate ? &featureIDs[layer.getName()] : nullptr;
+    const auto zoom = static_cast<float>(tileID.overscaledZ);
+    const std::size_t featureCount = layer.featureCount();
+    for (std::size_t i = 0; i < featureCount; ++i) {
+        const auto feature = layer.getFeature(i);
+
+        if (options.filter && !(*options.filter)(style::expression::EvaluationContext{zoom, feature.get()})) {
+            continue;
+        }
+
+        if (layerFeatureIDs) {
+            auto featureID = feature->getID();
+            if (!featureID.is<NullValue>() && !layerFeatureIDs->insert(std::move(featureID)).second) {
+                continue;
+            }
+        }
+
+        callback(options.properties ? convertFeature(*feature, tileID.canonical, *options.properties)
+                                    : convertFeature(*feature, tileID.canonical));
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mbgl {
+
+class GeometryTileLayer;
+class OverscaledTileID;
+class SourceQueryOptions;
+
+// Queries the features of the tiles of a source, and passes them to a callback one by one as they
+// are converted, rather than collecting them.
+class SourceFeatureQuery {
+public:
+    using Callback = std::function<void(Feature)>;
+
+    SourceFeatureQuery(const SourceQueryOptions&, Callback);
+
+    const SourceQueryOptions& getOptions() const { return options; }
+
+    // Converts the features of a source layer of the given tile that match the query. Features
+    // are filtered, and deduplicated if requested, before they are converted.
+    void addLayer(const GeometryTileLayer&, const OverscaledTileID&);
+
+private:
+    struct FeatureIDHash {
+        std::size_t operator()(const FeatureIdentifier&) const;
+    };
+
+    const SourceQueryOptions& options;
+    const Callback callback;
+    // The IDs of the features that were already returned, per source layer, if they are
+    // deduplicated. IDs of different types, e.g. 1 and "1", belong to different features.
+    std::unordered_map<std::string, std::unordered_set<FeatureIdentifier, FeatureIDHash>> featureIDs;
+};
+
+} // namespace mbgl
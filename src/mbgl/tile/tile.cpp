@@ -38,16 +38,13 @@ void Tile::dumpDebugLogs() const {
     Log::Info(Event::General, "Tile::complete: %s", isComplete() ? "yes" : "no");
 }
 
-void Tile::queryRenderedFeatures(std::unordered_map<std::string, std::vector<Feature>>&, const GeometryCoordinates&,
-                                 const TransformState&, const std::unordered_map<std::string, const RenderLayer*>&,
-                                 const RenderedQueryOptions&, const mat4&, const SourceFeatureState&) {}
+void Tile::prepareRenderedQuery(std::vector<FeatureIndexQuery>&, const GeometryCoordinates&, const TransformState&,
+                                const std::unordered_map<std::string, const RenderLayer*>&, const mat4&) {}
 
 float Tile::getQueryPadding(const std::unordered_map<std::string, const RenderLayer*>&) {
     return 0;
 }
 
-void Tile::querySourceFeatures(
-        std::vector<Feature>&,
-        const SourceQueryOptions&) {}
+void Tile::querySourceFeatures(SourceFeatureQuery&) {}
 
 } // namespace mbgl
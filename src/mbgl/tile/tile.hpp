@@ -26,9 +26,9 @@ class TileObserver;
 class RenderLayer;
 class TileRenderData;
 class RenderedQueryOptions;
-class SourceQueryOptions;
+class SourceFeatureQuery;
 class CollisionIndex;
-class SourceFeatureState;
+struct FeatureIndexQuery;
 
 namespace gfx {
 class UploadPass;
@@ -82,15 +82,15 @@ public:
     virtual void setLayers(const std::vector<Immutable<style::LayerProperties>>&) {}
     virtual void setMask(TileMask&&) {}
 
-    virtual void queryRenderedFeatures(std::unordered_map<std::string, std::vector<Feature>>& result,
-                                       const GeometryCoordinates& queryGeometry, const TransformState&,
-                                       const std::unordered_map<std::string, const RenderLayer*>&,
-                                       const RenderedQueryOptions& options, const mat4& projMatrix,
-                                       const SourceFeatureState& featureState);
+    // Appends a query of the rendered features of this tile to `queries`, unless the tile has no
+    // features to query.
+    virtual void prepareRenderedQuery(std::vector<FeatureIndexQuery>& queries,
+                                      const GeometryCoordinates& queryGeometry, const TransformState&,
+                                      const std::unordered_map<std::string, const RenderLayer*>&,
+                                      const mat4& projMatrix);
 
-    virtual void querySourceFeatures(
-            std::vector<Feature>& result,
-            const SourceQueryOptions&);
+    // Passes the features of this tile that match the query to it.
+    virtual void querySourceFeatures(SourceFeatureQuery&);
 
     virtual float getQueryPadding(const std::unordered_map<std::string, const RenderLayer*>&);
 
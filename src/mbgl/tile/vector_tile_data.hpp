@@ -5,6 +5,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <utility>
 
 namespace mbgl {
@@ -49,7 +50,9 @@ public:
 
 private:
     std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
+    // Feature indexes read the data of rendered tiles from background threads while the render
+    // thread might read it too, so the layers are parsed at most once.
+    mutable std::once_flag parsed;
     mutable std::map<std::string, const protozero::data_view> layers;
 };
 
@@ -317,5 +317,6 @@ bool GridIndex<T>::empty() const {
 
 
 template class GridIndex<IndexedSubfeature>;
+template class GridIndex<uint32_t>;
 
 } // namespace mbgl
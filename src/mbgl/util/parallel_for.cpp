@@ -0,0 +1,82 @@
+#include <mbgl/util/parallel_for.hpp>
+
+#include <mbgl/actor/scheduler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+class ParallelJob {
+public:
+    ParallelJob(std::size_t count_, std::function<void(std::size_t)> fn_) : count(count_), fn(std::move(fn_)) {}
+
+    // Claims indices until none are left. Helpers that start after the work
+    // has been drained return immediately.
+    void run() {
+        std::size_t index;
+        while ((index = next++) < count) {
+            try {
+                fn(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++finished == count) cv.notify_all();
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return finished == count; });
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    const std::size_t count;
+    const std::function<void(std::size_t)> fn;
+    std::atomic<std::size_t> next{0};
+    std::size_t finished = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+// One helper per scheduler thread, but no more than the spare cores, since the
+// calling thread takes part in the work as well.
+std::size_t maxHelpers(const Scheduler& scheduler) {
+    const std::size_t concurrency = scheduler.getConcurrency();
+    const std::size_t cores = std::thread::hardware_concurrency();
+    return cores == 0 ? concurrency : std::min(concurrency, cores - 1);
+}
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler, std::size_t count, std::function<void(std::size_t)> fn) {
+    if (count == 0) return;
+    if (count == 1) {
+        fn(0);
+        return;
+    }
+
+    const std::size_t helpers = std::min(count - 1, maxHelpers(scheduler));
+    auto job = std::make_shared<ParallelJob>(count, std::move(fn));
+    for (std::size_t i = 0; i < helpers; ++i) {
+        scheduler.schedule([job] { job->run(); });
+    }
+    job->run();
+    job->wait();
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+// Invokes `fn` for every index in [0, count), spreading the calls over the
+// given scheduler. At most Scheduler::getConcurrency() helper tasks are
+// scheduled, and no more than the machine has spare cores. The calling thread takes part in the work and the call
+// returns once every index has been processed, so it is safe to call from a
+// task running on the same scheduler. The first exception thrown by `fn` is
+// rethrown on the calling thread.
+void parallelFor(Scheduler&, std::size_t count, std::function<void(std::size_t)> fn);
+
+} // namespace util
+} // namespace mbgl
@@ -55,6 +55,8 @@ public:
 
     mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
 
+    std::size_t getConcurrency() const override { return N; }
+
 private:
     std::array<std::thread, N> threads;
     mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
@@ -5,6 +5,7 @@
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
+#include <mbgl/style/layer.hpp>
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
@@ -318,6 +319,56 @@ TEST(Annotations, ImmediateRemoveShape) {
     test.frontend.render(test.map);
 }
 
+TEST(Annotations, SharedShapeLayers) {
+    AnnotationTest test;
+
+    auto shapeLayers = [&] {
+        std::vector<std::string> ids;
+        for (const auto* layer : test.map.getStyle().getLayers()) {
+            if (layer->getID().find("com.mapbox.annotations.shape.") == 0) {
+                ids.push_back(layer->getID());
+            }
+        }
+        return ids;
+    };
+
+    LineString<double> line = {{ { 0, 0 }, { 45, 45 } }};
+    Polygon<double> polygon = { {{ { 0, 0 }, { 0, 45 }, { 45, 45 }, { 45, 0 } }} };
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    AnnotationID first = test.map.addAnnotation(LineAnnotation { line, 1.0f, 2.0f, Color::red() });
+    AnnotationID second = test.map.addAnnotation(LineAnnotation { line, 0.5f, 5.0f, Color::green() });
+    test.map.addAnnotation(FillAnnotation { polygon, 0.5f, Color::blue() });
+    test.map.addAnnotation(LineAnnotation { line, 1.0f, 1.0f, Color::black() });
+    EXPECT_EQ(shapeLayers(), std::vector<std::string>({ "com.mapbox.annotations.shape.0",
+                                                        "com.mapbox.annotations.shape.2",
+                                                        "com.mapbox.annotations.shape.3" }));
+
+    // Annotations without constant paint properties need a layer of their own.
+    test.map.updateAnnotation(second, LineAnnotation { line, 0.5f, style::PropertyValue<float>(), Color::green() });
+    EXPECT_EQ(shapeLayers(), std::vector<std::string>({ "com.mapbox.annotations.shape.0",
+                                                        "com.mapbox.annotations.shape.1",
+                                                        "com.mapbox.annotations.shape.2",
+                                                        "com.mapbox.annotations.shape.3" }));
+
+    test.map.updateAnnotation(second, LineAnnotation { line, 0.5f, 5.0f, Color::green() });
+    EXPECT_EQ(shapeLayers(), std::vector<std::string>({ "com.mapbox.annotations.shape.0",
+                                                        "com.mapbox.annotations.shape.2",
+                                                        "com.mapbox.annotations.shape.3" }));
+
+    // The remaining annotations keep the layer, which is removed along with the last of them.
+    test.map.removeAnnotation(first);
+    EXPECT_EQ(shapeLayers(), std::vector<std::string>({ "com.mapbox.annotations.shape.0",
+                                                        "com.mapbox.annotations.shape.2",
+                                                        "com.mapbox.annotations.shape.3" }));
+
+    test.map.removeAnnotation(second);
+    EXPECT_EQ(shapeLayers(), std::vector<std::string>({ "com.mapbox.annotations.shape.2",
+                                                        "com.mapbox.annotations.shape.3" }));
+
+    test.frontend.render(test.map);
+}
+
 TEST(Annotations, SwitchStyle) {
     AnnotationTest test;
 
@@ -6,6 +6,7 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
@@ -94,6 +95,59 @@ TEST(Query, QueryRenderedFeatures) {
     EXPECT_EQ(features2.size(), 0u);
 }
 
+TEST(Query, QueryRenderedFeaturesRepeated) {
+    QueryTest test;
+
+    // Repeated queries reuse the features decoded by the first one.
+    auto point = test.map.pixelForLatLng({0, 0});
+    auto features1 = test.frontend.getRenderer()->queryRenderedFeatures(point);
+    auto features2 = test.frontend.getRenderer()->queryRenderedFeatures(point);
+    ASSERT_EQ(features1.size(), 4u);
+    ASSERT_EQ(features2.size(), 4u);
+    for (std::size_t i = 0; i < features1.size(); ++i) {
+        EXPECT_EQ(features1[i].id, features2[i].id);
+        EXPECT_EQ(features1[i].geometry, features2[i].geometry);
+        EXPECT_EQ(features1[i].properties, features2[i].properties);
+    }
+}
+
+TEST(Query, QueryRenderedFeaturesAsync) {
+    QueryTest test;
+
+    auto point = test.map.pixelForLatLng({0, 0});
+    const ScreenBox box{{point.x - 10, point.y - 10}, {point.x + 10, point.y + 10}};
+    const RenderedQueryOptions options({{{"layer1", "layer2", "layer4"}}, {}});
+    auto expectedPointFeatures = test.frontend.getRenderer()->queryRenderedFeatures(point, options);
+    auto expectedBoxFeatures = test.frontend.getRenderer()->queryRenderedFeatures(box);
+    ASSERT_EQ(expectedPointFeatures.size(), 3u);
+    ASSERT_FALSE(expectedBoxFeatures.empty());
+
+    optional<std::vector<Feature>> pointFeatures;
+    optional<std::vector<Feature>> boxFeatures;
+    test.frontend.getRenderer()->queryRenderedFeatures(
+        point, options, [&](std::vector<Feature> features) { pointFeatures = std::move(features); });
+    test.frontend.getRenderer()->queryRenderedFeatures(
+        box, {}, [&](std::vector<Feature> features) { boxFeatures = std::move(features); });
+    // Results are delivered on the run loop of the caller.
+    EXPECT_FALSE(pointFeatures);
+    EXPECT_FALSE(boxFeatures);
+
+    while (!pointFeatures || !boxFeatures) {
+        test.loop.runOnce();
+    }
+
+    const auto expectEqual = [](const std::vector<Feature>& actual, const std::vector<Feature>& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(actual[i].id, expected[i].id);
+            EXPECT_EQ(actual[i].geometry, expected[i].geometry);
+            EXPECT_EQ(actual[i].properties, expected[i].properties);
+        }
+    };
+    expectEqual(*pointFeatures, expectedPointFeatures);
+    expectEqual(*boxFeatures, expectedBoxFeatures);
+}
+
 TEST(Query, QueryRenderedFeaturesFilterLayer) {
     QueryTest test;
 
@@ -154,6 +208,44 @@ TEST(Query, QuerySourceFeatureStates) {
     ASSERT_EQ(newState, states);
 }
 
+TEST(Query, QuerySourceFeatureStatesBatched) {
+    QueryTest test;
+
+    FeatureStates newStates;
+    newStates["feature1"]["hover"] = true;
+    newStates["feature2"]["hover"] = false;
+    newStates["feature2"]["selected"] = true;
+    test.frontend.getRenderer()->setFeatureStates("source1", {}, newStates);
+
+    FeatureState states;
+    test.frontend.getRenderer()->getFeatureState(states, "source1", {}, "feature1");
+    EXPECT_EQ(newStates["feature1"], states);
+    test.frontend.getRenderer()->getFeatureState(states, "source1", {}, "feature2");
+    EXPECT_EQ(newStates["feature2"], states);
+
+    test.frontend.render(test.map);
+
+    // Changes made after the states were applied take precedence.
+    test.frontend.getRenderer()->setFeatureStates(
+        "source1", {}, FeatureStates{{"feature2", FeatureState{{"hover", true}}}});
+    test.frontend.getRenderer()->getFeatureState(states, "source1", {}, "feature2");
+    EXPECT_EQ((FeatureState{{"hover", true}, {"selected", true}}), states);
+
+    test.frontend.getRenderer()->removeFeatureState("source1", {}, "feature2", {"selected"s});
+    test.frontend.getRenderer()->removeFeatureState("source1", {}, "feature1", {});
+    test.frontend.render(test.map);
+
+    test.frontend.getRenderer()->getFeatureState(states, "source1", {}, "feature1");
+    EXPECT_TRUE(states.empty());
+    test.frontend.getRenderer()->getFeatureState(states, "source1", {}, "feature2");
+    EXPECT_EQ((FeatureState{{"hover", true}}), states);
+
+    test.frontend.getRenderer()->removeFeatureState("source1", {}, {}, {});
+    test.frontend.render(test.map);
+    test.frontend.getRenderer()->getFeatureState(states, "source1", {}, "feature2");
+    EXPECT_TRUE(states.empty());
+}
+
 TEST(Query, QuerySourceFeaturesOptionValidation) {
     QueryTest test;
 
@@ -188,6 +280,39 @@ TEST(Query, QuerySourceFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QuerySourceFeaturesProjection) {
+    QueryTest test;
+
+    const SourceQueryOptions options({}, {}, {{"key1", "key4", "unknown"}});
+    auto features = test.frontend.getRenderer()->querySourceFeatures("source4", options);
+    ASSERT_EQ(features.size(), 1u);
+    EXPECT_EQ(features[0].id, FeatureIdentifier{"feature1"s});
+    EXPECT_EQ(features[0].properties, (PropertyMap{{"key1", "value1"s}, {"key4", 0.5}}));
+}
+
+TEST(Query, QuerySourceFeaturesDeduplicated) {
+    QueryTest test;
+
+    // The line spans several tiles, and is returned once per tile unless deduplicated.
+    GeoJSONFeature line{LineString<double>{{-10, -10}, {10, 10}}};
+    line.id = "line"s;
+    auto source = std::make_unique<GeoJSONSource>("line_source"s);
+    source->setGeoJSON(GeoJSON{line});
+    test.map.getStyle().addSource(std::move(source));
+    test.map.getStyle().addLayer(std::make_unique<LineLayer>("line_layer"s, "line_source"s));
+    test.map.jumpTo(CameraOptions().withCenter(LatLng{0, 0}).withZoom(1.0));
+    test.frontend.render(test.map);
+
+    auto features = test.frontend.getRenderer()->querySourceFeatures("line_source");
+    EXPECT_GT(features.size(), 1u);
+
+    std::vector<Feature> streamed;
+    test.frontend.getRenderer()->querySourceFeatures(
+        "line_source", {{}, {}, {}, true}, [&](Feature feature) { streamed.push_back(std::move(feature)); });
+    ASSERT_EQ(streamed.size(), 1u);
+    EXPECT_EQ(streamed[0].id, FeatureIdentifier{"line"s});
+}
+
 TEST(Query, QueryFeatureExtensionsInvalidExtension) {
     QueryTest test;
 
@@ -0,0 +1,202 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/source_state.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/layers/fill_layer_properties.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/mat4.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+using StubFeatures = std::vector<StubGeometryTileFeature>;
+
+// Counts how many features are decoded from it.
+class StubGeometryTileLayer : public GeometryTileLayer {
+public:
+    StubGeometryTileLayer(std::shared_ptr<const StubFeatures> features_, std::shared_ptr<std::size_t> decoded_)
+        : features(std::move(features_)), decoded(std::move(decoded_)) {}
+
+    std::size_t featureCount() const override { return features->size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        ++*decoded;
+        return std::make_unique<StubGeometryTileFeature>(features->at(i));
+    }
+    std::string getName() const override { return "source-layer"; }
+
+private:
+    std::shared_ptr<const StubFeatures> features;
+    std::shared_ptr<std::size_t> decoded;
+};
+
+class StubGeometryTileData : public GeometryTileData {
+public:
+    explicit StubGeometryTileData(std::shared_ptr<const StubFeatures> features_)
+        : features(std::move(features_)), decoded(std::make_shared<std::size_t>(0)) {}
+
+    std::unique_ptr<GeometryTileData> clone() const override {
+        return std::make_unique<StubGeometryTileData>(*this);
+    }
+    std::unique_ptr<GeometryTileLayer> getLayer(const std::string&) const override {
+        return std::make_unique<StubGeometryTileLayer>(features, decoded);
+    }
+
+    std::shared_ptr<const StubFeatures> features;
+    std::shared_ptr<std::size_t> decoded;
+};
+
+// Accepts every feature that the spatial index returns.
+class StubRenderLayer final : public RenderLayer {
+public:
+    explicit StubRenderLayer(Immutable<LayerProperties> properties) : RenderLayer(std::move(properties)) {}
+
+    void transition(const TransitionParameters&) override {}
+    void evaluate(const PropertyEvaluationParameters&) override {}
+    bool hasTransition() const override { return false; }
+    bool hasCrossfade() const override { return false; }
+    void render(PaintParameters&) override {}
+
+    bool queryIntersectsFeature(const GeometryCoordinates&, const GeometryTileFeature&, const float,
+                                const TransformState&, const float, const mat4&, const FeatureState&) const override {
+        return true;
+    }
+};
+
+class FeatureIndexTest {
+public:
+    explicit FeatureIndexTest(StubFeatures features_)
+        : features(std::make_shared<const StubFeatures>(std::move(features_))),
+          renderLayer(makeMutable<FillLayerProperties>(
+              staticImmutableCast<FillLayer::Impl>(FillLayer("layer", "source").baseImpl))) {
+        auto data = std::make_unique<StubGeometryTileData>(features);
+        decoded = data->decoded;
+        featureIndex = std::make_unique<FeatureIndex>(std::move(data));
+        for (std::size_t i = 0; i < features->size(); ++i) {
+            featureIndex->insert((*features)[i].geometry, i, "source-layer", "layer");
+        }
+        featureIndex->finish();
+        featureIndex->setBucketLayerIDs("layer", { "layer" });
+        matrix::identity(posMatrix);
+    }
+
+    // Returns the IDs of the features whose bounding boxes intersect the box of the query geometry,
+    // in the order they are returned.
+    std::vector<uint64_t> query(const GeometryCoordinates& queryGeometry) const {
+        std::unordered_map<std::string, std::vector<Feature>> result;
+        featureIndex->query(result, queryGeometry, transformState, posMatrix, util::EXTENT, 1.0,
+                            RenderedQueryOptions(), UnwrappedTileID(0, 0, 0), { { "layer", &renderLayer } }, 0.0f,
+                            featureState);
+        std::vector<uint64_t> ids;
+        for (const auto& feature : result["layer"]) {
+            ids.push_back(feature.id.get<uint64_t>());
+        }
+        return ids;
+    }
+
+    std::shared_ptr<const StubFeatures> features;
+    std::shared_ptr<std::size_t> decoded;
+    std::unique_ptr<FeatureIndex> featureIndex;
+
+private:
+    StubRenderLayer renderLayer;
+    TransformState transformState;
+    mat4 posMatrix;
+    SourceFeatureState featureState;
+};
+
+StubGeometryTileFeature pointFeature(uint64_t id, int16_t x, int16_t y) {
+    return { id, FeatureType::Point, GeometryCollection{ { { x, y } } }, PropertyMap{} };
+}
+
+} // namespace
+
+TEST(FeatureIndex, MultiRingFeaturesAreReturnedOnceInReverseOrder) {
+    const GeometryCollection twoRings{ { { 0, 0 }, { 10, 0 }, { 10, 10 } }, { { 100, 100 }, { 110, 110 } } };
+    FeatureIndexTest test({
+        { uint64_t(0), FeatureType::LineString, twoRings, PropertyMap{} },
+        { uint64_t(1), FeatureType::LineString, { { { 5, 5 }, { 105, 105 } } }, PropertyMap{} },
+        { uint64_t(2), FeatureType::LineString, twoRings, PropertyMap{} },
+    });
+
+    // Both rings of the first and the last feature intersect the query.
+    EXPECT_EQ((std::vector<uint64_t>{ 2, 1, 0 }), test.query({ { 0, 0 }, { 200, 200 } }));
+    EXPECT_EQ((std::vector<uint64_t>{ 2, 1, 0 }), test.query({ { 5, 5 } }));
+    // Only the second rings intersect the query.
+    EXPECT_EQ((std::vector<uint64_t>{ 2, 0 }), test.query({ { 108, 108 } }));
+    EXPECT_TRUE(test.query({ { 50, 20 } }).empty());
+}
+
+TEST(FeatureIndex, QueryMatchesBruteForce) {
+    // Enough features for a tree that is several levels deep.
+    StubFeatures features;
+    for (int16_t y = 0; y < 64; ++y) {
+        for (int16_t x = 0; x < 64; ++x) {
+            features.push_back(pointFeature(features.size(), x * 128 + 8, y * 128 + 8));
+        }
+    }
+    // Outside of the tile; these are never indexed.
+    features.push_back(pointFeature(features.size(), -64, 100));
+    features.push_back(pointFeature(features.size(), util::EXTENT + 64, 100));
+    FeatureIndexTest test(std::move(features));
+
+    const std::vector<GeometryCoordinates> queries{
+        { { 0, 0 } },
+        { { 136, 136 } },
+        { { 100, 100 }, { 600, 300 } },
+        { { 4000, 200 }, { 4500, 4100 }, { 4200, 5000 } },
+        { { -200, 0 }, { 200, 8192 } },
+        { { 0, 0 }, { util::EXTENT, util::EXTENT } },
+    };
+    for (const auto& queryGeometry : queries) {
+        const auto box = mapbox::geometry::envelope(queryGeometry);
+        std::vector<uint64_t> expected;
+        for (auto it = test.features->rbegin(); it != test.features->rend(); ++it) {
+            const auto& point = it->geometry[0][0];
+            if (point.x >= 0 && point.y >= 0 && point.x < util::EXTENT && point.y < util::EXTENT &&
+                point.x >= box.min.x && point.x <= box.max.x && point.y >= box.min.y && point.y <= box.max.y) {
+                expected.push_back(it->id.get<uint64_t>());
+            }
+        }
+        EXPECT_EQ(expected, test.query(queryGeometry));
+    }
+}
+
+TEST(FeatureIndex, CacheEvictsLeastRecentlyUsedFeature) {
+    StubFeatures features;
+    for (std::size_t i = 0; i <= FeatureIndex::maxCachedFeatures; ++i) {
+        features.push_back(pointFeature(i, int16_t(i % 64 * 64), int16_t(i / 64 * 64)));
+    }
+    FeatureIndexTest test(std::move(features));
+    const auto queryFeature = [&](std::size_t i) {
+        const auto& point = (*test.features)[i].geometry[0][0];
+        EXPECT_EQ(std::vector<uint64_t>{ i }, test.query({ point }));
+    };
+
+    // Fill the cache.
+    for (std::size_t i = 0; i < FeatureIndex::maxCachedFeatures; ++i) {
+        queryFeature(i);
+    }
+    const std::size_t decoded = *test.decoded;
+    EXPECT_EQ(FeatureIndex::maxCachedFeatures, decoded);
+
+    // Cached features are not decoded again, and become the most recently used.
+    queryFeature(0);
+    EXPECT_EQ(decoded, *test.decoded);
+
+    // A new feature only evicts the least recently used one.
+    queryFeature(FeatureIndex::maxCachedFeatures);
+    EXPECT_EQ(decoded + 1, *test.decoded);
+    queryFeature(0);
+    queryFeature(2);
+    EXPECT_EQ(decoded + 1, *test.decoded);
+    queryFeature(1);
+    EXPECT_EQ(decoded + 2, *test.decoded);
+}
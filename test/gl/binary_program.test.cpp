@@ -0,0 +1,42 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gl/binary_program.hpp>
+#include <mbgl/programs/program_parameters.hpp>
+
+#include <stdexcept>
+
+using namespace mbgl;
+
+TEST(BinaryProgram, RoundTrip) {
+    const std::string code("\x01\x00\x02\x03", 4);
+    const gl::BinaryProgram original(0x8B41, std::string(code), "identifier");
+
+    const gl::BinaryProgram program(original.serialize());
+    EXPECT_EQ(0x8B41u, program.format());
+    EXPECT_EQ(code, program.code());
+    EXPECT_EQ("identifier", program.identifier());
+}
+
+TEST(BinaryProgram, Malformed) {
+    EXPECT_THROW(gl::BinaryProgram{std::string()}, std::runtime_error);
+    EXPECT_THROW(gl::BinaryProgram{std::string("\x0a\xff", 2)}, std::exception);
+
+    // A serialized program without code is rejected.
+    const gl::BinaryProgram empty(1, std::string(), "identifier");
+    EXPECT_THROW(gl::BinaryProgram{empty.serialize()}, std::runtime_error);
+}
+
+TEST(BinaryProgram, CachePath) {
+    const ProgramParameters uncached(1.0f, false);
+    EXPECT_FALSE(uncached.cachePath("fill", ""));
+
+    const ProgramParameters cached(1.0f, false, std::string("cache"));
+    const auto path = cached.cachePath("fill", "");
+    ASSERT_TRUE(path);
+    EXPECT_EQ(0u, path->find("cache/com.mapbox.gl.shader.fill."));
+
+    // Programs with different defines must not share a cache file.
+    EXPECT_NE(*path, *cached.cachePath("fill", "#define HAS_UNIFORM_u_color\n"));
+    EXPECT_NE(*path, *ProgramParameters(2.0f, false, std::string("cache")).cachePath("fill", ""));
+    EXPECT_NE(*path, *cached.cachePath("line", ""));
+}
@@ -2,12 +2,22 @@
 #include <mbgl/test/stub_geometry_tile_feature.hpp>
 
 #include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/upload_pass.hpp>
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/conversion/property_value.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/circle_layer_impl.hpp>
+#include <mbgl/style/layers/circle_layer_properties.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/layers/fill_layer_properties.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_backend.hpp>
@@ -40,6 +50,74 @@ namespace {
 
 PropertyMap properties;
 
+class StubVertexBufferResource : public gfx::VertexBufferResource {};
+class StubIndexBufferResource : public gfx::IndexBufferResource {};
+
+// Records the vertex buffer uploads instead of performing them.
+class RecordingUploadPass final : public gfx::UploadPass {
+public:
+    explicit RecordingUploadPass(gfx::Context& context_) : context(context_) {}
+
+    gfx::Context& getContext() override { return context; }
+
+    std::size_t createdVertexBuffers = 0;
+    // Offset and size in bytes of each partial vertex buffer update.
+    std::vector<std::pair<std::size_t, std::size_t>> vertexUpdates;
+
+private:
+    void pushDebugGroup(const char*) override {}
+    void popDebugGroup() override {}
+
+    std::unique_ptr<gfx::VertexBufferResource> createVertexBufferResource(const void*,
+                                                                          std::size_t,
+                                                                          gfx::BufferUsageType,
+                                                                          std::size_t) override {
+        ++createdVertexBuffers;
+        return std::make_unique<StubVertexBufferResource>();
+    }
+    void updateVertexBufferResource(gfx::VertexBufferResource&, const void*, std::size_t) override {}
+    void updateVertexBufferResourceRange(gfx::VertexBufferResource&,
+                                         std::size_t offset,
+                                         const void*,
+                                         std::size_t size) override {
+        vertexUpdates.emplace_back(offset, size);
+    }
+    std::unique_ptr<gfx::IndexBufferResource> createIndexBufferResource(const void*,
+                                                                        std::size_t,
+                                                                        gfx::BufferUsageType) override {
+        return std::make_unique<StubIndexBufferResource>();
+    }
+    void updateIndexBufferResource(gfx::IndexBufferResource&, const void*, std::size_t) override {}
+    std::unique_ptr<gfx::TextureResource> createTextureResource(Size,
+                                                                const void*,
+                                                                gfx::TexturePixelType,
+                                                                gfx::TextureChannelDataType) override {
+        return nullptr;
+    }
+    void updateTextureResource(
+        gfx::TextureResource&, Size, const void*, gfx::TexturePixelType, gfx::TextureChannelDataType) override {}
+    void updateTextureResourceSub(gfx::TextureResource&,
+                                  uint16_t,
+                                  uint16_t,
+                                  Size,
+                                  const void*,
+                                  gfx::TexturePixelType,
+                                  gfx::TextureChannelDataType) override {}
+
+    gfx::Context& context;
+};
+
+class StubGeometryTileLayer : public GeometryTileLayer {
+public:
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubGeometryTileFeature>(features[i]);
+    }
+    std::string getName() const override { return "layer"; }
+
+    std::vector<StubGeometryTileFeature> features;
+};
+
 } // namespace
 
 TEST(Buckets, CircleBucket) {
@@ -73,6 +151,63 @@ TEST(Buckets, CircleBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, CircleBucketFeatureStateUploadsDirtyRanges) {
+    gl::HeadlessBackend backend({ 512, 256 });
+    gfx::BackendScope scope { backend };
+    gl::Context context{ backend };
+
+    style::conversion::Error error;
+    const auto color = style::conversion::convertJSON<style::PropertyValue<Color>>(
+        R"(["to-color", ["coalesce", ["feature-state", "color"], "black"]])", error, true, false);
+    ASSERT_TRUE(color && color->isExpression()) << error.message;
+    style::CircleLayer layer("circle", "source");
+    style::CirclePaintProperties::PossiblyEvaluated evaluated;
+    evaluated.get<style::CircleColor>() = PossiblyEvaluatedPropertyValue<Color>(color->asExpression());
+    std::map<std::string, Immutable<style::LayerProperties>> layerProperties;
+    layerProperties.emplace("circle", makeMutable<style::CircleLayerProperties>(
+        staticImmutableCast<style::CircleLayer::Impl>(layer.baseImpl), evaluated));
+
+    StubGeometryTileLayer tileLayer;
+    for (const char* id : { "a", "b", "c", "d" }) {
+        tileLayer.features.emplace_back(std::string(id), FeatureType::Point, GeometryCollection{}, PropertyMap{});
+    }
+
+    // Every circle is a quad of four vertices, each with its own color vertex.
+    const std::size_t vertexSize = 2 * sizeof(attributes::ColorComponent);
+    CircleBucket bucket { layerProperties, MapMode::Continuous, 1.0f };
+    auto& binders = bucket.paintPropertyBinders.at("circle");
+    for (std::size_t i = 0; i < tileLayer.features.size(); ++i) {
+        const Point<int16_t> point(int16_t(i * 8), 0);
+        bucket.vertices.emplace_back(CircleProgram::vertex(point, -1, -1));
+        bucket.vertices.emplace_back(CircleProgram::vertex(point, 1, -1));
+        bucket.vertices.emplace_back(CircleProgram::vertex(point, 1, 1));
+        bucket.vertices.emplace_back(CircleProgram::vertex(point, -1, 1));
+        binders.populateVertexVectors(tileLayer.features[i], (i + 1) * 4, i, {}, {}, CanonicalTileID(0, 0, 0));
+    }
+    bucket.segments.emplace_back(0, 0, tileLayer.features.size() * 4, tileLayer.features.size() * 6);
+
+    RecordingUploadPass uploadPass { context };
+    bucket.upload(uploadPass);
+    const std::size_t created = uploadPass.createdVertexBuffers;
+    EXPECT_TRUE(uploadPass.vertexUpdates.empty());
+
+    // "b" and "c" are adjacent and are patched with a single update; "a" and "d" aren't changed.
+    bucket.update({ { "b", { { "color", std::string("red") } } }, { "c", { { "color", std::string("blue") } } } },
+                  tileLayer, "circle", {});
+    ASSERT_TRUE(bucket.needsUpload());
+    bucket.upload(uploadPass);
+    EXPECT_EQ(created, uploadPass.createdVertexBuffers);
+    using Updates = std::vector<std::pair<std::size_t, std::size_t>>;
+    EXPECT_EQ((Updates{ { 1 * 4 * vertexSize, 2 * 4 * vertexSize } }), uploadPass.vertexUpdates);
+
+    // Ranges are cleared once they are uploaded.
+    uploadPass.vertexUpdates.clear();
+    bucket.update({ { "d", { { "color", std::string("green") } } } }, tileLayer, "circle", {});
+    bucket.upload(uploadPass);
+    EXPECT_EQ(created, uploadPass.createdVertexBuffers);
+    EXPECT_EQ((Updates{ { 3 * 4 * vertexSize, 1 * 4 * vertexSize } }), uploadPass.vertexUpdates);
+}
+
 TEST(Buckets, FillBucket) {
     gl::HeadlessBackend backend({ 512, 256 });
     gfx::BackendScope scope { backend };
@@ -99,6 +234,87 @@ TEST(Buckets, FillBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, FillBucketPaintPropertyBytes) {
+    using namespace style::expression::dsl;
+
+    gl::HeadlessBackend backend({ 512, 256 });
+    gfx::BackendScope scope { backend };
+    FillBucket::PossiblyEvaluatedLayoutProperties layout;
+
+    style::FillLayer layer("fill", "source");
+    style::FillPaintProperties::PossiblyEvaluated evaluated;
+    evaluated.get<style::FillColor>() = PossiblyEvaluatedPropertyValue<Color>(
+        style::PropertyExpression<Color>(toColor(get("color"))));
+    std::map<std::string, Immutable<style::LayerProperties>> layerProperties;
+    layerProperties.emplace("fill", makeMutable<style::FillLayerProperties>(
+        staticImmutableCast<style::FillLayer::Impl>(layer.baseImpl), CrossfadeParameters(), evaluated));
+
+    gl::Context context{ backend };
+    FillBucket bucket { layout, layerProperties, 5.0f, 1 };
+    EXPECT_EQ(0u, bucket.getPaintPropertyBytes());
+
+    PropertyMap colorProperties { { "color", std::string("red") } };
+    GeometryCollection polygon { { { 0, 0 }, { 0, 1 }, { 1, 1 } } };
+    bucket.addFeature(StubGeometryTileFeature{{}, FeatureType::Polygon, polygon, colorProperties},
+                      polygon,
+                      {},
+                      PatternLayerMap(),
+                      0,
+                      CanonicalTileID(0, 0, 0));
+    const std::size_t vertexCount = bucket.vertices.elements();
+    ASSERT_NE(0u, vertexCount);
+
+    auto commandEncoder = context.createCommandEncoder();
+    auto uploadPass = commandEncoder->createUploadPass("upload");
+    bucket.upload(*uploadPass);
+
+    // Only fill-color is data-driven; it uploads one packed color per vertex.
+    EXPECT_EQ(vertexCount * 2 * sizeof(attributes::ColorComponent), bucket.getPaintPropertyBytes());
+}
+
+TEST(Buckets, FillBucketWideIndices) {
+    gl::HeadlessBackend backend({ 512, 256 });
+    gfx::BackendScope scope { backend };
+    FillBucket::PossiblyEvaluatedLayoutProperties layout;
+
+    gl::Context context{ backend };
+    auto commandEncoder = context.createCommandEncoder();
+    auto uploadPass = commandEncoder->createUploadPass("upload");
+
+    const auto addTriangles = [](FillBucket& bucket) {
+        for (int16_t i = 0; i < 6; ++i) {
+            bucket.vertices.emplace_back(FillProgram::layoutVertex({ i, i }));
+        }
+        // Two segments, as if split at the 16-bit vertex limit.
+        bucket.triangles.emplace_back(0, 1, 2);
+        bucket.triangleSegments.emplace_back(0, 0, 3, 3);
+        bucket.triangles.emplace_back(0, 1, 2);
+        bucket.triangleSegments.emplace_back(3, 3, 3, 3);
+    };
+
+    context.supportsUnsignedIntIndices = false;
+    FillBucket narrow { layout, {}, 5.0f, 1 };
+    addTriangles(narrow);
+    narrow.upload(*uploadPass);
+    EXPECT_EQ(2u, narrow.triangleSegments.size());
+    EXPECT_EQ(gfx::IndexType::UnsignedShort, narrow.triangleIndexBuffer->type);
+
+    context.supportsUnsignedIntIndices = true;
+    FillBucket wide { layout, {}, 5.0f, 1 };
+    addTriangles(wide);
+    wide.upload(*uploadPass);
+    ASSERT_EQ(1u, wide.triangleSegments.size());
+    EXPECT_EQ(Segment<FillAttributes>(0, 0, 6, 6), wide.triangleSegments[0]);
+    EXPECT_EQ(gfx::IndexType::UnsignedInt, wide.triangleIndexBuffer->type);
+    EXPECT_EQ(6u, wide.triangleIndexBuffer->elements);
+
+    // The indices of the coalesced segment are rebased to its vertex offset.
+    FillBucket rebased { layout, {}, 5.0f, 1 };
+    addTriangles(rebased);
+    EXPECT_EQ((std::vector<uint32_t>{ 0, 1, 2, 3, 4, 5 }),
+              coalesceSegments(rebased.triangleSegments, rebased.triangles.vector()));
+}
+
 TEST(Buckets, LineBucket) {
     gl::HeadlessBackend backend({ 512, 256 });
     gfx::BackendScope scope { backend };
@@ -214,6 +430,27 @@ TEST(Buckets, RasterBucket) {
     ASSERT_TRUE(bucket.needsUpload());
 }
 
+TEST(Buckets, RasterBucketOpaque) {
+    PremultipliedImage image({ 2, 2 });
+    image.fill(255);
+    RasterBucket bucket{ std::move(image) };
+    EXPECT_TRUE(bucket.coversTileOpaquely());
+
+    // Tiles that are partially covered by other tiles only paint parts of the tile.
+    bucket.setMask({ CanonicalTileID{ 1, 0, 0 } });
+    EXPECT_FALSE(bucket.coversTileOpaquely());
+    bucket.setMask({ CanonicalTileID{ 0, 0, 0 } });
+    EXPECT_TRUE(bucket.coversTileOpaquely());
+
+    PremultipliedImage translucent({ 2, 2 });
+    translucent.fill(255);
+    translucent.data[7] = 128;
+    bucket.setImage(std::make_shared<PremultipliedImage>(std::move(translucent)));
+    EXPECT_FALSE(bucket.coversTileOpaquely());
+
+    EXPECT_FALSE(RasterBucket{ nullptr }.coversTileOpaquely());
+}
+
 TEST(Buckets, RasterBucketMaskEmpty) {
     RasterBucket bucket{ nullptr };
     bucket.setMask({});
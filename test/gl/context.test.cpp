@@ -5,10 +5,12 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/custom_layer.hpp>
 #include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/renderable_resource.hpp>
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/renderer/frame_profile.hpp>
 #include <mbgl/storage/resource_options.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/style/layers/fill_layer.hpp>
@@ -121,3 +123,58 @@ TEST(GLContextMode, Shared) {
 
     test::checkImage("test/fixtures/shared_context", frontend.render(map).image, 0.5, 0.1);
 }
+
+TEST(GLContext, Profiling) {
+    gl::HeadlessBackend backend { { 256, 256 } };
+    gfx::BackendScope scope { backend };
+
+    gl::Context context{ backend };
+
+    // Frames are only recorded while profiling is enabled.
+    context.createCommandEncoder().reset();
+    EXPECT_TRUE(context.takeFrameProfiles().empty());
+
+    context.setProfilingEnabled(true);
+    {
+        auto encoder = context.createCommandEncoder();
+        const auto pass(encoder->createDebugGroup("pass"));
+        const auto layer(encoder->createDebugGroup("layer"));
+    }
+
+    // Without timer queries, frames are available right away. With them, a frame is handed out
+    // once the GPU has resolved its queries, which glFinish() guarantees.
+    auto profiles = context.takeFrameProfiles();
+    if (context.getTimerQueryExtension()) {
+        for (int attempt = 0; profiles.empty() && attempt < 10; ++attempt) {
+            MBGL_CHECK_ERROR(glFinish());
+            profiles = context.takeFrameProfiles();
+        }
+    }
+    ASSERT_EQ(1u, profiles.size());
+    EXPECT_EQ(0u, profiles[0].frame);
+    if (!context.getTimerQueryExtension()) {
+        EXPECT_FALSE(profiles[0].gpuDuration);
+    }
+
+    const auto& groups = profiles[0].groups;
+    ASSERT_EQ(3u, groups.size());
+    EXPECT_EQ("pass", groups[0].name);
+    EXPECT_EQ(0u, groups[0].depth);
+    EXPECT_EQ("layer", groups[1].name);
+    EXPECT_EQ(1u, groups[1].depth);
+    EXPECT_EQ("cleanup", groups[2].name);
+    EXPECT_EQ(0u, groups[2].depth);
+    EXPECT_LE(groups[0].cpuStart, groups[1].cpuStart);
+    EXPECT_LE(groups[1].cpuStart + groups[1].cpuDuration, groups[0].cpuStart + groups[0].cpuDuration);
+    EXPECT_LE(groups[0].cpuStart + groups[0].cpuDuration, groups[2].cpuStart);
+    EXPECT_LE(groups[2].cpuStart + groups[2].cpuDuration, profiles[0].cpuDuration);
+
+    const std::string trace = toChromeTrace(profiles);
+    EXPECT_NE(std::string::npos, trace.find(R"("traceEvents":[)"));
+    EXPECT_NE(std::string::npos, trace.find(R"({"name":"layer","ph":"X","pid":0,"tid":0,)"));
+    EXPECT_NE(std::string::npos, trace.find(R"({"name":"frame 0","ph":"X","pid":0,"tid":0,)"));
+
+    context.setProfilingEnabled(false);
+    context.createCommandEncoder().reset();
+    EXPECT_TRUE(context.takeFrameProfiles().empty());
+}
@@ -3,6 +3,14 @@
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/gl/stream_buffer.hpp>
+#include <mbgl/gl/buffer_pool.hpp>
+#include <mbgl/gl/index_buffer_resource.hpp>
+#include <mbgl/gl/vertex_buffer_resource.hpp>
+#include <mbgl/gfx/command_encoder.hpp>
+#include <mbgl/gfx/upload_pass.hpp>
+
+#include <array>
 
 #include <memory>
 
@@ -63,3 +71,198 @@ TEST(GLObject, Store) {
     context.reset();
     EXPECT_TRUE(context.empty());
 }
+
+TEST(GLObject, StreamBuffer) {
+    gl::HeadlessBackend backend { { 256, 256 } };
+    gfx::BackendScope scope { backend };
+
+    gl::Context context{ backend };
+    auto commandEncoder = context.createCommandEncoder();
+
+    using Vertex = std::array<float, 3>;
+    gfx::VertexVector<Vertex> vertices;
+    vertices.emplace_back(Vertex{{ 1, 2, 3 }});
+    gfx::VertexVector<uint8_t> bytes;
+    bytes.emplace_back(uint8_t(1));
+
+    {
+        auto uploadPass = commandEncoder->createUploadPass("upload");
+        auto a = uploadPass->createVertexBuffer(gfx::VertexVector<uint8_t>(bytes),
+                                                gfx::BufferUsageType::StreamDraw);
+        auto b = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices),
+                                                gfx::BufferUsageType::StreamDraw);
+        auto c = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices),
+                                                gfx::BufferUsageType::StaticDraw);
+        uploadPass.reset();
+
+        // Only the static buffer and the shared stream buffer allocate buffer objects.
+        EXPECT_EQ(2, context.renderingStats().numBuffers);
+        EXPECT_EQ(int(sizeof(Vertex)) * 2 + int(sizeof(Vertex)), context.renderingStats().memVertexBuffers);
+
+        // Slices are aligned to their stride.
+        const auto& streamed = b.getResource<gl::VertexBufferResource>();
+        EXPECT_EQ(&context.getStreamBuffer(), streamed.streamBuffer);
+        EXPECT_EQ(1u, streamed.streamOffset);
+        EXPECT_EQ(0u, a.getResource<gl::VertexBufferResource>().streamOffset);
+        EXPECT_EQ(nullptr, c.getResource<gl::VertexBufferResource>().streamBuffer);
+    }
+
+    context.performCleanup();
+    EXPECT_EQ(1, context.renderingStats().numBuffers);
+}
+
+TEST(GLObject, StreamBufferUpdate) {
+    gl::HeadlessBackend backend { { 256, 256 } };
+    gfx::BackendScope scope { backend };
+
+    gl::Context context{ backend };
+    auto commandEncoder = context.createCommandEncoder();
+    EXPECT_EQ(nullptr, context.getStreamBuffer().getResource());
+
+    using Vertex = std::array<float, 3>;
+    gfx::VertexVector<Vertex> vertices;
+    vertices.emplace_back(Vertex{{ 1, 2, 3 }});
+    vertices.emplace_back(Vertex{{ 4, 5, 6 }});
+
+    {
+        auto uploadPass = commandEncoder->createUploadPass("upload");
+        auto a = std::make_unique<gfx::VertexBuffer<Vertex>>(uploadPass->createVertexBuffer(
+            gfx::VertexVector<Vertex>(vertices), gfx::BufferUsageType::StreamDraw));
+        auto b = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices),
+                                                gfx::BufferUsageType::StreamDraw);
+        uploadPass.reset();
+        ASSERT_NE(nullptr, context.getStreamBuffer().getResource());
+        EXPECT_EQ(int(sizeof(Vertex)) * 4, context.renderingStats().memVertexBuffers);
+
+        // Updates that fit into the slots are written in place and only cover the changed range.
+        uploadPass = commandEncoder->createUploadPass("upload");
+        const Vertex vertex{{ 7, 8, 9 }};
+        uploadPass->updateVertexBuffer(b, 1, &vertex, 1);
+        auto& streamed = b.getResource<gl::VertexBufferResource>();
+        EXPECT_EQ(sizeof(Vertex), streamed.streamDirtyBegin);
+        EXPECT_EQ(sizeof(Vertex) * 2, streamed.streamDirtyEnd);
+        uploadPass->updateVertexBuffer(*a, gfx::VertexVector<Vertex>(vertices));
+        uploadPass.reset();
+
+        EXPECT_EQ(0u, streamed.streamDirtyBegin);
+        EXPECT_EQ(0u, streamed.streamDirtyEnd);
+        EXPECT_EQ(0u, a->getResource<gl::VertexBufferResource>().streamOffset);
+        EXPECT_EQ(2u, streamed.streamOffset);
+        EXPECT_EQ(1, context.renderingStats().numBuffers);
+        EXPECT_EQ(int(sizeof(Vertex)) * 4, context.renderingStats().memVertexBuffers);
+
+        // Removing a slice keeps the offsets of the others; the next added slice packs them again.
+        a.reset();
+        EXPECT_EQ(2u, streamed.streamOffset);
+        {
+            uploadPass = commandEncoder->createUploadPass("upload");
+            auto c = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices),
+                                                    gfx::BufferUsageType::StreamDraw);
+            uploadPass.reset();
+            EXPECT_EQ(0u, streamed.streamOffset);
+            EXPECT_EQ(2u, c.getResource<gl::VertexBufferResource>().streamOffset);
+            EXPECT_EQ(int(sizeof(Vertex)) * 4, context.renderingStats().memVertexBuffers);
+        }
+    }
+
+    context.performCleanup();
+    EXPECT_EQ(1, context.renderingStats().numBuffers);
+}
+
+TEST(GLObject, BufferPool) {
+    gl::HeadlessBackend backend { { 256, 256 } };
+    gfx::BackendScope scope { backend };
+
+    gl::Context context{ backend };
+    auto commandEncoder = context.createCommandEncoder();
+    const int pageSize = int(gl::BufferPool::pageSize);
+
+    using Vertex = std::array<float, 3>;
+    gfx::VertexVector<uint8_t> bytes;
+    bytes.emplace_back(uint8_t(1));
+    gfx::VertexVector<Vertex> vertices;
+    vertices.emplace_back(Vertex{{ 1, 2, 3 }});
+    gfx::IndexVector<gfx::Triangles> indices;
+    indices.emplace_back(0, 0, 0);
+
+    {
+        auto uploadPass = commandEncoder->createUploadPass("upload");
+        auto a = uploadPass->createVertexBuffer(gfx::VertexVector<uint8_t>(bytes));
+        auto b = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices));
+        auto i = uploadPass->createIndexBuffer(gfx::IndexVector<gfx::Triangles>(indices));
+
+        // Static buffers share one page per buffer type, but are reported as buffers of their own.
+        EXPECT_EQ(3, context.renderingStats().numBuffers);
+        EXPECT_EQ(1 + int(sizeof(Vertex)), context.renderingStats().memVertexBuffers);
+        EXPECT_EQ(6, context.renderingStats().memIndexBuffers);
+        EXPECT_EQ(2 * pageSize, context.renderingStats().memPooledBuffers);
+        EXPECT_EQ(1 + int(sizeof(Vertex)) + 6, context.renderingStats().memPooledBuffersUsed);
+
+        // Allocations are aligned to their stride.
+        const auto& first = a.getResource<gl::VertexBufferResource>();
+        const auto& second = b.getResource<gl::VertexBufferResource>();
+        EXPECT_EQ(first.poolPage, second.poolPage);
+        EXPECT_EQ(0u, first.poolOffset);
+        EXPECT_EQ(sizeof(Vertex), second.poolOffset);
+        EXPECT_NE(nullptr, i.getResource<gl::IndexBufferResource>().poolPage);
+
+        // Large buffers get a buffer object of their own.
+        gfx::VertexVector<uint8_t> large;
+        large.extend(gl::BufferPool::maxAllocationSize + 1, uint8_t(0));
+        auto c = uploadPass->createVertexBuffer(std::move(large));
+        EXPECT_EQ(nullptr, c.getResource<gl::VertexBufferResource>().poolPage);
+        EXPECT_EQ(4, context.renderingStats().numBuffers);
+    }
+
+    // Freed blocks are merged again, and the last empty page of each pool is kept for reuse.
+    context.performCleanup();
+    EXPECT_EQ(0, context.renderingStats().numBuffers);
+    EXPECT_EQ(0, context.renderingStats().memVertexBuffers);
+    EXPECT_EQ(0, context.renderingStats().memIndexBuffers);
+    EXPECT_EQ(0, context.renderingStats().memPooledBuffersUsed);
+    EXPECT_EQ(2 * pageSize, context.renderingStats().memPooledBuffers);
+
+    {
+        auto uploadPass = commandEncoder->createUploadPass("upload");
+        auto a = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices));
+        EXPECT_EQ(0u, a.getResource<gl::VertexBufferResource>().poolOffset);
+        EXPECT_EQ(1, context.renderingStats().numBuffers);
+        EXPECT_EQ(2 * pageSize, context.renderingStats().memPooledBuffers);
+    }
+
+    context.reduceMemoryUsage();
+    EXPECT_EQ(0, context.renderingStats().numBuffers);
+    EXPECT_EQ(0, context.renderingStats().memPooledBuffers);
+}
+
+TEST(GLObject, BufferPoolReuse) {
+    gl::HeadlessBackend backend { { 256, 256 } };
+    gfx::BackendScope scope { backend };
+
+    gl::Context context{ backend };
+    auto commandEncoder = context.createCommandEncoder();
+
+    using Vertex = std::array<float, 3>;
+    gfx::VertexVector<Vertex> vertices;
+    vertices.emplace_back(Vertex{{ 1, 2, 3 }});
+    gfx::VertexVector<Vertex> twoVertices(vertices);
+    twoVertices.emplace_back(Vertex{{ 4, 5, 6 }});
+
+    auto uploadPass = commandEncoder->createUploadPass("upload");
+    auto a = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices));
+    auto b = std::make_unique<gfx::VertexBuffer<Vertex>>(
+        uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(twoVertices)));
+    auto c = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(vertices));
+    EXPECT_EQ(3 * sizeof(Vertex), c.getResource<gl::VertexBufferResource>().poolOffset);
+
+    // The freed block between two allocations is the best fit for an allocation of its size.
+    b.reset();
+    EXPECT_EQ(2, context.renderingStats().numBuffers);
+    EXPECT_EQ(2 * int(sizeof(Vertex)), context.renderingStats().memVertexBuffers);
+    auto d = uploadPass->createVertexBuffer(gfx::VertexVector<Vertex>(twoVertices));
+    EXPECT_EQ(sizeof(Vertex), d.getResource<gl::VertexBufferResource>().poolOffset);
+    EXPECT_EQ(a.getResource<gl::VertexBufferResource>().poolPage,
+              d.getResource<gl::VertexBufferResource>().poolPage);
+    EXPECT_EQ(4 * int(sizeof(Vertex)), context.renderingStats().memPooledBuffersUsed);
+    EXPECT_EQ(int(gl::BufferPool::pageSize), context.renderingStats().memPooledBuffers);
+}
@@ -801,6 +801,95 @@ TEST(Map, DisabledSources) {
     test::checkImage("test/fixtures/map/disabled_layers/second", test.frontend.render(test.map).image);
 }
 
+namespace {
+
+// A fill layer drawing a polygon that covers most of the world.
+std::string occlusionFillLayerJSON() {
+    return R"JSON({
+    "id": "fill",
+    "type": "fill",
+    "source": "geojson",
+    "paint": { "fill-color": "blue" }
+  })JSON";
+}
+
+std::string occlusionStyleJSON(const std::string& layers) {
+    return R"JSON({
+  "version": 8,
+  "sources": {
+    "geojson": {
+      "type": "geojson",
+      "data": {
+        "type": "Polygon",
+        "coordinates": [ [ [ -90, -45 ], [ 90, -45 ], [ 90, 45 ], [ -90, 45 ], [ -90, -45 ] ] ]
+      }
+    },
+    "raster": {
+      "type": "raster",
+      "tiles": [ "raster/{z}/{x}/{y}" ],
+      "tileSize": 512
+    }
+  },
+  "layers": [ )JSON" + layers + R"JSON( ]
+})JSON";
+}
+
+gfx::RenderingStats renderOcclusionStyle(const std::string& layers) {
+    MapTest<> test;
+    test.fileSource->tileResponse = [](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/raster.tile"));
+        return response;
+    };
+    test.map.getStyle().loadJSON(occlusionStyleJSON(layers));
+    test.map.jumpTo(CameraOptions().withZoom(0.0));
+    return test.frontend.render(test.map).stats;
+}
+
+} // namespace
+
+TEST(Map, OccludedLayersAreNotUploaded) {
+    const std::string background = R"JSON({
+    "id": "background",
+    "type": "background",
+    "paint": { "background-color": "white" }
+  })JSON";
+
+    const auto visible = renderOcclusionStyle(background + ", " + occlusionFillLayerJSON());
+    const auto hidden = renderOcclusionStyle(occlusionFillLayerJSON() + ", " + background);
+
+    // Below the opaque background, the fill layer is neither uploaded nor drawn.
+    EXPECT_LT(hidden.memIndexBuffers, visible.memIndexBuffers);
+    EXPECT_LT(hidden.numDrawCalls, visible.numDrawCalls);
+}
+
+TEST(Map, OccludedTilesAreNotUploaded) {
+    const std::string raster = R"JSON({
+    "id": "raster",
+    "type": "raster",
+    "source": "raster"
+  })JSON";
+    const std::string translucentRaster = R"JSON({
+    "id": "raster",
+    "type": "raster",
+    "source": "raster",
+    "paint": { "raster-opacity": 0.5 }
+  })JSON";
+
+    // The raster tile is a JPEG image and has no transparent pixels.
+    const auto visible = renderOcclusionStyle(raster + ", " + occlusionFillLayerJSON());
+    const auto hidden = renderOcclusionStyle(occlusionFillLayerJSON() + ", " + raster);
+    const auto translucent = renderOcclusionStyle(occlusionFillLayerJSON() + ", " + translucentRaster);
+
+    // The fill tile is the same tile as the opaque raster tile, so its bucket is skipped.
+    EXPECT_LT(hidden.memIndexBuffers, visible.memIndexBuffers);
+    EXPECT_LT(hidden.numDrawCalls, visible.numDrawCalls);
+
+    // A translucent raster tile doesn't hide anything.
+    EXPECT_EQ(visible.memIndexBuffers, translucent.memIndexBuffers);
+    EXPECT_EQ(visible.numDrawCalls, translucent.numDrawCalls);
+}
+
 TEST(Map, DontLoadUnneededTiles) {
     MapTest<> test;
 
@@ -1530,6 +1619,122 @@ TEST(Map, PlacedSymbolData) {
     EXPECT_TRUE(test.frontend.getRenderer()->getPlacedSymbolsData().empty());
 }
 
+TEST(Map, AsyncPlacement) {
+    MapTest<> test{1, MapMode::Continuous};
+
+    test.fileSource->tileResponse = makeResponse("vector.tile", true);
+    test.fileSource->glyphsResponse = makeResponse("glyphs.pbf", true);
+    test.fileSource->styleResponse = makeResponse("style_vector.json");
+    test.fileSource->sourceResponse = makeResponse("source_vector.json");
+    test.fileSource->spriteJSONResponse = makeResponse("sprite.json");
+    test.fileSource->spriteImageResponse = makeResponse("sprite.png");
+
+    test.frontend.getRenderer()->enableAsyncPlacement(true);
+    test.observer.didFinishLoadingMapCallback = [&] { test.runLoop.stop(); };
+
+    test.map.jumpTo(CameraOptions().withZoom(12).withCenter(LatLng{38.917982, -77.037603}));
+    test.map.getStyle().loadURL("mapbox://streets");
+    test.runLoop.run();
+
+    // The map is only loaded once the asynchronous placement has been committed.
+    const Size size = test.frontend.getSize();
+    const auto features = test.frontend.getRenderer()->queryRenderedFeatures(
+        ScreenBox{{0, 0}, {double(size.width), double(size.height)}},
+        {std::vector<std::string>{"place-city-lg-s", "poi-scalerank2", "poi-scalerank3", "rail-label"}, {}});
+    EXPECT_FALSE(features.empty());
+}
+
+TEST(Map, AsyncPlacementWhileCameraMoves) {
+    MapTest<> test{1, MapMode::Continuous};
+
+    test.fileSource->tileResponse = makeResponse("vector.tile", true);
+    test.fileSource->glyphsResponse = makeResponse("glyphs.pbf", true);
+    test.fileSource->styleResponse = makeResponse("style_vector.json");
+    test.fileSource->sourceResponse = makeResponse("source_vector.json");
+    test.fileSource->spriteJSONResponse = makeResponse("sprite.json");
+    test.fileSource->spriteImageResponse = makeResponse("sprite.png");
+
+    test.frontend.getRenderer()->enableAsyncPlacement(true);
+
+    // Keep the camera moving for a while, so that the frames rendered in the meantime update the
+    // symbol buckets and the cross-tile index while the placements are calculated in the background.
+    unsigned frames = 0;
+    test.observer.didFinishRenderingFrameCallback = [&](MapObserver::RenderFrameStatus status) {
+        if (++frames < 30) {
+            test.map.moveBy({8, 4});
+            test.map.rotateBy({100, 100}, {110, 104});
+        } else if (status.mode == MapObserver::RenderMode::Full) {
+            test.runLoop.stop();
+        }
+    };
+
+    test.map.jumpTo(CameraOptions().withZoom(12).withCenter(LatLng{38.917982, -77.037603}));
+    test.map.getStyle().loadURL("mapbox://streets");
+    test.runLoop.run();
+
+    const Size size = test.frontend.getSize();
+    const auto features = test.frontend.getRenderer()->queryRenderedFeatures(
+        ScreenBox{{0, 0}, {double(size.width), double(size.height)}},
+        {std::vector<std::string>{"place-city-lg-s", "poi-scalerank2", "poi-scalerank3", "rail-label"}, {}});
+    EXPECT_FALSE(features.empty());
+}
+
+TEST(Map, PlacementReusedAfterPan) {
+    using namespace std::chrono_literals;
+    MapTest<> test{1, MapMode::Continuous};
+
+    test.fileSource->tileResponse = makeResponse("vector.tile", true);
+    test.fileSource->glyphsResponse = makeResponse("glyphs.pbf", true);
+    test.fileSource->styleResponse = makeResponse("style_vector.json");
+    test.fileSource->sourceResponse = makeResponse("source_vector.json");
+    test.fileSource->spriteJSONResponse = makeResponse("sprite.json");
+    test.fileSource->spriteImageResponse = makeResponse("sprite.png");
+
+    enum class Step { Load, Pan, Zoom };
+    Step step = Step::Load;
+    PlacementStats panStats;
+    PlacementStats zoomStats;
+
+    // The camera is moved once the current placement is not recent anymore, so that the next frame
+    // places the symbols again.
+    util::Timer timer;
+    test.observer.didFinishRenderingFrameCallback = [&](MapObserver::RenderFrameStatus status) {
+        const PlacementStats stats = test.frontend.getRenderer()->getPlacementStats();
+        const bool placed = stats.placedSymbols + stats.reusedSymbols != 0u;
+        switch (step) {
+            case Step::Load:
+                if (status.mode == MapObserver::RenderMode::Full && !status.needsRepaint) {
+                    step = Step::Pan;
+                    timer.start(400ms, 0ms, [&] { test.map.moveBy({20, 10}); });
+                }
+                break;
+            case Step::Pan:
+                if (placed) {
+                    panStats = stats;
+                    step = Step::Zoom;
+                    timer.start(400ms, 0ms, [&] { test.map.jumpTo(CameraOptions().withZoom(12.5)); });
+                }
+                break;
+            case Step::Zoom:
+                if (placed) {
+                    zoomStats = stats;
+                    test.runLoop.stop();
+                }
+                break;
+        }
+    };
+
+    test.map.jumpTo(CameraOptions().withZoom(12).withCenter(LatLng{38.917982, -77.037603}));
+    test.map.getStyle().loadURL("mapbox://streets");
+    test.runLoop.run();
+
+    // After panning, only the symbols crossing the viewport edges need the collision detection.
+    EXPECT_GT(panStats.reusedSymbols, 0u);
+    // The collision boxes are scaled by zooming, so nothing can be reused.
+    EXPECT_EQ(0u, zoomStats.reusedSymbols);
+    EXPECT_GT(zoomStats.placedSymbols, 0u);
+}
+
 TEST(Map, VolatileSource) {
     MapTest<> test{1, MapMode::Continuous};
 
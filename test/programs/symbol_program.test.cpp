@@ -67,3 +67,16 @@ TEST(SymbolProgram, SymbolSizeBinder) {
     EXPECT_EQ(uniformValues.get<uniforms::is_size_feature_constant>(), false);
     EXPECT_EQ(uniformValues.get<uniforms::size_t>(), 0.45f);
 }
+
+TEST(SymbolProgram, MergeSegments) {
+    SegmentVector<SymbolTextAttributes> segments;
+    segments.emplace_back(0, 0, 4, 6, 1.0f);
+    // Starts because of a new sort key and shares the vertex range of the previous segment.
+    segments.emplace_back(0, 6, 8, 6, 2.0f);
+    // Starts a new vertex range.
+    segments.emplace_back(8, 12, 4, 6, 3.0f);
+
+    EXPECT_TRUE(canMergeSegments(segments[0], segments[1]));
+    EXPECT_FALSE(canMergeSegments(segments[1], segments[2]));
+    EXPECT_FALSE(canMergeSegments(segments[1], segments[0]));
+}
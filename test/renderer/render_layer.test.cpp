@@ -0,0 +1,118 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/map_adapter.hpp>
+#include <mbgl/test/stub_file_source.hpp>
+#include <mbgl/test/stub_map_observer.hpp>
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/sources/render_tile_source.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <limits>
+
+using namespace mbgl;
+
+namespace {
+
+// Every tile is drawn with data-driven fill and line properties, so that the draw parameters
+// include paint attribute bindings.
+constexpr const char* concurrentTilesStyle = R"STYLE({
+  "version": 8,
+  "sources": {
+    "vector": { "type": "vector", "tiles": [ "{z}/{x}/{y}" ] }
+  },
+  "layers": [{
+    "id": "water",
+    "type": "fill",
+    "source": "vector",
+    "source-layer": "water",
+    "paint": {
+      "fill-color": [ "match", [ "get", "osm_id" ], 0, "#ff8844", "#4488ff" ],
+      "fill-outline-color": "#000000",
+      "fill-translate": [ 4, -2 ],
+      "fill-translate-anchor": "viewport"
+    }
+  }, {
+    "id": "admin",
+    "type": "line",
+    "source": "vector",
+    "source-layer": "admin",
+    "filter": [ "==", [ "get", "admin_level" ], 2 ],
+    "paint": {
+      "line-color": [ "case", [ "==", [ "get", "maritime" ], 1 ], "#00ff00", "#ff0000" ],
+      "line-width": [ "case", [ "==", [ "get", "maritime" ], 1 ], 1, 3 ]
+    }
+  }]
+})STYLE";
+
+struct TileRendering {
+    HeadlessFrontend::RenderResult result;
+    std::size_t tileCount = 0;
+};
+
+// Renders at least 32 tiles at zoom level 4 into a small framebuffer.
+TileRendering renderConcurrentTilesStyle() {
+    util::RunLoop runLoop;
+    auto fileSource = std::make_shared<StubFileSource>();
+    StubMapObserver observer;
+    const float pixelRatio = 0.25f;
+    HeadlessFrontend frontend({ 4096, 2048 }, pixelRatio);
+    MapAdapter map(frontend, observer, fileSource,
+                   MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()).withPixelRatio(pixelRatio));
+
+    TileRendering rendering;
+    fileSource->tileResponse = [&](const Resource&) {
+        ++rendering.tileCount;
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt"));
+        return response;
+    };
+    map.getStyle().loadJSON(concurrentTilesStyle);
+    map.jumpTo(CameraOptions().withCenter(LatLng { 10.0, 10.0 }).withZoom(4.0));
+    rendering.result = frontend.render(map);
+    return rendering;
+}
+
+// Makes every source and layer take the serial path while it exists.
+class SerialTilesScope {
+public:
+    SerialTilesScope()
+        : draws(RenderLayer::minTilesForConcurrentDraws),
+          preparation(RenderTileSource::minTilesForConcurrentPreparation) {
+        RenderLayer::minTilesForConcurrentDraws = std::numeric_limits<std::size_t>::max();
+        RenderTileSource::minTilesForConcurrentPreparation = std::numeric_limits<std::size_t>::max();
+    }
+    ~SerialTilesScope() {
+        RenderLayer::minTilesForConcurrentDraws = draws;
+        RenderTileSource::minTilesForConcurrentPreparation = preparation;
+    }
+
+private:
+    const std::size_t draws;
+    const std::size_t preparation;
+};
+
+} // namespace
+
+// Tile sources prepare large tile sets, and fill and line layers compute the draw parameters of
+// their tiles, on worker threads. The frame must come out the same as when every tile is handled
+// on the render thread, one after the other.
+TEST(RenderLayer, ConcurrentTilesRenderLikeSerialTiles) {
+    const TileRendering concurrent = renderConcurrentTilesStyle();
+    ASSERT_GE(concurrent.tileCount, RenderLayer::minTilesForConcurrentDraws);
+    ASSERT_GE(concurrent.tileCount, RenderTileSource::minTilesForConcurrentPreparation);
+
+    TileRendering serial;
+    {
+        SerialTilesScope scope;
+        serial = renderConcurrentTilesStyle();
+    }
+
+    EXPECT_EQ(serial.tileCount, concurrent.tileCount);
+    EXPECT_EQ(serial.result.stats.numDrawCalls, concurrent.result.stats.numDrawCalls);
+    EXPECT_GT(concurrent.result.stats.numDrawCalls, int(concurrent.tileCount));
+    EXPECT_TRUE(serial.result.image == concurrent.result.image);
+}
@@ -0,0 +1,96 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/source_state.hpp>
+#include <mbgl/renderer/tile_render_data.hpp>
+#include <mbgl/tile/tile.hpp>
+#include <mbgl/util/string.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Records the feature state changes that are applied to it.
+class StubTile final : public Tile {
+public:
+    StubTile() : Tile(Kind::Geometry, OverscaledTileID(0, 0, 0)) {}
+    std::unique_ptr<TileRenderData> createRenderData() override { return nullptr; }
+    bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override { return true; }
+    void setFeatureState(const LayerFeatureStates& states) override { applied.push_back(states); }
+
+    std::vector<LayerFeatureStates> applied;
+};
+
+} // namespace
+
+TEST(SourceFeatureState, RemoveAllOnlyAffectsFeaturesWithState) {
+    StubTile tile;
+    std::vector<RenderTile> tiles;
+    tiles.emplace_back(UnwrappedTileID(0, 0, 0), tile);
+
+    const std::string layer = "layer";
+    SourceFeatureState state;
+    state.updateStates(layer, FeatureStates{{"a", {{"hover", true}}}, {"b", {{"hover", true}}}});
+    state.coalesceChanges(tiles);
+    ASSERT_EQ(1u, tile.applied.size());
+    EXPECT_EQ(2u, tile.applied.back()[layer].size());
+
+    state.removeState(layer, std::string("a"), {});
+    state.coalesceChanges(tiles);
+    ASSERT_EQ(2u, tile.applied.size());
+    EXPECT_EQ((FeatureStates{{"a", {}}}), tile.applied.back()[layer]);
+
+    // "a" no longer has a state, so removing the states of the whole layer only changes "b".
+    state.removeState(layer, {}, {});
+    EXPECT_TRUE(state.hasChanges());
+    state.coalesceChanges(tiles);
+    ASSERT_EQ(3u, tile.applied.size());
+    EXPECT_EQ((FeatureStates{{"b", {}}}), tile.applied.back()[layer]);
+
+    // Nothing is left to remove.
+    state.removeState(layer, {}, {});
+    state.coalesceChanges(tiles);
+    EXPECT_EQ(3u, tile.applied.size());
+}
+
+TEST(SourceFeatureState, StatesSurviveReleasingFeatures) {
+    StubTile tile;
+    std::vector<RenderTile> tiles;
+    tiles.emplace_back(UnwrappedTileID(0, 0, 0), tile);
+
+    SourceFeatureState state;
+    FeatureStates states;
+    for (int i = 0; i < 100; ++i) {
+        states[util::toString(i)] = FeatureState{{"value", int64_t(i)}};
+    }
+    state.updateStates({}, states);
+    state.coalesceChanges(tiles);
+
+    // Removing most states releases the features without state, and moves the others.
+    for (int i = 0; i < 100; ++i) {
+        if (i % 8 != 0) {
+            state.removeState({}, util::toString(i), {});
+        }
+    }
+    state.coalesceChanges(tiles);
+    EXPECT_EQ(87u, tile.applied.back()[""].size());
+
+    FeatureState result;
+    for (int i = 0; i < 100; ++i) {
+        state.getState(result, {}, util::toString(i));
+        if (i % 8 == 0) {
+            EXPECT_EQ((FeatureState{{"value", int64_t(i)}}), result) << i;
+        } else {
+            EXPECT_TRUE(result.empty()) << i;
+        }
+    }
+
+    // Released features can get a state again.
+    state.updateState({}, "1", FeatureState{{"value", int64_t(-1)}});
+    state.coalesceChanges(tiles);
+    EXPECT_EQ((FeatureStates{{"1", {{"value", int64_t(-1)}}}}), tile.applied.back()[""]);
+    state.getState(result, {}, "1");
+    EXPECT_EQ((FeatureState{{"value", int64_t(-1)}}), result);
+    state.getState(result, {}, "8");
+    EXPECT_EQ((FeatureState{{"value", int64_t(8)}}), result);
+}
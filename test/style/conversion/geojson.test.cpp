@@ -0,0 +1,60 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/conversion/geojson.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style::conversion;
+
+TEST(GeoJSONConversion, FeatureCollection) {
+    Error error;
+    optional<GeoJSON> converted = parseGeoJSON(R"JSON({
+        "features": [
+            {"type": "Feature", "id": 1, "properties": {"name": "first"},
+             "geometry": {"type": "Point", "coordinates": [1, 2]}},
+            {"geometry": {"coordinates": [[0, 0], [1, 1]], "type": "LineString"},
+             "properties": {"nested": {"array": [1, "two", null]}}, "type": "Feature"}
+        ],
+        "type": "FeatureCollection"
+    })JSON", error);
+    ASSERT_TRUE(converted) << error.message;
+    ASSERT_TRUE(converted->is<mapbox::feature::feature_collection<double>>());
+
+    const auto& features = converted->get<mapbox::feature::feature_collection<double>>();
+    ASSERT_EQ(2u, features.size());
+    EXPECT_EQ(FeatureIdentifier(uint64_t(1)), features[0].id);
+    EXPECT_EQ(Value(std::string("first")), features[0].properties.at("name"));
+    EXPECT_TRUE(features[0].geometry.is<mapbox::geometry::point<double>>());
+    EXPECT_TRUE(features[1].geometry.is<mapbox::geometry::line_string<double>>());
+    EXPECT_TRUE(features[1].properties.at("nested").is<PropertyMap>());
+}
+
+TEST(GeoJSONConversion, FeatureAndGeometry) {
+    Error error;
+    optional<GeoJSON> feature = parseGeoJSON(
+        R"JSON({"type": "Feature", "properties": {}, "geometry": {"type": "Point", "coordinates": [1, 2]}})JSON",
+        error);
+    ASSERT_TRUE(feature) << error.message;
+    EXPECT_TRUE(feature->is<mapbox::feature::feature<double>>());
+
+    optional<GeoJSON> geometry = parseGeoJSON(R"JSON({"type": "Point", "coordinates": [1, 2]})JSON", error);
+    ASSERT_TRUE(geometry) << error.message;
+    EXPECT_TRUE(geometry->is<mapbox::geometry::geometry<double>>());
+}
+
+TEST(GeoJSONConversion, ErrorHandling) {
+    Error error;
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "FeatureCollection", "features": [)JSON", error));
+    EXPECT_FALSE(error.message.empty());
+
+    error = {};
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "FeatureCollection", "features": [1]})JSON", error));
+    EXPECT_FALSE(error.message.empty());
+
+    error = {};
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "FeatureCollection", "features": [{"type": "Point", "coordinates": [1, 2]}]})JSON", error));
+    EXPECT_FALSE(error.message.empty());
+
+    error = {};
+    EXPECT_FALSE(parseGeoJSON(R"JSON({"type": "FeatureCollection"})JSON", error));
+    EXPECT_FALSE(error.message.empty());
+}
@@ -4,6 +4,7 @@
 #include <mbgl/test/stub_style_observer.hpp>
 #include <mbgl/test/util.hpp>
 
+#include <mbgl/style/expression/dsl.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/style/layers/hillshade_layer.hpp>
@@ -15,6 +16,7 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/custom_geometry_source.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/style/sources/image_source.hpp>
 #include <mbgl/style/sources/raster_dem_source.hpp>
 #include <mbgl/style/sources/raster_source.hpp>
@@ -29,6 +31,7 @@
 
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/premultiply.hpp>
 #include <mbgl/util/image.hpp>
@@ -42,10 +45,13 @@
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/annotation/annotation_source.hpp>
 #include <mbgl/map/transform.hpp>
+#include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <gmock/gmock.h>
 
@@ -752,7 +758,9 @@ public:
     void setUpdateParameters(const TileUpdateParameters&) override;
     bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override { return true; }
 
-    std::unique_ptr<TileRenderData> createRenderData() override { return nullptr; }
+    std::unique_ptr<TileRenderData> createRenderData() override {
+        return std::make_unique<SharedBucketTileRenderData<Bucket>>(nullptr);
+    }
 
 private:
     FakeTileSource& source;
@@ -900,6 +908,45 @@ TEST(Source, RenderTileSetSourceUpdate) {
     renderSource->update(uninitialized.baseImpl, layers, true, true, test.tileParameters());
 }
 
+TEST(Source, RenderTilesReusedUntilChanged) {
+    SourceTest test;
+    VectorSource initialized("source", Tileset{{"tiles"}});
+    initialized.loadDescription(*test.fileSource);
+
+    testing::NiceMock<FakeTileSource> renderTilesetSource{initialized.baseImpl};
+    RenderSource* renderSource = &renderTilesetSource;
+    LineLayer layer("id", "source");
+    Immutable<LayerProperties> layerProperties =
+        makeMutable<LineLayerProperties>(staticImmutableCast<LineLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+    renderSource->update(initialized.baseImpl, layers, true, true, test.tileParameters());
+
+    const MapDebugOptions debugOptions = MapDebugOptions::NoDebug;
+    const TransformParameters transformParams{test.transformState};
+    renderSource->prepare({transformParams, debugOptions, test.imageManager});
+    const uint64_t revision = renderSource->getPrepareRevision();
+    const RenderTiles renderTiles = renderSource->getRenderTiles();
+    ASSERT_TRUE(renderTiles);
+    ASSERT_FALSE(renderTiles->empty());
+
+    // Nothing changed since the previous frame.
+    renderSource->prepare({transformParams, debugOptions, test.imageManager});
+    EXPECT_EQ(revision, renderSource->getPrepareRevision());
+    EXPECT_EQ(renderTiles, renderSource->getRenderTiles());
+
+    // Invalidated render data is re-created.
+    renderSource->invalidatePreparedData();
+    renderSource->prepare({transformParams, debugOptions, test.imageManager});
+    EXPECT_EQ(revision + 1, renderSource->getPrepareRevision());
+    EXPECT_NE(renderTiles, renderSource->getRenderTiles());
+
+    // Moving the camera changes the tile matrices.
+    test.transform.jumpTo(CameraOptions().withCenter(LatLng{1.0, 1.0}));
+    const TransformParameters movedTransformParams{test.transform.getState()};
+    renderSource->prepare({movedTransformParams, debugOptions, test.imageManager});
+    EXPECT_EQ(revision + 2, renderSource->getPrepareRevision());
+}
+
 TEST(Source, GeoJSONSourceTilesAfterDataReset) {
     SourceTest test;
     GeoJSONSource source("source");
@@ -930,6 +977,109 @@ TEST(Source, GeoJSONSourceTilesAfterDataReset) {
     EXPECT_TRUE(renderSource.isLoaded()); // Tiles are reset in static mode.
 }
 
+TEST(Source, GeoJSONSourceUpdateFeatures) {
+    SourceTest test;
+    GeoJSONSource source("source");
+
+    GeoJSONFeature first{mapbox::geometry::point<double>(10.0, 10.0)};
+    first.id = uint64_t(1);
+    GeoJSONFeature second{mapbox::geometry::point<double>(-100.0, -40.0)};
+    second.id = uint64_t(2);
+    GeoJSONData::Features features;
+    features.push_back(first);
+    features.push_back(second);
+    source.setGeoJSON(GeoJSON{features});
+    const std::weak_ptr<GeoJSONData> initialData = source.impl().getData();
+
+    optional<std::vector<LatLngBounds>> changedBounds;
+    const auto tileChanged = [&](const CanonicalTileID& tileID) {
+        return std::any_of(changedBounds->begin(), changedBounds->end(), [&](const LatLngBounds& bounds) {
+            return boundsIntersectTile(bounds, tileID, source.getOptions().buffer);
+        });
+    };
+    const auto featureCount = [&](const CanonicalTileID& tileID) {
+        std::size_t count = 0;
+        source.impl().getData().lock()->getTile(tileID, [&](GeoJSONData::TileFeatures tileFeatures) {
+            count = tileFeatures.size();
+            test.end();
+        });
+        test.run();
+        return count;
+    };
+
+    // Moving a feature only changes the tiles around its old and new position.
+    first.geometry = mapbox::geometry::point<double>(20.0, 10.0);
+    GeoJSONData::Features updated;
+    updated.push_back(first);
+    source.updateFeatures(updated);
+    changedBounds = source.impl().getChangedBoundsSince(initialData);
+    ASSERT_TRUE(changedBounds);
+    EXPECT_EQ(2u, changedBounds->size());
+    EXPECT_TRUE(tileChanged({0, 0, 0}));
+    EXPECT_TRUE(tileChanged({4, 8, 7}));
+    EXPECT_FALSE(tileChanged({4, 3, 9}));
+    EXPECT_FALSE(tileChanged({4, 0, 0}));
+    EXPECT_EQ(2u, featureCount({0, 0, 0}));
+
+    // Changes are accumulated over subsequent updates.
+    source.removeFeatures({uint64_t(2)});
+    changedBounds = source.impl().getChangedBoundsSince(initialData);
+    ASSERT_TRUE(changedBounds);
+    EXPECT_EQ(3u, changedBounds->size());
+    EXPECT_TRUE(tileChanged({4, 3, 9}));
+    EXPECT_EQ(1u, featureCount({0, 0, 0}));
+
+    // Replacing the data changes every tile.
+    source.setGeoJSON(GeoJSON{updated});
+    EXPECT_FALSE(source.impl().getChangedBoundsSince(initialData));
+}
+
+TEST(Source, GeoJSONSourceClusterProperties) {
+    const auto clusterProperty = [](const char* reduce, const char* map) -> GeoJSONOptions::ClusterExpression {
+        return {style::expression::dsl::createExpression(map), style::expression::dsl::createExpression(reduce)};
+    };
+
+    auto options = makeMutable<GeoJSONOptions>();
+    options->cluster = true;
+    // Computed on the property values.
+    options->clusterProperties["sum"] = clusterProperty(R"(["+", ["accumulated"], ["get", "sum"]])",
+                                                        R"(["get", "scalerank"])");
+    options->clusterProperties["max"] = clusterProperty(R"(["max", ["accumulated"], ["get", "max"]])",
+                                                        R"(["get", "scalerank"])");
+    // Evaluated as expressions.
+    options->clusterProperties["double"] = clusterProperty(R"(["+", ["accumulated"], ["get", "double"]])",
+                                                           R"(["*", ["get", "scalerank"], 2])");
+    options->clusterProperties["names"] = clusterProperty(R"(["concat", ["accumulated"], ["get", "names"]])",
+                                                          R"(["get", "name"])");
+    options->clusterProperties["type"] = clusterProperty(R"(["concat", ["accumulated"], ["get", "type"]])",
+                                                         R"(["geometry-type"])");
+
+    GeoJSONData::Features features;
+    const std::vector<std::string> names{"a", "b", "c"};
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        features.emplace_back(mapbox::geometry::point<double>(0.0001 * i, 0.0));
+        features.back().properties["scalerank"] = uint64_t(i + 1);
+        features.back().properties["name"] = names[i];
+    }
+    auto data = GeoJSONData::create(GeoJSON{features}, std::move(options));
+
+    optional<PropertyMap> cluster;
+    data->getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures tileFeatures) {
+        ASSERT_EQ(1u, tileFeatures.size());
+        cluster = tileFeatures.front().properties;
+    });
+    ASSERT_TRUE(cluster);
+    EXPECT_EQ(3.0, numericValue<double>(cluster->at("point_count")));
+    EXPECT_EQ(6.0, numericValue<double>(cluster->at("sum")));
+    EXPECT_EQ(3.0, numericValue<double>(cluster->at("max")));
+    EXPECT_EQ(12.0, numericValue<double>(cluster->at("double")));
+    ASSERT_TRUE(cluster->at("names").is<std::string>());
+    std::string concatenated = cluster->at("names").get<std::string>();
+    std::sort(concatenated.begin(), concatenated.end());
+    EXPECT_EQ("abc", concatenated);
+    EXPECT_EQ(Value(std::string("PointPointPoint")), cluster->at("type"));
+}
+
 TEST(Source, SetMaxParentOverscaleFactor) {
     SourceTest test;
     test.transform.jumpTo(CameraOptions().withCenter(LatLng()).withZoom(8.0));
@@ -298,6 +298,135 @@ TEST(CrossTileSymbolLayerIndex, noDuplicatesWithinZoomLevel) {
     ASSERT_EQ(childBucket.symbolInstances.at(2).crossTileID, 3u); // C' gets new ID
 }
 
+TEST(CrossTileSymbolLayerIndex, matchesAcrossCells) {
+    uint32_t maxCrossTileID = 0;
+    uint32_t maxBucketInstanceId = 0;
+    CrossTileSymbolLayerIndex index(maxCrossTileID);
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    bool iconsNeedLinear = false;
+    bool sortFeaturesByY = false;
+    std::string bucketLeaderID = "test";
+
+    OverscaledTileID mainID(6, 0, 6, 8, 8);
+    std::vector<SymbolInstance> mainInstances;
+    std::vector<SortKeyRange> mainRanges;
+    mainInstances.push_back(makeSymbolInstance(96, 96, u"Detroit"));  // A
+    mainInstances.push_back(makeSymbolInstance(-64, -64, u"Windsor")); // B, in the tile buffer
+    // Enough symbols to look them up in the cells rather than scanning all of them.
+    mainInstances.push_back(makeSymbolInstance(4000, 4000, u"Toronto"));
+    mainInstances.push_back(makeSymbolInstance(4000, 4000, u"London"));
+    SymbolBucket mainBucket{layout,
+                            {},
+                            16.0f,
+                            1.0f,
+                            0,
+                            iconsNeedLinear,
+                            sortFeaturesByY,
+                            bucketLeaderID,
+                            std::move(mainInstances),
+                            std::move(mainRanges),
+                            1.0f,
+                            false,
+                            {},
+                            false /*iconsInText*/};
+    mainBucket.bucketInstanceId = ++maxBucketInstanceId;
+    index.addBucket(mainID, mat4{}, mainBucket);
+    ASSERT_EQ(mainBucket.symbolInstances.at(0).crossTileID, 1u);
+    ASSERT_EQ(mainBucket.symbolInstances.at(1).crossTileID, 2u);
+
+    OverscaledTileID childID(7, 0, 7, 16, 16);
+    std::vector<SymbolInstance> childInstances;
+    std::vector<SortKeyRange> childRanges;
+    childInstances.push_back(makeSymbolInstance(256, 256, u"Detroit"));  // A', one grid unit away from A
+    childInstances.push_back(makeSymbolInstance(-96, -96, u"Windsor"));  // B'
+    childInstances.push_back(makeSymbolInstance(320, 320, u"Detroit"));  // two grid units away from A
+    SymbolBucket childBucket{layout,
+                             {},
+                             16.0f,
+                             1.0f,
+                             0,
+                             iconsNeedLinear,
+                             sortFeaturesByY,
+                             bucketLeaderID,
+                             std::move(childInstances),
+                             std::move(childRanges),
+                             1.0f,
+                             false,
+                             {},
+                             false /*iconsInText*/};
+    childBucket.bucketInstanceId = ++maxBucketInstanceId;
+    index.addBucket(childID, mat4{}, childBucket);
+
+    // The matching symbols are found in the neighbouring cells of the spatial hash.
+    EXPECT_EQ(childBucket.symbolInstances.at(0).crossTileID, 1u);
+    EXPECT_EQ(childBucket.symbolInstances.at(1).crossTileID, 2u);
+    EXPECT_EQ(childBucket.symbolInstances.at(2).crossTileID, 5u);
+}
+
+TEST(CrossTileSymbolLayerIndex, matchesAcrossManyZoomLevels) {
+    uint32_t maxCrossTileID = 0;
+    uint32_t maxBucketInstanceId = 0;
+    CrossTileSymbolLayerIndex index(maxCrossTileID);
+
+    Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout =
+        makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>();
+    bool iconsNeedLinear = false;
+    bool sortFeaturesByY = false;
+    std::string bucketLeaderID = "test";
+
+    OverscaledTileID childID(14, 0, 14, 8192, 8192);
+    std::vector<SymbolInstance> childInstances;
+    std::vector<SortKeyRange> childRanges;
+    childInstances.push_back(makeSymbolInstance(0, 0, u"Detroit"));
+    childInstances.push_back(makeSymbolInstance(0, 0, u"Windsor"));
+    SymbolBucket childBucket{layout,
+                             {},
+                             16.0f,
+                             1.0f,
+                             0,
+                             iconsNeedLinear,
+                             sortFeaturesByY,
+                             bucketLeaderID,
+                             std::move(childInstances),
+                             std::move(childRanges),
+                             1.0f,
+                             false,
+                             {},
+                             false /*iconsInText*/};
+    childBucket.bucketInstanceId = ++maxBucketInstanceId;
+    index.addBucket(childID, mat4{}, childBucket);
+    ASSERT_EQ(childBucket.symbolInstances.at(0).crossTileID, 1u);
+    ASSERT_EQ(childBucket.symbolInstances.at(1).crossTileID, 2u);
+
+    // The tolerance spans many more cells than there are symbols in the child tile.
+    OverscaledTileID parentID(4, 0, 4, 8, 8);
+    std::vector<SymbolInstance> parentInstances;
+    std::vector<SortKeyRange> parentRanges;
+    parentInstances.push_back(makeSymbolInstance(0, 0, u"Windsor"));
+    parentInstances.push_back(makeSymbolInstance(0, 0, u"Toronto"));
+    SymbolBucket parentBucket{layout,
+                              {},
+                              16.0f,
+                              1.0f,
+                              0,
+                              iconsNeedLinear,
+                              sortFeaturesByY,
+                              bucketLeaderID,
+                              std::move(parentInstances),
+                              std::move(parentRanges),
+                              1.0f,
+                              false,
+                              {},
+                              false /*iconsInText*/};
+    parentBucket.bucketInstanceId = ++maxBucketInstanceId;
+    index.addBucket(parentID, mat4{}, parentBucket);
+
+    EXPECT_EQ(parentBucket.symbolInstances.at(0).crossTileID, 2u);
+    EXPECT_EQ(parentBucket.symbolInstances.at(1).crossTileID, 3u);
+}
+
 TEST(CrossTileSymbolLayerIndex, bucketReplacement) {
     uint32_t maxCrossTileID = 0;
     uint32_t maxBucketInstanceId = 0;
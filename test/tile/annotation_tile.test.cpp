@@ -0,0 +1,82 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/fake_file_source.hpp>
+
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/map/transform.hpp>
+#include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+class AnnotationTileTest {
+public:
+    std::shared_ptr<FileSource> fileSource = std::make_shared<FakeFileSource>();
+    TransformState transformState;
+    util::RunLoop loop;
+    style::Style style{fileSource, 1};
+    AnnotationManager annotationManager { style };
+    ImageManager imageManager;
+    GlyphManager glyphManager;
+
+    TileParameters tileParameters{1.0,
+                                  MapDebugOptions(),
+                                  transformState,
+                                  fileSource,
+                                  MapMode::Continuous,
+                                  annotationManager.makeWeakPtr(),
+                                  imageManager,
+                                  glyphManager,
+                                  0};
+
+    void waitUntilComplete(AnnotationTile& tile) {
+        while (!tile.isComplete()) {
+            loop.runOnce();
+        }
+    }
+};
+
+TEST(AnnotationTile, UpdateChangedTiles) {
+    AnnotationTileTest test;
+
+    AnnotationTile northWest(OverscaledTileID(1, 0, 0), test.tileParameters);
+    AnnotationTile southEast(OverscaledTileID(1, 1, 1), test.tileParameters);
+    northWest.setLayers({});
+    southEast.setLayers({});
+    test.waitUntilComplete(northWest);
+    test.waitUntilComplete(southEast);
+
+    // Only the tile that shows the new annotation is updated.
+    AnnotationID marker = test.annotationManager.addAnnotation(SymbolAnnotation { Point<double> { -90, 45 } });
+    test.annotationManager.updateData();
+    EXPECT_FALSE(northWest.isComplete());
+    EXPECT_TRUE(southEast.isComplete());
+    test.waitUntilComplete(northWest);
+
+    // Both the tile the annotation left and the one it moved to are updated.
+    test.annotationManager.updateAnnotation(marker, SymbolAnnotation { Point<double> { 90, -45 } });
+    test.annotationManager.updateData();
+    EXPECT_FALSE(northWest.isComplete());
+    EXPECT_FALSE(southEast.isComplete());
+    test.waitUntilComplete(northWest);
+    test.waitUntilComplete(southEast);
+
+    AnnotationID line = test.annotationManager.addAnnotation(
+        LineAnnotation { LineString<double> {{ { 80, -40 }, { 100, -50 } }} });
+    test.annotationManager.updateData();
+    EXPECT_TRUE(northWest.isComplete());
+    EXPECT_FALSE(southEast.isComplete());
+    test.waitUntilComplete(southEast);
+
+    test.annotationManager.removeAnnotation(line);
+    test.annotationManager.removeAnnotation(marker);
+    test.annotationManager.updateData();
+    EXPECT_TRUE(northWest.isComplete());
+    EXPECT_FALSE(southEast.isComplete());
+    test.waitUntilComplete(southEast);
+}
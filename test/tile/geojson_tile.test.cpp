@@ -6,15 +6,22 @@
 
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/map/transform.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
+#include <mbgl/style/layers/symbol_layer_impl.hpp>
+#include <mbgl/style/image_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 
+#include <cstring>
 #include <memory>
 
 using namespace mbgl;
@@ -132,3 +139,65 @@ TEST(GeoJSONTile, Issue9927) {
     ASSERT_TRUE(tile.isRenderable());
     ASSERT_TRUE(tile.layerPropertiesUpdated(layerProperties));
  }
+
+// The symbol layouts of a tile are laid out in parallel; every bucket must match the one built when
+// its layer is laid out on its own.
+TEST(GeoJSONTile, ParallelSymbolLayoutMatchesSerial) {
+    GeoJSONTileTest test;
+    test.imageManager.addImage(makeMutable<style::Image::Impl>("marker", PremultipliedImage({8, 8}), 1.0f));
+    test.imageManager.setLoaded(true);
+
+    mapbox::feature::feature_collection<int16_t> features;
+    for (int16_t i = 0; i < 16; ++i) {
+        features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::point<int16_t>(500 * i, 250 * i)});
+    }
+    auto data = std::make_shared<FakeGeoJSONData>(std::move(features));
+
+    // Different icon sizes keep the layers in separate layouts.
+    std::vector<std::unique_ptr<SymbolLayer>> symbolLayers;
+    std::vector<Immutable<LayerProperties>> layers;
+    for (int i = 0; i < 4; ++i) {
+        auto layer = std::make_unique<SymbolLayer>("symbol" + util::toString(i), "source");
+        layer->setIconImage(expression::Image("marker"));
+        layer->setIconSize(1.0f + i);
+        layer->setIconAllowOverlap(true);
+        layers.push_back(
+            makeMutable<SymbolLayerProperties>(staticImmutableCast<SymbolLayer::Impl>(layer->baseImpl)));
+        symbolLayers.push_back(std::move(layer));
+    }
+
+    auto loadTile = [&](const std::vector<Immutable<LayerProperties>>& tileLayers) {
+        auto tile = std::make_unique<GeoJSONTile>(OverscaledTileID(0, 0, 0), "source", test.tileParameters, data);
+        tile->setLayers(tileLayers);
+        while (!tile->isComplete()) {
+            test.loop.runOnce();
+        }
+        return tile;
+    };
+
+    auto parallelTile = loadTile(layers);
+    auto parallelData = parallelTile->createRenderData();
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        auto serialTile = loadTile({layers[i]});
+        auto serialData = serialTile->createRenderData();
+
+        const auto& layerImpl = *layers[i]->baseImpl;
+        auto* parallelBucket = static_cast<SymbolBucket*>(parallelData->getBucket(layerImpl));
+        auto* serialBucket = static_cast<SymbolBucket*>(serialData->getBucket(layerImpl));
+        ASSERT_TRUE(parallelBucket);
+        ASSERT_TRUE(serialBucket);
+
+        EXPECT_EQ(serialBucket->symbolInstances.size(), parallelBucket->symbolInstances.size());
+        ASSERT_EQ(serialBucket->icon.vertices.elements(), parallelBucket->icon.vertices.elements());
+        EXPECT_GT(parallelBucket->icon.vertices.elements(), 0u);
+        EXPECT_EQ(0,
+                  std::memcmp(serialBucket->icon.vertices.data(),
+                              parallelBucket->icon.vertices.data(),
+                              parallelBucket->icon.vertices.bytes()));
+        ASSERT_EQ(serialBucket->icon.triangles.elements(), parallelBucket->icon.triangles.elements());
+        EXPECT_EQ(0,
+                  std::memcmp(serialBucket->icon.triangles.data(),
+                              parallelBucket->icon.triangles.data(),
+                              parallelBucket->icon.triangles.bytes()));
+    }
+}
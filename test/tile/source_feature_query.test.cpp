@@ -0,0 +1,67 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/tile/source_feature_query.hpp>
+#include <mbgl/tile/tile_id.hpp>
+
+using namespace mbgl;
+using namespace std::literals::string_literals;
+
+namespace {
+
+class StubGeometryTileLayer : public GeometryTileLayer {
+public:
+    StubGeometryTileLayer(std::string name_, std::vector<FeatureIdentifier> ids) : name(std::move(name_)) {
+        for (auto& id : ids) {
+            features.emplace_back(std::move(id), FeatureType::Point, GeometryCollection{ { { 0, 0 } } },
+                                  PropertyMap{ { "layer", name } });
+        }
+    }
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<StubGeometryTileFeature>(features.at(i));
+    }
+    std::string getName() const override { return name; }
+
+private:
+    std::string name;
+    std::vector<StubGeometryTileFeature> features;
+};
+
+} // namespace
+
+TEST(SourceFeatureQuery, DeduplicatePerSourceLayer) {
+    const StubGeometryTileLayer roads("roads", { uint64_t(1), "1"s, int64_t(-1), 2.5, {} });
+    const StubGeometryTileLayer water("water", { uint64_t(1), "2"s });
+
+    for (const bool deduplicate : { false, true }) {
+        SCOPED_TRACE(deduplicate ? "deduplicated" : "not deduplicated");
+        const SourceQueryOptions options({}, {}, {}, deduplicate);
+        std::vector<std::pair<std::string, FeatureIdentifier>> result;
+        SourceFeatureQuery query(options, [&](Feature feature) {
+            result.emplace_back(feature.properties.at("layer").get<std::string>(), std::move(feature.id));
+        });
+
+        // Both layers in two tiles.
+        query.addLayer(roads, OverscaledTileID(1, 0, 0));
+        query.addLayer(water, OverscaledTileID(1, 0, 0));
+        query.addLayer(roads, OverscaledTileID(1, 1, 0));
+        query.addLayer(water, OverscaledTileID(1, 1, 0));
+
+        // Features with the same ID in different source layers, or with IDs of different types,
+        // are different features. Features without an ID are always returned.
+        std::vector<std::pair<std::string, FeatureIdentifier>> expected{
+            { "roads", uint64_t(1) }, { "roads", "1"s }, { "roads", int64_t(-1) }, { "roads", 2.5 },
+            { "roads", {} },          { "water", uint64_t(1) }, { "water", "2"s },
+        };
+        if (deduplicate) {
+            expected.emplace_back("roads", FeatureIdentifier{});
+        } else {
+            const auto firstTile = expected;
+            expected.insert(expected.end(), firstTile.begin(), firstTile.end());
+        }
+        EXPECT_EQ(expected, result);
+    }
+}
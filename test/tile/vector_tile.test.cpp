@@ -2,6 +2,7 @@
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/tile/source_feature_query.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 
 #include <mbgl/util/run_loop.hpp>
@@ -67,7 +68,10 @@ TEST(VectorTile, Issue8542) {
 
     // Query before data is set
     std::vector<Feature> result;
-    tile.querySourceFeatures(result, { { {"layer"} }, {} });
+    const SourceQueryOptions options{{{"layer"}}, {}};
+    SourceFeatureQuery query(options, [&](Feature feature) { result.push_back(std::move(feature)); });
+    tile.querySourceFeatures(query);
+    EXPECT_TRUE(result.empty());
 }
 
 TEST(VectorTileData, ParseResults) {
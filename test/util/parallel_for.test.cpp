@@ -0,0 +1,82 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/util/thread_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ParallelFor, VisitsEveryIndexOnce) {
+    ThreadPool pool;
+    std::vector<std::atomic<int>> visits(100);
+    for (auto& count : visits) count = 0;
+
+    util::parallelFor(pool, visits.size(), [&](std::size_t i) { ++visits[i]; });
+
+    for (const auto& count : visits) {
+        EXPECT_EQ(1, count.load());
+    }
+}
+
+TEST(ParallelFor, RethrowsException) {
+    ThreadPool pool;
+    std::atomic<std::size_t> calls{0};
+
+    EXPECT_THROW(util::parallelFor(pool,
+                                   10,
+                                   [&](std::size_t i) {
+                                       ++calls;
+                                       if (i == 5) throw std::runtime_error("failed");
+                                   }),
+                 std::runtime_error);
+    EXPECT_EQ(10u, calls.load());
+}
+
+TEST(ParallelFor, NestedInSchedulerTask) {
+    ThreadPool pool;
+
+    // Occupy every worker with a call that fans out on the same pool; the callers
+    // must drain the work themselves instead of waiting for a free worker.
+    std::vector<std::future<std::size_t>> results;
+    std::vector<std::promise<std::size_t>> promises(4);
+    for (auto& p : promises) {
+        results.push_back(p.get_future());
+        pool.schedule([&pool, &p] {
+            std::atomic<std::size_t> sum{0};
+            util::parallelFor(pool, 16, [&](std::size_t i) { sum += i; });
+            p.set_value(sum);
+        });
+    }
+
+    for (auto& result : results) {
+        EXPECT_EQ(120u, result.get());
+    }
+}
+
+TEST(ParallelFor, HelpersBoundedBySchedulerConcurrency) {
+    class CountingScheduler : public Scheduler {
+    public:
+        void schedule(std::function<void()> fn) override {
+            ++scheduled;
+            fn();
+        }
+        mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
+        std::size_t getConcurrency() const override { return 2u; }
+
+        std::size_t scheduled = 0;
+
+    private:
+        mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
+    };
+
+    CountingScheduler scheduler;
+    std::atomic<std::size_t> calls{0};
+    util::parallelFor(scheduler, 100, [&](std::size_t) { ++calls; });
+
+    EXPECT_EQ(100u, calls.load());
+    EXPECT_LE(scheduler.scheduled, 2u);
+}